@@ -11,23 +11,54 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <mutex>
+#include <functional>
 
 #include "IndexStore.hpp"
+#include "WordCounter.hpp"
+#include "DirectoryWalker.hpp"
+#include "IndexManifest.hpp"
 
 struct IndexResult {
     double executionTime;
     long totalBytesRead;
+    long filesIndexed = 0;
+    long filesUnchanged = 0;    // skipped because the manifest says the server already has them
+    long filesDeleted = 0;
 };
 
 struct DocPathFreqPair {
     std::string documentPath;
     long wordFrequency;
     std::string origin;
+    double score = 0;       // set when ranking with BM25
+};
+
+enum class SearchMode {
+    TOP_K,      // the best documents
+    COUNT,      // only totalResults, the number of matching documents
+    EXISTS      // only totalResults, 1 if any document matches and 0 otherwise
+};
+
+struct SearchOptions {
+    int topResults = 0;     // how many of the best documents the server returns, 0 for its default
+    bool bm25 = false;      // rank with BM25 instead of the sum of the term frequencies
+    int offset = 0;         // best documents to skip, for the pages after the first
+    std::string continuationToken;  // from the previous page's result, used instead of offset
+    SearchMode mode = SearchMode::TOP_K;
+    int timeBudgetMs = 0;   // the server replies with what it found after this long, 0 for no limit
+
+    // called with the documents of every chunk of the reply as it arrives, they are then
+    // left out of the SearchResult
+    std::function<void(const std::vector<DocPathFreqPair>&)> onDocuments;
 };
 
 struct SearchResult {
-    double executionTime;
+    double executionTime = 0.0;
     std::vector<DocPathFreqPair> documentFrequencies;
+    long totalResults = 0;          // documents matching the query
+    bool totalIsEstimate = false;   // totalResults is a lower bound
+    std::string continuationToken;  // for the next page, empty on the last one
+    bool partial = false;           // the time budget ran out before the search was done
 };
 
 struct IndexRequestStruct {
@@ -46,8 +77,11 @@ class ClientProcessingEngine {
     private:
         int clientSocket;
         struct sockaddr_in serverAddress;
+        std::string serverEndpoint;     // ip:port, part of the manifest key
+        std::string serverID;           // empty when the server did not answer HELLO
         std::unordered_map<int, ClientInfo> clientMap;
         std::mutex clientMutex;
+        std::mutex socketMutex;     // one request/reply exchange on the socket at a time
 
     public:
         // constructor
@@ -56,9 +90,15 @@ class ClientProcessingEngine {
         // default virtual destructor
         virtual ~ClientProcessingEngine() = default;
 
-        IndexResult indexFolder(std::string folderPath);
+        IndexResult indexFolder(std::string folderPath, const WalkFilters& filters = {});
         
-        SearchResult search(std::vector<std::string> terms);
+        SearchResult search(std::vector<std::string> terms, const SearchOptions& options = {});
+
+        // boolean query, as built by the QueryParser
+        SearchResult search(const QueryNode& query, const SearchOptions& options = {});
+
+        // many queries in one round trip, results in the same order, empty when the exchange failed
+        std::vector<SearchResult> searchBatch(const std::vector<QueryNode>& queries, const SearchOptions& options = {});
         
         bool connectToServer(std::string serverIP, std::string serverPort);
         
@@ -66,13 +106,23 @@ class ClientProcessingEngine {
 
     // Utility functions for the indexFolder and search method
     private:
-        std::unordered_map<std::string, int> extractWords(const std::string& fileContent);
+        void extractWords(std::string_view fileContent, WordCounter& wordCounter);
+        bool countLargeFile(const std::string& filePath, size_t fileSize, WordCounter& wordCounter, uint64_t& contentHash);
         std::vector<DocPathFreqPair> searchAndSort(std::vector<std::string> terms);
 
         std::string generateClientID();
         void removeClientFromMap(int clientSocket);
-        bool sendIndexRequest(const IndexRequest& request);
-        SearchResult sendMessageAndReceiveResponse(const std::string& message);
+        void buildIndexFrame(std::string& frame, const std::string& clientID, const std::string& documentPath, long replaceDocumentNumber, const WordCounter& wordCounter);
+        long sendIndexFrame(const std::string& frame);
+        bool sendDeleteRequest(const std::vector<long>& documentNumbers);
+        bool requestServerID();
+        bool sendFrame(const std::string& message);
+        bool receiveFrame(std::string& message);
+        void applySearchOptions(SearchRequest& request, const SearchOptions& options);
+        SearchResult sendSearchRequest(SearchRequest& request, const SearchOptions& options);
+        SearchResult sendMessageAndReceiveResponse(const std::string& message, const SearchOptions& options);
+        bool receiveSearchReply(SearchResult& result, const SearchOptions& options);
+        SearchResult fromSearchReply(const SearchReply& searchReply);
         
 };
 
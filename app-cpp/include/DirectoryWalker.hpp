@@ -0,0 +1,60 @@
+#ifndef DIRECTORY_WALKER_H
+#define DIRECTORY_WALKER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct WalkFilters {
+    std::vector<std::string> includePatterns;   // when given, a file has to match one of them
+    std::vector<std::string> excludePatterns;   // files and directories matching any of them are skipped
+};
+
+// Walks a directory tree with several threads, one task per directory, reading entries
+// with getdents64 and relying on d_type so most entries never need a stat. Files are
+// handed to the callback as soon as they are found, from whichever thread found them.
+class DirectoryWalker {
+    struct DirectoryTask {
+        int directoryFd;            // already opened with openat, or -1 to open it by path
+        std::string path;
+        std::string relativePath;   // relative to the root, matched against the filters
+    };
+
+    WalkFilters filters;
+    int threadCount;
+
+    std::deque<DirectoryTask> tasks;
+    std::mutex tasksMutex;
+    std::condition_variable tasksCv;
+    size_t pendingTasks = 0;                // queued plus in progress, the walk ends at zero
+    std::atomic<size_t> queuedDirectoryFds = 0;
+    std::atomic<size_t> failedDirectories = 0;
+
+    bool matchesAny(const std::vector<std::string> &patterns, const std::string &name, const std::string &relativePath) const;
+    void processDirectory(DirectoryTask task, const std::function<void(std::string &&)> &onFile);
+    void runThread(const std::function<void(std::string &&)> &onFile);
+
+    public:
+        // constructor
+        DirectoryWalker(WalkFilters filters, int threadCount);
+
+        // default virtual destructor
+        virtual ~DirectoryWalker() = default;
+
+        // walk rootPath and call onFile with the path of every regular file that passes the filters,
+        // returns false if the root cannot be opened
+        bool walk(const std::string &rootPath, const std::function<void(std::string &&)> &onFile);
+
+        // directories that could not be read, the files below them were not reported
+        size_t errorCount() const { return failedDirectories; }
+
+        // whether a walk of rootPath would report filePath if it still exists, a path
+        // outside rootPath is not filtered
+        bool passesFilters(const std::string &rootPath, const std::string &filePath) const;
+};
+
+#endif
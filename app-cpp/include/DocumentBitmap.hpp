@@ -0,0 +1,132 @@
+#ifndef DOCUMENT_BITMAP_H
+#define DOCUMENT_BITMAP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Compressed set of document numbers in the style of roaring bitmaps. Documents are
+// grouped by their high 16 bits into containers; a container holds the low 16 bits as a
+// sorted array while it has at most ARRAY_LIMIT of them and as a 65536 bit bitmap once
+// it has more. Every document also has a position, its rank in increasing order, so
+// values kept in a parallel array (the term frequencies) can be found from the bitmap.
+class DocumentBitmap {
+    struct Container {
+        uint16_t key;
+        uint32_t rankBefore = 0;            // documents in the containers before this one
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> values;       // array container
+        std::vector<uint64_t> words;        // bitmap container
+        std::vector<uint16_t> wordRanks;    // set bits before every RANK_STRIDE words of a bitmap container
+
+        bool isBitmap() const { return !words.empty(); }
+        bool add(uint16_t low);
+        bool contains(uint16_t low) const;
+        uint32_t rank(uint16_t low) const;
+        int nextAtLeast(uint32_t low) const;
+        void toBitmap();
+        void rebuildWordRanks();
+        std::vector<uint64_t> toWords() const;
+        static Container fromWords(uint16_t key, std::vector<uint64_t> words);
+    };
+
+    std::vector<Container> containers;      // sorted by key
+
+    const Container *findContainer(uint16_t key) const;
+    void updateRanks();
+
+    public:
+        static constexpr uint32_t END = UINT32_MAX;
+        static constexpr size_t ARRAY_LIMIT = 4096;
+
+        // returns false if the document was already there
+        bool add(uint32_t document);
+        bool contains(uint32_t document) const;
+
+        // position of the document in increasing order, -1 if it is not in the set
+        long indexOf(uint32_t document) const;
+
+        // first document >= document, or END
+        uint32_t nextAtLeast(uint32_t document) const;
+
+        size_t cardinality() const;
+        bool empty() const { return containers.empty(); }
+
+        template <typename Function>
+        void forEach(Function &&function) const {
+            for (const Container &container : containers) {
+                uint32_t high = static_cast<uint32_t>(container.key) << 16;
+                if (!container.isBitmap()) {
+                    for (uint16_t low : container.values) {
+                        function(high | low);
+                    }
+                    continue;
+                }
+                for (size_t word = 0; word < container.words.size(); word++) {
+                    for (uint64_t bits = container.words[word]; bits != 0; bits &= bits - 1) {
+                        function(high | static_cast<uint32_t>(word * 64 + __builtin_ctzll(bits)));
+                    }
+                }
+            }
+        }
+
+        // like forEach, over the documents in [begin, end) only
+        template <typename Function>
+        void forEachInRange(uint32_t begin, uint32_t end, Function &&function) const {
+            auto container = std::lower_bound(containers.begin(), containers.end(), begin >> 16,
+                                              [](const Container &container, uint32_t key) { return container.key < key; });
+            for (; container != containers.end(); ++container) {
+                uint32_t high = static_cast<uint32_t>(container->key) << 16;
+                if (high >= end) {
+                    return;
+                }
+                uint32_t low = high < begin ? begin & 0xFFFF : 0;
+                if (!container->isBitmap()) {
+                    for (auto value = std::lower_bound(container->values.begin(), container->values.end(), low);
+                         value != container->values.end(); ++value) {
+                        if ((high | *value) >= end) {
+                            return;
+                        }
+                        function(high | *value);
+                    }
+                    continue;
+                }
+                for (size_t word = low / 64; word < container->words.size(); word++) {
+                    uint64_t bits = container->words[word];
+                    if (word == low / 64) {
+                        bits &= ~0ULL << (low % 64);
+                    }
+                    for (; bits != 0; bits &= bits - 1) {
+                        uint32_t document = high | static_cast<uint32_t>(word * 64 + __builtin_ctzll(bits));
+                        if (document >= end) {
+                            return;
+                        }
+                        function(document);
+                    }
+                }
+            }
+        }
+
+        // Positions of documents asked for in increasing order, counting the bits between
+        // one document and the next instead of looking every document up.
+        class RankCursor {
+            const DocumentBitmap &bitmap;
+            size_t container = 0;
+            size_t offset = 0;          // word of a bitmap container, value of an array container
+            uint32_t offsetRank = 0;    // position of the first document at offset
+
+            public:
+                // constructor
+                RankCursor(const DocumentBitmap &bitmap);
+
+                // like DocumentBitmap::indexOf, document must not be below the previous one
+                long indexOf(uint32_t document);
+        };
+
+        static DocumentBitmap fromSorted(const uint32_t *documents, size_t size);
+        static DocumentBitmap intersect(const DocumentBitmap &a, const DocumentBitmap &b);
+        static DocumentBitmap unite(const DocumentBitmap &a, const DocumentBitmap &b);
+};
+
+#endif
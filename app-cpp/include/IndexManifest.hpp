@@ -0,0 +1,61 @@
+#ifndef INDEX_MANIFEST_H
+#define INDEX_MANIFEST_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct ManifestEntry {
+    uint64_t size;
+    int64_t modifiedTime;       // nanoseconds since the epoch
+    uint64_t contentHash;
+    long documentNumber;        // number the server gave the document
+};
+
+// What the client sent to the server for one folder, kept on disk between runs so that
+// indexing the folder again only sends new and changed files and deletes the ones that
+// are gone. The manifest belongs to one run of one server: when the server restarted it
+// no longer has the documents, so the manifest is started over.
+class IndexManifest {
+    struct TrackedEntry {
+        ManifestEntry entry;
+        bool seen;              // the file was found again by this run
+    };
+
+    std::string manifestPath;
+    std::string serverID;
+    std::unordered_map<std::string, TrackedEntry> entries;
+    std::mutex entriesMutex;
+
+    public:
+        // constructor
+        IndexManifest(std::string manifestPath, std::string serverID);
+
+        // default virtual destructor
+        virtual ~IndexManifest() = default;
+
+        // read the manifest file, keeping it empty if it is missing or was written for another server run
+        void load();
+        bool save();
+
+        // entry of a file found in the folder, marking the file as still present
+        std::optional<ManifestEntry> find(const std::string &documentPath);
+        void update(const std::string &documentPath, const ManifestEntry &entry);
+
+        // remove and return the entries of files in scope that find() was not called for
+        std::vector<std::pair<std::string, ManifestEntry>> takeMissing(const std::function<bool(const std::string &)> &inScope);
+
+        // where the manifest of a folder indexed on a given server is kept
+        static std::string pathFor(const std::string &folderPath, const std::string &serverAddress);
+
+        // hash of a file's content, large files hash the array of their chunk hashes
+        static uint64_t hashContent(std::string_view content);
+};
+
+#endif
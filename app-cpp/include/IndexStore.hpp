@@ -5,6 +5,19 @@
 #include <vector>
 #include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "PostingList.hpp"
+#include "QueryBudget.hpp"
+#include "TermDictionary.hpp"
+#include "TrigramIndex.hpp"
 
 
 struct DocFreqPair {
@@ -23,23 +36,127 @@ class IndexStore {
     // TO-DO declare two locks, one for the DocumentMap and one for the TermInvertedIndex ✅
     std::unordered_map<long, DocumentInfo> documentMap;
     std::unordered_map<long, std::string> reverseDocumentMap;
-    std::unordered_map<std::string, std::vector<DocFreqPair>> termInvertedIndex;
+    std::unordered_map<std::string, PostingList> termInvertedIndex;
+    TermDictionary termDictionary;              // the terms of the TermInvertedIndex in order, under the same lock
+    std::optional<TrigramIndex> trigramIndex;   // the same terms by trigram, when asked for
+    std::atomic<long> nextDocumentNumber = 1;   // numbers are never reused, even after a document is deleted
+
+    // Deleted documents keep their postings until compaction removes them, lookups skip
+    // every posting whose bit is set. Bits stay set after compaction since numbers are not reused.
+    std::vector<uint64_t> deletedDocuments;
+    std::vector<uint32_t> documentTermCounts;   // postings per document, to know how much a delete leaves behind
+    std::vector<uint32_t> documentLengths;      // words per document, for BM25
+    std::atomic<long> liveDocuments = 0;
+    std::atomic<long> totalDocumentLength = 0;  // over the live documents
+    std::atomic<long> totalPostings = 0;
+    std::atomic<long> deadPostings = 0;
+    std::atomic<uint64_t> indexGeneration = 0;  // bumped after every change a search can see
 
     std::mutex documentMapMutex;
-    std::mutex termInvertedIndexMutex;
+    std::shared_mutex termInvertedIndexMutex;
+    std::shared_mutex deletedDocumentsMutex;
+
+    std::thread compactionThread;
+    std::mutex compactionMutex;
+    std::condition_variable compactionCv;
+    bool stopCompaction = false;
+
+    bool isDeleted(long documentNumber) const;
+    double averageDocumentLength() const;
+    bool needsCompaction() const;
+    void runCompaction();
+
+    friend class IndexReader;
     
 
     public:
-        // constructor
-        IndexStore();
+        // constructor, the trigram index serves substring and regular expression patterns
+        IndexStore(bool withTrigramIndex = false);
 
-        // default virtual destructor
-        virtual ~IndexStore() = default;
+        // stops the compaction thread
+        virtual ~IndexStore();
         
         long putDocument(std::string documentPath, std::string clientName);
         DocumentInfo getDocument(long documentNumber);
+        void deleteDocument(long documentNumber);
         void updateIndex(long documentNumber, const std::unordered_map<std::string, long> &wordFrequencies);
         std::vector<DocFreqPair> lookupIndex(std::string term);
+
+        // results computed at one generation still hold while it is current
+        uint64_t generation() const { return indexGeneration; }
+
+        // rewrite the posting lists without the postings of deleted documents,
+        // runs on its own once enough of the index is dead
+        void compact();
+};
+
+// Read access for evaluating a query. Nothing can change the posting lists or the deleted
+// bitmap while a reader is alive, so query iterators point straight into the posting lists.
+//
+// A term with a '*' (any characters) or a '?' (one character) is a pattern, and so is a
+// term between slashes, an ECMAScript regular expression that must match whole terms, and
+// a word followed by '~' and an edit distance, that matches the terms that close to it.
+// Indexed words never contain any of these. The postings of a pattern are those of the
+// terms it matches. They are found in the TermDictionary from the characters before the
+// first wildcard, or in the trigram index when the store has one and the prefix is too
+// short to help, and a fuzzy word intersects its LevenshteinAutomaton with the dictionary.
+// Their lists are merged into one, with the frequencies of a document added up, the first
+// time the pattern is looked up, and kept for the lifetime of the reader. A pattern
+// matching more than MAX_PATTERN_TERMS terms keeps those found in the most documents.
+// Expanding a pattern polls the query budget, and stops with the terms found so far once
+// it expires. A pattern that would test every term of a large dictionary is refused.
+class IndexReader {
+    const IndexStore &store;
+    QueryBudget *budget;
+    std::shared_lock<std::shared_mutex> indexLock;
+    std::shared_lock<std::shared_mutex> deletedLock;
+
+    // patterns looked up so far, nullptr for one matching no term
+    mutable std::unordered_map<std::string, const PostingList *> patternPostings;
+    mutable std::vector<std::unique_ptr<PostingList>> mergedPostings;
+    mutable std::mutex patternMutex;
+
+    // calls function(term) for every term the pattern matches, false for an invalid one
+    bool forEachPatternTerm(const std::string &pattern, const std::function<void(const std::string &)> &function) const;
+    const PostingList *expandPattern(const std::string &pattern) const;
+    PostingList mergePostings(const std::vector<const PostingList *> &lists) const;
+
+    public:
+        static constexpr size_t MAX_PATTERN_TERMS = 1024;
+
+        // constructor, takes the read locks until the reader is destroyed
+        IndexReader(IndexStore &store, QueryBudget *budget = nullptr);
+
+        // default virtual destructor
+        virtual ~IndexReader() = default;
+
+        static bool isRegex(const std::string &term) { return term.size() >= 2 && term.front() == '/' && term.back() == '/'; }
+        // a word followed by '~' and its largest edit distance, 2 when it is left out
+        static bool isFuzzy(const std::string &term) {
+            size_t tilde = term.rfind('~');
+            return tilde != std::string::npos && tilde > 0
+                   && std::all_of(term.begin() + tilde + 1, term.end(), [](char c) { return c >= '0' && c <= '9'; });
+        }
+        static bool isPattern(const std::string &term) {
+            return isRegex(term) || isFuzzy(term) || term.find_first_of("*?") != std::string::npos;
+        }
+
+        // nullptr when the term was never indexed or the pattern matches no term
+        const PostingList *findPostings(const std::string &term) const;
+        bool isDeleted(uint32_t documentNumber) const { return store.isDeleted(documentNumber); }
+        // false until the first delete, the bits of deleted documents are never cleared
+        bool hasDeletedDocuments() const { return !store.deletedDocuments.empty(); }
+
+        // postings of the term, deleted documents included until compaction removes them
+        size_t documentFrequency(const std::string &term) const;
+
+        // document numbers are below this bound
+        uint32_t documentNumberBound() const { return store.nextDocumentNumber; }
+
+        // collection statistics for BM25
+        uint32_t documentLength(uint32_t documentNumber) const;
+        long documentCount() const { return store.liveDocuments; }
+        double averageDocumentLength() const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef INTERSECTION_H
+#define INTERSECTION_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Kernels intersecting two strictly increasing arrays of document numbers. For every
+// value found in both, its position in a and its position in b are written to
+// positionsA and positionsB, which need room for min(sizeA, sizeB) entries; the number
+// of common values is returned. The SSE or AVX2 version is picked once at run time
+// from what the CPU supports, with a scalar version for other machines.
+
+// for arrays of similar size, compares blocks of a against blocks of b
+size_t intersectMerge(const uint32_t *a, size_t sizeA, const uint32_t *b, size_t sizeB,
+                      uint32_t *positionsA, uint32_t *positionsB);
+
+// for a much smaller than b, gallops over blocks of b and compares a whole block at once
+size_t intersectGallop(const uint32_t *a, size_t sizeA, const uint32_t *b, size_t sizeB,
+                       uint32_t *positionsA, uint32_t *positionsB);
+
+using IntersectionKernel = size_t (*)(const uint32_t *, size_t, const uint32_t *, size_t, uint32_t *, uint32_t *);
+
+struct IntersectionKernels {
+    const char *name;
+    IntersectionKernel merge;
+    IntersectionKernel gallop;
+};
+
+// every version this CPU can run, scalar first, the one in use last, so they can be compared
+std::vector<IntersectionKernels> availableIntersectionKernels();
+
+#endif
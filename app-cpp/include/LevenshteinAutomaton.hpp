@@ -0,0 +1,53 @@
+#ifndef LEVENSHTEIN_AUTOMATON_H
+#define LEVENSHTEIN_AUTOMATON_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Accepts the strings within maxDistance insertions, deletions and substitutions of a word,
+// counted in bytes. A state is the row of the edit distance table after the bytes read so
+// far: entry i is the distance from them to the first i bytes of the word, capped at
+// maxDistance + 1. A row with every entry over the distance can never match again and is
+// the dead state, while any other row still reaches a match by appending the rest of the word.
+//
+// The rows only depend on whether each byte read equals each byte of the word, so the
+// bytes fall into one class per distinct byte of the word and one for all the others. The
+// constructor follows every row reachable from the start into a transition table by class,
+// and nextMatch only tries the classes to find the smallest accepted string after a given one.
+class LevenshteinAutomaton {
+    static constexpr uint32_t DEAD = 0;
+    static constexpr uint32_t START = 1;
+
+    std::string wordBytes;                  // the distinct bytes of the word, in increasing order
+    std::array<uint8_t, 256> byteClasses;   // 1 + the index in wordBytes, 0 for a byte not in the word
+    size_t classCount;
+    std::vector<uint32_t> transitions;      // classCount per state
+    std::vector<bool> accepting;            // by state
+
+    uint32_t step(uint32_t state, unsigned char byte) const {
+        return transitions[state * classCount + byteClasses[byte]];
+    }
+
+    // the smallest byte >= from not leading to the dead state, -1 if there is none
+    int nextLiveByte(uint32_t state, int from) const;
+
+    public:
+        static constexpr size_t MAX_DISTANCE = 2;
+
+        // constructor, distances above MAX_DISTANCE are lowered to it
+        LevenshteinAutomaton(const std::string &word, size_t maxDistance);
+
+        // default virtual destructor
+        virtual ~LevenshteinAutomaton() = default;
+
+        bool matches(std::string_view text) const;
+
+        // the smallest string >= from within the distance into target, false if there is none
+        bool nextMatch(std::string_view from, std::string &target) const;
+};
+
+#endif
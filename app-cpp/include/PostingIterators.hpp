@@ -0,0 +1,236 @@
+#ifndef POSTING_ITERATORS_H
+#define POSTING_ITERATORS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "PostingList.hpp"
+
+// Document at a time cursor over the documents matching part of a query, visited in
+// increasing document number. Once exhausted the cursor sits on END.
+//
+// A BM25 ranking that already holds k documents tells the iterator the score a document
+// has to beat. The iterator may then skip the documents it can tell score no more, and
+// skippedMatches() reports that matches went uncounted.
+class PostingIterator {
+    public:
+        static constexpr uint32_t END = UINT32_MAX;
+
+        // default virtual destructor
+        virtual ~PostingIterator() = default;
+
+        virtual uint32_t document() const = 0;
+        virtual uint32_t next() = 0;
+
+        // move to the first document >= target, never backwards
+        virtual uint32_t advance(uint32_t target) = 0;
+
+        // sum of the term frequencies of the current document
+        virtual long score() const = 0;
+
+        // sum of the BM25 scores of the terms matching the current document
+        virtual double bm25Score(uint32_t documentLength, double averageLength) const = 0;
+
+        // how many documents the iterator may still produce, cheap iterators lead intersections
+        virtual size_t cost() const = 0;
+
+        // largest bm25Score any document can get from the iterator
+        virtual double maxBm25Score(double averageLength) const = 0;
+
+        // documents scoring minScore or less are no longer wanted, it only ever grows
+        virtual void setMinCompetitiveScore(double, double) {}
+        virtual bool skippedMatches() const { return false; }
+};
+
+// Walks one posting list, advancing with the skip pointers first and then galloping
+// inside the block that holds the target.
+class TermIterator : public PostingIterator {
+    const PostingList &postings;
+    const uint32_t *documents;
+    size_t size;
+    size_t position = 0;
+    double idf;
+    mutable double scoreBound = -1;     // computed on first use
+
+    public:
+        // constructor
+        TermIterator(const PostingList &postings, double idf = 0);
+
+        uint32_t document() const override { return position < size ? documents[position] : END; }
+        uint32_t next() override;
+        uint32_t advance(uint32_t target) override;
+        long score() const override { return postings.frequencyData()[position]; }
+        double bm25Score(uint32_t documentLength, double averageLength) const override {
+            return PostingList::bm25Score(idf, postings.frequencyData()[position], documentLength, averageLength);
+        }
+        size_t cost() const override { return size - position; }
+        double maxBm25Score(double averageLength) const override;
+};
+
+// Walks a posting list kept as a bitmap, finding the frequency of a document from its
+// rank in the bitmap.
+class BitmapTermIterator : public PostingIterator {
+    const PostingList &postings;
+    DocumentBitmap::RankCursor ranks;
+    uint32_t current;
+    size_t position = 0;
+    double idf;
+    mutable double scoreBound = -1;     // computed on first use
+
+    public:
+        // constructor
+        BitmapTermIterator(const PostingList &postings, double idf = 0);
+
+        uint32_t document() const override { return current; }
+        uint32_t next() override;
+        uint32_t advance(uint32_t target) override;
+        long score() const override { return postings.frequencyData()[position]; }
+        double bm25Score(uint32_t documentLength, double averageLength) const override {
+            return PostingList::bm25Score(idf, postings.frequencyData()[position], documentLength, averageLength);
+        }
+        size_t cost() const override { return postings.size() - position; }
+        double maxBm25Score(double averageLength) const override;
+};
+
+// iterator matching the representation of the posting list, idf weighs its BM25 scores
+std::unique_ptr<PostingIterator> makeTermIterator(const PostingList &postings, double idf = 0);
+
+// Intersection of its children. The cheapest child leads and every other child is only
+// advanced to the lead's candidates, so the work follows the rarest list.
+class AndIterator : public PostingIterator {
+    std::vector<std::unique_ptr<PostingIterator>> children;
+    uint32_t current;
+
+    uint32_t align(uint32_t candidate);
+
+    public:
+        // constructor
+        AndIterator(std::vector<std::unique_ptr<PostingIterator>> children);
+
+        uint32_t document() const override { return current; }
+        uint32_t next() override;
+        uint32_t advance(uint32_t target) override;
+        long score() const override;
+        double bm25Score(uint32_t documentLength, double averageLength) const override;
+        size_t cost() const override { return children.front()->cost(); }
+        double maxBm25Score(double averageLength) const override;
+        // a child must beat minScore less what the others can add at most
+        void setMinCompetitiveScore(double minScore, double averageLength) override;
+        bool skippedMatches() const override;
+};
+
+// Union of its children, kept in a min-heap on their current document. Every child on
+// the current document adds to the score, children are only moved once the union
+// moves past them.
+//
+// Under a minimum competitive score it applies MaxScore: the children with the lowest
+// bounds, as many as together cannot beat the minimum, leave the heap. They no longer
+// produce documents of their own and are only advanced to the documents the others
+// find, to add to their scores. Once no child is left in the heap nothing can compete.
+class OrIterator : public PostingIterator {
+    std::vector<std::unique_ptr<PostingIterator>> children;
+    std::vector<PostingIterator *> heap;    // children not exhausted yet
+    std::vector<PostingIterator *> byBound; // all the children, lowest bound first, once a minimum was set
+    size_t nonEssential = 0;                // the first children of byBound, out of the heap
+    double nonEssentialBound = 0;
+    uint32_t current;
+
+    uint32_t moveChildrenTo(uint32_t target);
+
+    public:
+        // constructor
+        OrIterator(std::vector<std::unique_ptr<PostingIterator>> children);
+
+        uint32_t document() const override { return current; }
+        uint32_t next() override;
+        uint32_t advance(uint32_t target) override;
+        long score() const override;
+        double bm25Score(uint32_t documentLength, double averageLength) const override;
+        size_t cost() const override;
+        double maxBm25Score(double averageLength) const override;
+        void setMinCompetitiveScore(double minScore, double averageLength) override;
+        bool skippedMatches() const override;
+};
+
+// Documents found by at least minimum of its children. The minimum - 1 children furthest
+// behind are taken off a min-heap on the current documents: the document the next one
+// sits on is the first where enough children can still meet, so the ones behind jump
+// straight to it. It is a match once they all land on it.
+class MinShouldMatchIterator : public PostingIterator {
+    std::vector<std::unique_ptr<PostingIterator>> children;
+    std::vector<PostingIterator *> heap;    // children not exhausted yet
+    std::vector<PostingIterator *> behind;  // scratch for the children taken off the heap
+    size_t minimum;
+    uint32_t current;
+
+    uint32_t moveTo(uint32_t target);
+
+    public:
+        // constructor, minimum is at least 1 and at most the number of children
+        MinShouldMatchIterator(std::vector<std::unique_ptr<PostingIterator>> children, size_t minimum);
+
+        uint32_t document() const override { return current; }
+        uint32_t next() override { return current == END ? END : moveTo(current + 1); }
+        uint32_t advance(uint32_t target) override { return current >= target ? current : moveTo(target); }
+        long score() const override;
+        double bm25Score(uint32_t documentLength, double averageLength) const override;
+        size_t cost() const override;
+        double maxBm25Score(double averageLength) const override;
+};
+
+// Documents of included that are not in excluded. The excluded iterator is only ever
+// advanced to the candidates of the included one, so it is skipped through rather than
+// walked; it adds nothing to the score.
+class AndNotIterator : public PostingIterator {
+    std::unique_ptr<PostingIterator> included;
+    std::unique_ptr<PostingIterator> excluded;
+    uint32_t current;
+
+    uint32_t skipExcluded(uint32_t candidate);
+
+    public:
+        // constructor
+        AndNotIterator(std::unique_ptr<PostingIterator> included, std::unique_ptr<PostingIterator> excluded);
+
+        uint32_t document() const override { return current; }
+        uint32_t next() override { return current == END ? END : skipExcluded(included->next()); }
+        uint32_t advance(uint32_t target) override { return current >= target ? current : skipExcluded(included->advance(target)); }
+        long score() const override { return included->score(); }
+        double bm25Score(uint32_t documentLength, double averageLength) const override {
+            return included->bm25Score(documentLength, averageLength);
+        }
+        size_t cost() const override { return included->cost(); }
+        double maxBm25Score(double averageLength) const override { return included->maxBm25Score(averageLength); }
+        void setMinCompetitiveScore(double minScore, double averageLength) override {
+            included->setMinCompetitiveScore(minScore, averageLength);
+        }
+        bool skippedMatches() const override { return included->skippedMatches(); }
+};
+
+// Every document number below a bound, what a negation is taken from when nothing else
+// restricts it. Matches score nothing.
+class AllDocumentsIterator : public PostingIterator {
+    uint32_t bound;
+    uint32_t current;
+
+    public:
+        // constructor, document numbers start at 1
+        AllDocumentsIterator(uint32_t bound) : bound(bound), current(bound > 1 ? 1 : END) {}
+
+        uint32_t document() const override { return current; }
+        uint32_t next() override { return current = current == END || current + 1 >= bound ? END : current + 1; }
+        uint32_t advance(uint32_t target) override {
+            if (current < target) {
+                current = target >= bound ? END : target;
+            }
+            return current;
+        }
+        long score() const override { return 0; }
+        double bm25Score(uint32_t, double) const override { return 0; }
+        size_t cost() const override { return current == END ? 0 : bound - current; }
+        double maxBm25Score(double) const override { return 0; }
+};
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef POSTING_LIST_H
+#define POSTING_LIST_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "DocumentBitmap.hpp"
+
+// Postings of one term sorted by document number, kept as two parallel arrays so the
+// document numbers can be scanned on their own. Every BLOCK_SIZE postings form a block
+// whose last document number is stored in blockLastDocuments, the skip pointers that
+// let an iterator jump over whole blocks. Every block also records what it takes to
+// bound the BM25 score of any of its postings without reading them: the largest
+// frequency, the smallest ratio of document length to frequency, and the smallest BM25
+// normalization under the average document length the block was built with.
+//
+// A term found in a large share of the documents is switched to a DocumentBitmap
+// instead, with the frequencies still kept in document order next to it. Its blocks
+// are kept as well, counted by position in the bitmap.
+//
+// Once a list holds more than IMPACT_HEAD_SIZE postings it also keeps its head: the
+// postings with the highest frequencies in ranking order, updated on every add, so the
+// top documents of a single term are read without walking the list.
+//
+// Document lengths are passed in by the IndexStore, indexed by document number, along
+// with their current average.
+struct Impact {
+    uint32_t documentNumber;
+    uint32_t frequency;
+};
+
+class PostingList {
+    std::vector<uint32_t> documents;            // empty while the list is a bitmap
+    std::vector<uint32_t> frequencies;
+    std::vector<uint32_t> blockLastDocuments;
+    std::vector<uint32_t> blockMaxFrequencies;
+    std::vector<float> blockMinLengthRatios;
+    std::vector<float> blockReferenceLengths;
+    std::vector<float> blockMinNormalizations;
+    std::optional<DocumentBitmap> denseDocuments;
+    std::vector<Impact> impactHead;             // empty while the list is not larger than IMPACT_HEAD_SIZE
+
+    void addToBlocks(size_t position, uint32_t documentNumber, uint32_t frequency, uint32_t length, double averageLength);
+    void rebuildSkips(size_t fromPosition, const std::vector<uint32_t> &documentLengths, double averageLength);
+    void offerToHead(uint32_t documentNumber, uint32_t frequency);
+    void rebuildHead();
+
+    static uint32_t lengthOf(uint32_t documentNumber, const std::vector<uint32_t> &documentLengths) {
+        return documentNumber < documentLengths.size() ? documentLengths[documentNumber] : 0;
+    }
+
+    // both rounded down, a bound computed from them must not come out below a real score
+    static float lengthRatio(uint32_t length, uint32_t frequency) {
+        return std::nextafter(static_cast<float>(static_cast<double>(length) / frequency), 0.0f);
+    }
+    static float normalization(uint32_t length, uint32_t frequency, float referenceLength) {
+        double value = (BM25_K1 * (1 - BM25_B) + BM25_K1 * BM25_B * length / referenceLength) / frequency;
+        return std::nextafter(static_cast<float>(value), 0.0f);
+    }
+
+    public:
+        static constexpr size_t BLOCK_SIZE = 128;
+        static constexpr size_t IMPACT_HEAD_SIZE = 128;
+        static constexpr double BM25_K1 = 1.2;
+        static constexpr double BM25_B = 0.75;
+
+        // documents usually arrive in increasing order and are appended, a document indexed
+        // out of order by a concurrent client is inserted at its place
+        void add(uint32_t documentNumber, uint32_t frequency, const std::vector<uint32_t> &documentLengths, double averageLength);
+
+        // drop the postings the predicate selects, returns how many were removed
+        template <typename Predicate>
+        size_t removeIf(Predicate &&shouldRemove, const std::vector<uint32_t> &documentLengths, double averageLength) {
+            size_t sizeBefore = frequencies.size();
+
+            if (denseDocuments) {
+                DocumentBitmap keptDocuments;
+                std::vector<uint32_t> keptFrequencies;
+                size_t position = 0;
+                denseDocuments->forEach([&](uint32_t documentNumber) {
+                    uint32_t frequency = frequencies[position++];
+                    if (!shouldRemove(documentNumber)) {
+                        keptDocuments.add(documentNumber);
+                        keptFrequencies.push_back(frequency);
+                    }
+                });
+                denseDocuments = std::move(keptDocuments);
+                frequencies = std::move(keptFrequencies);
+                rebuildSkips(0, documentLengths, averageLength);
+                rebuildHead();
+                return sizeBefore - frequencies.size();
+            }
+
+            size_t kept = 0;
+            for (size_t i = 0; i < documents.size(); i++) {
+                if (!shouldRemove(documents[i])) {
+                    documents[kept] = documents[i];
+                    frequencies[kept] = frequencies[i];
+                    kept++;
+                }
+            }
+            size_t removed = documents.size() - kept;
+            if (removed > 0) {
+                documents.resize(kept);
+                frequencies.resize(kept);
+                documents.shrink_to_fit();
+                frequencies.shrink_to_fit();
+                rebuildSkips(0, documentLengths, averageLength);
+                rebuildHead();
+            }
+            return removed;
+        }
+
+        // calls function(documentNumber, frequency) in increasing document order
+        template <typename Function>
+        void forEach(Function &&function) const {
+            if (denseDocuments) {
+                size_t position = 0;
+                denseDocuments->forEach([&](uint32_t documentNumber) { function(documentNumber, frequencies[position++]); });
+                return;
+            }
+            for (size_t i = 0; i < documents.size(); i++) {
+                function(documents[i], frequencies[i]);
+            }
+        }
+
+        // the same over the postings of the documents in [begin, end) only
+        template <typename Function>
+        void forEachInRange(uint32_t begin, uint32_t end, Function &&function) const {
+            if (denseDocuments) {
+                uint32_t first = denseDocuments->nextAtLeast(begin);
+                if (first >= end) {
+                    return;
+                }
+                size_t position = denseDocuments->indexOf(first);
+                denseDocuments->forEachInRange(begin, end, [&](uint32_t documentNumber) { function(documentNumber, frequencies[position++]); });
+                return;
+            }
+            for (size_t i = std::lower_bound(documents.begin(), documents.end(), begin) - documents.begin();
+                 i < documents.size() && documents[i] < end; i++) {
+                function(documents[i], frequencies[i]);
+            }
+        }
+
+        void toBitmap();
+        void toList();
+        bool isBitmap() const { return denseDocuments.has_value(); }
+        const DocumentBitmap &bitmap() const { return *denseDocuments; }
+
+        size_t size() const { return frequencies.size(); }
+        bool empty() const { return frequencies.empty(); }
+
+        // document numbers of a list that is not a bitmap
+        const uint32_t *documentData() const { return documents.data(); }
+        const uint32_t *frequencyData() const { return frequencies.data(); }
+
+        const std::vector<uint32_t> &skips() const { return blockLastDocuments; }
+
+        // highest frequency first, lower document number first on ties, deleted documents included
+        const std::vector<Impact> &head() const { return impactHead; }
+
+        // same order as the head
+        static bool ranksBefore(const Impact &a, const Impact &b) {
+            return a.frequency > b.frequency || (a.frequency == b.frequency && a.documentNumber < b.documentNumber);
+        }
+
+        // BM25 contribution of one term to a document
+        static double bm25Score(double idf, uint32_t frequency, uint32_t length, double averageLength) {
+            double normalization = BM25_K1 * (1 - BM25_B + BM25_B * length / averageLength);
+            return idf * frequency * (BM25_K1 + 1) / (frequency + normalization);
+        }
+
+        // largest BM25 score a posting of the block can get before the idf factor
+        double blockScoreBound(size_t block, double averageLength) const;
+
+        // the same over the whole list, the largest of the block bounds
+        double scoreBound(double averageLength) const;
+};
+
+// first position in [begin, end) whose value is >= target, probing 1, 2, 4, ... elements
+// ahead of begin before a binary search, so short jumps stay cheap
+size_t gallopTo(const uint32_t *values, size_t begin, size_t end, uint32_t target);
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef QUERY_BUDGET_H
+#define QUERY_BUDGET_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+// How long a query may run, and a way to abandon it early, e.g. once its client is gone.
+// The engine polls expired() as it evaluates. From the first true on it stops and returns
+// the best documents found so far, and stopped() tells the caller the result is partial.
+// The cancellation callback is slower than reading the clock, so it is only asked once
+// per CANCEL_CHECK_INTERVAL. Several threads can poll the same budget.
+class QueryBudget {
+    std::chrono::steady_clock::time_point deadline;
+    std::function<bool()> cancelled;
+    std::atomic<std::chrono::steady_clock::rep> nextCancelCheck;
+    std::atomic<bool> stop = false;
+
+    public:
+        // constructor, a budget without a deadline or a callback never expires
+        QueryBudget(std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max(),
+                    std::function<bool()> cancelled = {});
+
+        // default virtual destructor
+        virtual ~QueryBudget() = default;
+
+        bool expired();
+        bool stopped() const { return stop; }
+};
+
+#endif
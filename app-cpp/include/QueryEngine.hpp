@@ -0,0 +1,98 @@
+#ifndef QUERY_ENGINE_H
+#define QUERY_ENGINE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "IndexStore.hpp"
+#include "PostingIterators.hpp"
+#include "QueryBudget.hpp"
+#include "QueryScratch.hpp"
+#include "ThreadPool.hpp"
+#include "TopKCollector.hpp"
+
+enum class Ranking {
+    FREQUENCY,  // sum of the frequencies of the terms in the document
+    BM25        // BM25 over the documents' word counts
+};
+
+enum class IntersectionAlgorithm {
+    MERGE,      // walk both lists, for lists of similar size
+    GALLOP,     // gallop over the larger list to each candidate
+    BITMAP,     // mark dense candidates in a bitmap and test every posting of the list against it
+    PROBE       // look every candidate up in a list kept as a bitmap
+};
+
+// Boolean query over terms. AND and OR take any number of children, NOT takes one and
+// is evaluated as an exclusion when it sits under an AND next to other children. An OR
+// with a minimumShouldMatch of m only matches documents found by at least m children.
+struct BooleanQuery {
+    enum class Operator { TERM, AND, OR, NOT };
+
+    Operator op = Operator::TERM;
+    std::string term;                       // for TERM
+    std::vector<BooleanQuery> children;
+    size_t minimumShouldMatch = 1;          // for OR
+};
+
+// Documents a query matched. Pruning skips documents that cannot make the top k without
+// counting them, the total is then a lower bound, and a single term answered from the
+// head of its list gives the size of the list, deleted documents included.
+struct HitCount {
+    size_t total = 0;
+    bool exact = true;
+};
+
+// Order in which the lists of a conjunction are intersected, rarest first. The
+// algorithm of each step is picked when the step runs, from the actual number of
+// candidates left and the size and form of the next list. A conjunction of bitmap
+// lists only is intersected as bitmaps instead.
+struct ConjunctionPlan {
+    std::vector<const PostingList *> lists;
+    bool matchesNothing = false;    // a term was never indexed
+};
+
+// Evaluates search requests against the IndexStore, skipping the documents that were
+// deleted but are still in the posting lists. Callers evaluating many queries pass their
+// own QueryScratch, otherwise one is allocated for the query. With a QueryBudget, a query
+// stops once the budget expires and returns what it found by then: the walks over the
+// lists poll it every few documents, and the term at a time path, the intersection steps
+// and the bitmap merges look at it before each list. Queries large enough are split
+// across a pool of one thread less than the cores, shared by all the callers.
+class QueryEngine {
+    std::shared_ptr<IndexStore> store;
+    ThreadPool pool;
+
+    public:
+        // constructor
+        QueryEngine(std::shared_ptr<IndexStore> store);
+
+        // default virtual destructor
+        virtual ~QueryEngine() = default;
+
+        // the k best documents containing all the terms, and into hits how many there are
+        std::vector<ScoredDocument> searchAll(const std::vector<std::string> &terms, size_t k, Ranking ranking = Ranking::FREQUENCY,
+                                              QueryScratch *scratch = nullptr, HitCount *hits = nullptr,
+                                              QueryBudget *budget = nullptr);
+
+        // the k best documents matching a boolean query, scored by the terms they match;
+        // a plain conjunction goes to searchAll
+        std::vector<ScoredDocument> search(const BooleanQuery &query, size_t k, Ranking ranking = Ranking::FREQUENCY,
+                                           QueryScratch *scratch = nullptr, HitCount *hits = nullptr,
+                                           QueryBudget *budget = nullptr);
+
+        // how many documents match a boolean query, without ranking them
+        size_t count(const BooleanQuery &query, QueryBudget *budget = nullptr);
+
+        // whether any document matches a boolean query, stopping at the first one
+        bool exists(const BooleanQuery &query, QueryBudget *budget = nullptr);
+
+        // the pool, for callers spreading work of their own over it
+        ThreadPool &threadPool() { return pool; }
+
+        static ConjunctionPlan planConjunction(const IndexReader &reader, const std::vector<std::string> &terms);
+        static IntersectionAlgorithm chooseAlgorithm(size_t candidateCount, const PostingList &postings, uint32_t documentNumberBound);
+};
+
+#endif
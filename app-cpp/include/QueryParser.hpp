@@ -0,0 +1,46 @@
+#ifndef QUERY_PARSER_H
+#define QUERY_PARSER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "serverMessages.pb.h"
+
+// Parses a search query into the QueryNode tree sent to the server:
+//
+//     query    := and ("OR" and)*
+//     and      := unary (["AND"] unary)*       words next to each other are ANDed
+//     unary    := "NOT" unary | "(" query ")" ["~" number] | word ["~" [number]] | "/" regex "/"
+//
+// "(a b c d)~2" matches the documents with at least 2 of the operands of the group,
+// whether they were joined with AND or OR. Operators are upper case, like the terms the
+// search is case-sensitive. Parentheses do not need spaces around them. A word can hold
+// '*' and '?' wildcards, and a regular expression between slashes must match whole words.
+// "word~1" matches the words within 1 edit of it, 1 or 2, and 2 when the number is left out.
+class QueryParser {
+    std::vector<std::string> tokens;
+    size_t position = 0;
+    std::string error;
+
+    bool atToken(const char *token) const { return position < tokens.size() && tokens[position] == token; }
+    bool startsOperand() const;
+    bool parseOr(QueryNode &node);
+    bool parseAnd(QueryNode &node);
+    bool parseUnary(QueryNode &node);
+    bool parseMinimumShouldMatch(QueryNode &node);
+
+    public:
+        // constructor
+        QueryParser(const std::string &text);
+
+        // default virtual destructor
+        virtual ~QueryParser() = default;
+
+        // false with errorMessage() set when the query is malformed
+        bool parse(QueryNode &query);
+
+        const std::string &errorMessage() const { return error; }
+};
+
+#endif
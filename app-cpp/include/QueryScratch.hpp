@@ -0,0 +1,56 @@
+#ifndef QUERY_SCRATCH_H
+#define QUERY_SCRATCH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Memory a worker reuses from one query to the next instead of allocating it per query.
+//
+// The accumulator is a dense array indexed by document number. An entry only counts when
+// its generation tag matches the current generation, so starting a query is a counter
+// increment rather than a clear, and the documents touched are listed as they are first
+// seen. It costs 16 bytes per document number, which is why it is only used for queries
+// that touch a large share of the documents anyway.
+//
+// The document bits are a bitset over the document numbers that the caller sets and
+// then clears again from the same documents, so they are all zero between uses.
+class QueryScratch {
+    std::vector<double> scores;
+    std::vector<uint32_t> matchCounts;
+    std::vector<uint32_t> generations;
+    std::vector<uint32_t> touched;
+    uint32_t generation = 0;
+
+    std::vector<uint64_t> bits;
+
+    public:
+        // starts a new accumulation over document numbers below the bound
+        void resetAccumulator(uint32_t documentNumberBound);
+
+        void accumulate(uint32_t document, double score) {
+            if (generations[document] != generation) {
+                generations[document] = generation;
+                scores[document] = 0;
+                matchCounts[document] = 0;
+                touched.push_back(document);
+            }
+            scores[document] += score;
+            matchCounts[document]++;
+        }
+
+        // documents accumulated since the reset, in the order they were first seen
+        const std::vector<uint32_t> &touchedDocuments() const { return touched; }
+        double score(uint32_t document) const { return scores[document]; }
+        uint32_t matchCount(uint32_t document) const { return matchCounts[document]; }
+
+        // all zero bitset covering the document numbers below the bound
+        std::vector<uint64_t> &documentBits(uint32_t documentNumberBound) {
+            if (bits.size() < documentNumberBound / 64 + 1) {
+                bits.resize(documentNumberBound / 64 + 1, 0);
+            }
+            return bits;
+        }
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A reply as the serialized messages it is sent in, in order. The cache and every search
+// sending it share one copy.
+using ReplyMessages = std::shared_ptr<const std::vector<std::string>>;
+
+struct ResultCacheStats {
+    uint64_t hits;
+    uint64_t misses;
+    size_t entries;
+    size_t bytes;
+};
+
+// Replies of recent searches, keyed by the normalized query. An entry only
+// answers for the index generation it was computed at, any change to the index makes it
+// stale. Once the keys and replies held pass the capacity, the least recently used
+// entries are dropped first.
+class ResultCache {
+    struct Entry {
+        std::string key;
+        uint64_t generation;
+        ReplyMessages reply;
+        size_t bytes;           // of the key and the messages
+    };
+
+    size_t capacityBytes;
+    size_t usedBytes = 0;
+    std::list<Entry> entries;   // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> entryByKey;
+    std::mutex cacheMutex;
+
+    std::atomic<uint64_t> hits = 0;
+    std::atomic<uint64_t> misses = 0;
+
+    void erase(std::list<Entry>::iterator entry);
+
+    public:
+        // constructor
+        ResultCache(size_t capacityBytes);
+
+        // default virtual destructor
+        virtual ~ResultCache() = default;
+
+        // the reply cached for the key at this generation, false on a miss
+        bool find(const std::string &key, uint64_t generation, ReplyMessages &reply);
+
+        // caches the reply computed at the generation, unless it alone is over the capacity
+        void insert(const std::string &key, uint64_t generation, ReplyMessages reply);
+
+        ResultCacheStats stats();
+};
+
+#endif
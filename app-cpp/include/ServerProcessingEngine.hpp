@@ -8,6 +8,10 @@
 #include <thread>
 
 #include "IndexStore.hpp"
+#include "serverMessages.pb.h"
+#include "QueryEngine.hpp"
+#include "ResultCache.hpp"
+#include "SingleFlight.hpp"
 
 struct DocPathFreqPair {
     std::string documentPath;
@@ -22,6 +26,9 @@ struct ClientInfo {
 
 class ServerProcessingEngine {
     std::shared_ptr<IndexStore> store;
+    QueryEngine queryEngine;
+    ResultCache resultCache;
+    SingleFlight searchFlights;
 
     std::thread dispatcherThread;
     std::vector<std::thread> workerThreads;
@@ -32,6 +39,12 @@ class ServerProcessingEngine {
     std::mutex clientsMutex; 
     bool running = true;
     int clientPort;
+    std::string serverID;   // random per run, lets clients tell a restarted server apart
+
+
+    bool sendMessage(int clientSocket, const std::string &message);
+    ReplyMessages evaluateSearch(const SearchRequest &searchRequest, size_t chunkSize, QueryScratch &scratch, int clientSocket);
+    bool sendSearchReply(int clientSocket, const ReplyMessages &reply);
 
 
     public:
@@ -54,6 +67,11 @@ class ServerProcessingEngine {
 
         std::vector<std::string> getConnectedClients();
 
+        ResultCacheStats getCacheStats();
+
+        // searches that waited for the same search of another client instead of running
+        uint64_t getCoalescedSearches();
+
         std::string addClient(const std::string& clientIP, int clientPort);
 };
 
@@ -0,0 +1,40 @@
+#ifndef SINGLE_FLIGHT_H
+#define SINGLE_FLIGHT_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "ResultCache.hpp"
+
+// Lets concurrent callers asking for the same key share one evaluation: the first one
+// evaluates, the ones arriving before it is done wait and share its result.
+// Nothing is kept once the evaluation is done, that is the job of the ResultCache.
+class SingleFlight {
+    struct Flight {
+        bool done = false;
+        bool shared = false;
+        ReplyMessages result;
+        std::condition_variable doneCv;
+    };
+
+    std::unordered_map<std::string, std::shared_ptr<Flight>> flights;
+    std::mutex flightsMutex;
+    std::atomic<uint64_t> joined = 0;
+
+    public:
+        // The result of evaluate, or of the evaluation already running for the key. evaluate
+        // returns false for a result only good for its own caller, the callers waiting on it
+        // then evaluate for themselves.
+        ReplyMessages run(const std::string &key, const std::function<bool(ReplyMessages &result)> &evaluate);
+
+        // calls answered by another caller's evaluation
+        uint64_t joinedCount() const { return joined; }
+};
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef TERM_DICTIONARY_H
+#define TERM_DICTIONARY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Every indexed term in sorted order, to find the terms starting with a prefix without
+// going over the hash map. The terms are front coded: each one keeps the length of the
+// prefix it shares with the term before it and the rest of its bytes, both lengths as
+// varints. Every BLOCK_SIZE terms start a block written out in full, a binary search over
+// the first terms of the blocks finds where a prefix begins.
+//
+// The coded terms cannot take an insert in the middle, new terms wait in a sorted set
+// until there are enough of them to merge, at least a MERGE_RATIO share of the coded ones.
+class TermDictionary {
+    std::string codedTerms;
+    std::vector<uint32_t> blockOffsets;     // where every block starts in codedTerms
+    size_t codedCount = 0;
+    std::set<std::string, std::less<>> recentTerms;
+
+    static void putVarint(std::string &out, size_t value);
+    static size_t getVarint(const std::string &in, size_t &offset);
+
+    // decodes the term at offset over the one before it in term, returns the offset after it
+    size_t decodeNext(size_t offset, std::string &term) const;
+
+    std::string_view firstTerm(size_t block) const;
+
+    // the last block whose first term is below the target, where the terms from it begin;
+    // a search known to end at or after fromBlock gallops forward from there
+    size_t firstBlockFor(std::string_view target, size_t fromBlock = 0) const;
+
+    void merge();
+
+    public:
+        static constexpr size_t BLOCK_SIZE = 16;
+        static constexpr size_t MIN_MERGE_TERMS = 1024;
+        static constexpr size_t MERGE_RATIO = 8;
+
+        // Walks the coded and the recent terms together in sorted order. It is only valid
+        // while the dictionary does not change.
+        class Cursor {
+            const TermDictionary &dictionary;
+            std::string codedTerm;
+            size_t block = 0;           // of codedTerm
+            size_t nextOffset = 0;      // of the coded term after codedTerm
+            bool onCodedTerm = false;
+            std::set<std::string, std::less<>>::const_iterator recentTerm;
+
+            void nextCoded();
+            bool atCoded() const {
+                return onCodedTerm && (recentTerm == dictionary.recentTerms.end() || codedTerm < *recentTerm);
+            }
+
+            public:
+                // constructor, on the first term
+                Cursor(const TermDictionary &dictionary);
+
+                // moves to the first term >= target, in either direction; a short move forward
+                // stays in the blocks around the current term
+                void seek(std::string_view target);
+                void next();
+
+                bool valid() const { return onCodedTerm || recentTerm != dictionary.recentTerms.end(); }
+                const std::string &term() const { return atCoded() ? codedTerm : *recentTerm; }
+        };
+
+        // a term never seen before, callers add every term once
+        void add(const std::string &term);
+
+        // replaces the content with the given terms, in any order
+        void assign(std::vector<std::string> terms);
+
+        size_t size() const { return codedCount + recentTerms.size(); }
+
+        // calls function(term) for every term starting with prefix, in sorted order
+        template <typename Function>
+        void forEachWithPrefix(std::string_view prefix, Function &&function) const {
+            Cursor cursor(*this);
+            for (cursor.seek(prefix); cursor.valid() && cursor.term().starts_with(prefix); cursor.next()) {
+                function(cursor.term());
+            }
+        }
+
+        // Calls function(term) for every term the automaton accepts, in sorted order. The
+        // automaton's nextMatch(term, target) gives the smallest string it accepts from the
+        // term on: the term itself, or where the cursor seeks to over all the terms in between.
+        template <typename Automaton, typename Function>
+        void forEachAccepted(const Automaton &automaton, Function &&function) const {
+            std::string target;
+            Cursor cursor(*this);
+            while (cursor.valid()) {
+                if (!automaton.nextMatch(cursor.term(), target)) {
+                    return;
+                }
+                if (target == cursor.term()) {
+                    function(cursor.term());
+                    cursor.next();
+                } else {
+                    cursor.seek(target);
+                }
+            }
+        }
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads shared by every query, for the queries that are worth splitting.
+// The thread asking for work takes part in it too, so a pool of zero threads runs
+// everything on the caller.
+class ThreadPool {
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> tasks;
+    std::mutex tasksMutex;
+    std::condition_variable tasksCv;
+    bool stopping = false;
+
+    void runThread();
+
+    public:
+        // constructor
+        ThreadPool(size_t threadCount);
+
+        // finishes the queued tasks and joins the threads
+        virtual ~ThreadPool();
+
+        size_t size() const { return threads.size(); }
+
+        // calls function(0) ... function(count - 1) on the pool and the calling thread,
+        // returns once every call has returned
+        void parallelFor(size_t count, const std::function<void(size_t)> &function);
+};
+
+#endif
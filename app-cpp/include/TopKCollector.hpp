@@ -0,0 +1,48 @@
+#ifndef TOP_K_COLLECTOR_H
+#define TOP_K_COLLECTOR_H
+
+#include <cstddef>
+#include <vector>
+
+struct ScoredDocument {
+    long documentNumber;
+    double score;           // sum of the term frequencies, or the BM25 score
+};
+
+// Keeps the k best matches of a query in a min-heap, so a match that cannot make it is
+// dropped with one comparison against the worst kept match instead of being stored.
+// Higher scores rank first, and lower document numbers break ties.
+class TopKCollector {
+    size_t k;
+    std::vector<ScoredDocument> heap;   // worst kept match on top
+    size_t matches = 0;
+
+    public:
+        // constructor
+        TopKCollector(size_t k);
+
+        // default virtual destructor
+        virtual ~TopKCollector() = default;
+
+        void collect(long documentNumber, double score);
+
+        // once k matches are kept, a later document only gets in by scoring above threshold(),
+        // since documents are collected in increasing order and ties favour the earlier one
+        bool full() const { return k > 0 && heap.size() == k; }
+        double threshold() const { return heap.front().score; }
+
+        // every match passed to collect, kept or not
+        size_t totalMatches() const { return matches; }
+
+        // takes in the matches of a collector that saw other documents
+        void merge(const TopKCollector &other);
+
+        // the kept matches, best first
+        std::vector<ScoredDocument> takeSorted();
+
+        static bool ranksBefore(const ScoredDocument &a, const ScoredDocument &b) {
+            return a.score != b.score ? a.score > b.score : a.documentNumber < b.documentNumber;
+        }
+};
+
+#endif
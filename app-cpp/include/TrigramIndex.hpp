@@ -0,0 +1,51 @@
+#ifndef TRIGRAM_INDEX_H
+#define TRIGRAM_INDEX_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Trigrams a term needs to match a pattern: all of its trigrams and children under an AND,
+// any one of its children under an OR. An AND with neither matches every term.
+struct TrigramQuery {
+    enum class Operator { AND, OR };
+
+    Operator op = Operator::AND;
+    std::vector<uint32_t> trigrams;         // for AND
+    std::vector<TrigramQuery> children;
+
+    bool matchesAll() const { return op == Operator::AND && trigrams.empty() && children.empty(); }
+};
+
+// The terms of the index by every three consecutive bytes they contain, to find the terms
+// a substring or a regular expression can match without testing the whole dictionary.
+// The query derived from a pattern only keeps what every match must contain, so its
+// candidates are a superset of the matches and still have to be tested one by one.
+class TrigramIndex {
+    std::vector<std::string> terms;                                 // by term id
+    std::unordered_map<uint32_t, std::vector<uint32_t>> termsByTrigram;   // increasing term ids
+
+    public:
+        // a term never seen before, callers add every term once
+        void add(const std::string &term);
+
+        // replaces the content with the given terms
+        void assign(std::vector<std::string> terms);
+
+        // ids of the terms holding what the query asks for, in increasing order; the query must
+        // not match all the terms
+        std::vector<uint32_t> candidates(const TrigramQuery &query) const;
+
+        const std::string &term(uint32_t termId) const { return terms[termId]; }
+
+        // for a pattern where '*' stands for any characters and '?' for one
+        static TrigramQuery fromPattern(std::string_view pattern);
+
+        // for an ECMAScript regular expression matching whole terms
+        static TrigramQuery fromRegex(std::string_view regex);
+};
+
+#endif
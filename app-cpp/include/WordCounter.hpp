@@ -0,0 +1,65 @@
+#ifndef WORD_COUNTER_H
+#define WORD_COUNTER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Open addressing word -> count table whose keys are views into the buffer that
+// was tokenized. One counter is reused by each indexing thread, so the caller has
+// to keep that buffer alive until the counts have been serialized. Words added by
+// merge() are copied into the counter's own key blocks instead, which lets counts
+// outlive the chunk buffers they came from.
+class WordCounter {
+    struct Slot {
+        uint64_t hash;
+        const char *data;       // nullptr marks an empty slot
+        uint32_t length;
+        int32_t count;
+    };
+
+    std::vector<Slot> slots;            // capacity is always a power of two
+    std::vector<uint32_t> usedSlots;    // occupied slots, so clear() and forEach() skip the empty ones
+
+    std::vector<std::unique_ptr<char[]>> keyBlocks;
+    size_t keyBlockUsed;
+
+    void grow();
+    void insert(std::string_view word, uint64_t hash, int32_t count, bool copyKey);
+    const char *storeKey(std::string_view word);
+
+    public:
+        // constructor
+        WordCounter();
+
+        // default virtual destructor
+        virtual ~WordCounter() = default;
+
+        // forget the counted words, only touching the slots the last document used
+        void clear();
+
+        // tokenize the content (alphanumeric words longer than 2 characters) and count them
+        void countWords(std::string_view content);
+
+        // count a word whose hash was already computed with hashWord()
+        void add(std::string_view word, uint64_t hash, int32_t count = 1);
+
+        // add the counts of another counter, copying the words it does not share with this one
+        void merge(const WordCounter &other);
+
+        size_t size() const { return usedSlots.size(); }
+
+        template <typename Fn>
+        void forEach(Fn &&fn) const {
+            for (uint32_t index : usedSlots) {
+                const Slot &slot = slots[index];
+                fn(std::string_view(slot.data, slot.length), slot.count);
+            }
+        }
+
+        static uint64_t hashWord(std::string_view word);
+};
+
+#endif
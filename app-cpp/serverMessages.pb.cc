@@ -36,6 +36,7 @@ PROTOBUF_CONSTEXPR IndexRequest::IndexRequest(
     /*decltype(_impl_.word_frequencies_)*/{::_pbi::ConstantInitialized()}
   , /*decltype(_impl_.client_id_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.document_path_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.replace_document_number_)*/int64_t{0}
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct IndexRequestDefaultTypeInternal {
   PROTOBUF_CONSTEXPR IndexRequestDefaultTypeInternal()
@@ -60,10 +61,62 @@ struct IndexReplyDefaultTypeInternal {
   };
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 IndexReplyDefaultTypeInternal _IndexReply_default_instance_;
+PROTOBUF_CONSTEXPR DeleteRequest::DeleteRequest(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.document_numbers_)*/{}
+  , /*decltype(_impl_._document_numbers_cached_byte_size_)*/{0}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct DeleteRequestDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR DeleteRequestDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~DeleteRequestDefaultTypeInternal() {}
+  union {
+    DeleteRequest _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 DeleteRequestDefaultTypeInternal _DeleteRequest_default_instance_;
+PROTOBUF_CONSTEXPR HelloReply::HelloReply(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.server_id_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.client_name_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct HelloReplyDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR HelloReplyDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~HelloReplyDefaultTypeInternal() {}
+  union {
+    HelloReply _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 HelloReplyDefaultTypeInternal _HelloReply_default_instance_;
+PROTOBUF_CONSTEXPR QueryNode::QueryNode(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.children_)*/{}
+  , /*decltype(_impl_.term_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.type_)*/0
+  , /*decltype(_impl_.minimum_should_match_)*/0
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct QueryNodeDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR QueryNodeDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~QueryNodeDefaultTypeInternal() {}
+  union {
+    QueryNode _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 QueryNodeDefaultTypeInternal _QueryNode_default_instance_;
 PROTOBUF_CONSTEXPR SearchRequest::SearchRequest(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.terms_)*/{}
   , /*decltype(_impl_.logical_operators_)*/{}
+  , /*decltype(_impl_.continuation_token_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.query_)*/nullptr
+  , /*decltype(_impl_.k_)*/0
+  , /*decltype(_impl_.ranking_)*/0
+  , /*decltype(_impl_.offset_)*/0
+  , /*decltype(_impl_.chunk_size_)*/0
+  , /*decltype(_impl_.mode_)*/0
+  , /*decltype(_impl_.time_budget_ms_)*/0
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct SearchRequestDefaultTypeInternal {
   PROTOBUF_CONSTEXPR SearchRequestDefaultTypeInternal()
@@ -78,6 +131,7 @@ PROTOBUF_CONSTEXPR SearchReply_Document::SearchReply_Document(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.document_path_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.client_id_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
+  , /*decltype(_impl_.score_)*/0
   , /*decltype(_impl_.frequency_)*/0
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct SearchReply_DocumentDefaultTypeInternal {
@@ -92,8 +146,12 @@ PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORIT
 PROTOBUF_CONSTEXPR SearchReply::SearchReply(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.documents_)*/{}
+  , /*decltype(_impl_.continuation_token_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.execution_time_)*/0
   , /*decltype(_impl_.total_results_)*/0
+  , /*decltype(_impl_.total_is_estimate_)*/false
+  , /*decltype(_impl_.more_chunks_)*/false
+  , /*decltype(_impl_.partial_)*/false
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct SearchReplyDefaultTypeInternal {
   PROTOBUF_CONSTEXPR SearchReplyDefaultTypeInternal()
@@ -104,12 +162,26 @@ struct SearchReplyDefaultTypeInternal {
   };
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 SearchReplyDefaultTypeInternal _SearchReply_default_instance_;
+PROTOBUF_CONSTEXPR BatchSearchRequest::BatchSearchRequest(
+    ::_pbi::ConstantInitialized): _impl_{
+    /*decltype(_impl_.searches_)*/{}
+  , /*decltype(_impl_._cached_size_)*/{}} {}
+struct BatchSearchRequestDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR BatchSearchRequestDefaultTypeInternal()
+      : _instance(::_pbi::ConstantInitialized{}) {}
+  ~BatchSearchRequestDefaultTypeInternal() {}
+  union {
+    BatchSearchRequest _instance;
+  };
+};
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 BatchSearchRequestDefaultTypeInternal _BatchSearchRequest_default_instance_;
 PROTOBUF_CONSTEXPR ServerMessage::ServerMessage(
     ::_pbi::ConstantInitialized): _impl_{
     /*decltype(_impl_.index_request_)*/nullptr
   , /*decltype(_impl_.search_request_)*/nullptr
   , /*decltype(_impl_.index_reply_)*/nullptr
   , /*decltype(_impl_.search_reply_)*/nullptr
+  , /*decltype(_impl_.delete_request_)*/nullptr
   , /*decltype(_impl_.type_)*/0
   , /*decltype(_impl_._cached_size_)*/{}} {}
 struct ServerMessageDefaultTypeInternal {
@@ -121,8 +193,8 @@ struct ServerMessageDefaultTypeInternal {
   };
 };
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ServerMessageDefaultTypeInternal _ServerMessage_default_instance_;
-static ::_pb::Metadata file_level_metadata_serverMessages_2eproto[7];
-static const ::_pb::EnumDescriptor* file_level_enum_descriptors_serverMessages_2eproto[1];
+static ::_pb::Metadata file_level_metadata_serverMessages_2eproto[11];
+static const ::_pb::EnumDescriptor* file_level_enum_descriptors_serverMessages_2eproto[4];
 static constexpr ::_pb::ServiceDescriptor const** file_level_service_descriptors_serverMessages_2eproto = nullptr;
 
 const uint32_t TableStruct_serverMessages_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
@@ -145,6 +217,7 @@ const uint32_t TableStruct_serverMessages_2eproto::offsets[] PROTOBUF_SECTION_VA
   PROTOBUF_FIELD_OFFSET(::IndexRequest, _impl_.client_id_),
   PROTOBUF_FIELD_OFFSET(::IndexRequest, _impl_.document_path_),
   PROTOBUF_FIELD_OFFSET(::IndexRequest, _impl_.word_frequencies_),
+  PROTOBUF_FIELD_OFFSET(::IndexRequest, _impl_.replace_document_number_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::IndexReply, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -154,6 +227,31 @@ const uint32_t TableStruct_serverMessages_2eproto::offsets[] PROTOBUF_SECTION_VA
   PROTOBUF_FIELD_OFFSET(::IndexReply, _impl_.status_),
   PROTOBUF_FIELD_OFFSET(::IndexReply, _impl_.document_number_),
   ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::DeleteRequest, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::DeleteRequest, _impl_.document_numbers_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::HelloReply, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::HelloReply, _impl_.server_id_),
+  PROTOBUF_FIELD_OFFSET(::HelloReply, _impl_.client_name_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::QueryNode, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::QueryNode, _impl_.type_),
+  PROTOBUF_FIELD_OFFSET(::QueryNode, _impl_.term_),
+  PROTOBUF_FIELD_OFFSET(::QueryNode, _impl_.children_),
+  PROTOBUF_FIELD_OFFSET(::QueryNode, _impl_.minimum_should_match_),
+  ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::SearchRequest, _internal_metadata_),
   ~0u,  // no _extensions_
   ~0u,  // no _oneof_case_
@@ -161,6 +259,14 @@ const uint32_t TableStruct_serverMessages_2eproto::offsets[] PROTOBUF_SECTION_VA
   ~0u,  // no _inlined_string_donated_
   PROTOBUF_FIELD_OFFSET(::SearchRequest, _impl_.terms_),
   PROTOBUF_FIELD_OFFSET(::SearchRequest, _impl_.logical_operators_),
+  PROTOBUF_FIELD_OFFSET(::SearchRequest, _impl_.k_),
+  PROTOBUF_FIELD_OFFSET(::SearchRequest, _impl_.ranking_),
+  PROTOBUF_FIELD_OFFSET(::SearchRequest, _impl_.query_),
+  PROTOBUF_FIELD_OFFSET(::SearchRequest, _impl_.offset_),
+  PROTOBUF_FIELD_OFFSET(::SearchRequest, _impl_.continuation_token_),
+  PROTOBUF_FIELD_OFFSET(::SearchRequest, _impl_.chunk_size_),
+  PROTOBUF_FIELD_OFFSET(::SearchRequest, _impl_.mode_),
+  PROTOBUF_FIELD_OFFSET(::SearchRequest, _impl_.time_budget_ms_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::SearchReply_Document, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -170,6 +276,7 @@ const uint32_t TableStruct_serverMessages_2eproto::offsets[] PROTOBUF_SECTION_VA
   PROTOBUF_FIELD_OFFSET(::SearchReply_Document, _impl_.document_path_),
   PROTOBUF_FIELD_OFFSET(::SearchReply_Document, _impl_.frequency_),
   PROTOBUF_FIELD_OFFSET(::SearchReply_Document, _impl_.client_id_),
+  PROTOBUF_FIELD_OFFSET(::SearchReply_Document, _impl_.score_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::SearchReply, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -179,6 +286,17 @@ const uint32_t TableStruct_serverMessages_2eproto::offsets[] PROTOBUF_SECTION_VA
   PROTOBUF_FIELD_OFFSET(::SearchReply, _impl_.documents_),
   PROTOBUF_FIELD_OFFSET(::SearchReply, _impl_.total_results_),
   PROTOBUF_FIELD_OFFSET(::SearchReply, _impl_.execution_time_),
+  PROTOBUF_FIELD_OFFSET(::SearchReply, _impl_.total_is_estimate_),
+  PROTOBUF_FIELD_OFFSET(::SearchReply, _impl_.continuation_token_),
+  PROTOBUF_FIELD_OFFSET(::SearchReply, _impl_.more_chunks_),
+  PROTOBUF_FIELD_OFFSET(::SearchReply, _impl_.partial_),
+  ~0u,  // no _has_bits_
+  PROTOBUF_FIELD_OFFSET(::BatchSearchRequest, _internal_metadata_),
+  ~0u,  // no _extensions_
+  ~0u,  // no _oneof_case_
+  ~0u,  // no _weak_field_map_
+  ~0u,  // no _inlined_string_donated_
+  PROTOBUF_FIELD_OFFSET(::BatchSearchRequest, _impl_.searches_),
   ~0u,  // no _has_bits_
   PROTOBUF_FIELD_OFFSET(::ServerMessage, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -190,55 +308,84 @@ const uint32_t TableStruct_serverMessages_2eproto::offsets[] PROTOBUF_SECTION_VA
   PROTOBUF_FIELD_OFFSET(::ServerMessage, _impl_.search_request_),
   PROTOBUF_FIELD_OFFSET(::ServerMessage, _impl_.index_reply_),
   PROTOBUF_FIELD_OFFSET(::ServerMessage, _impl_.search_reply_),
+  PROTOBUF_FIELD_OFFSET(::ServerMessage, _impl_.delete_request_),
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
   { 0, 8, -1, sizeof(::IndexRequest_WordFrequenciesEntry_DoNotUse)},
   { 10, -1, -1, sizeof(::IndexRequest)},
-  { 19, -1, -1, sizeof(::IndexReply)},
-  { 27, -1, -1, sizeof(::SearchRequest)},
-  { 35, -1, -1, sizeof(::SearchReply_Document)},
-  { 44, -1, -1, sizeof(::SearchReply)},
-  { 53, -1, -1, sizeof(::ServerMessage)},
+  { 20, -1, -1, sizeof(::IndexReply)},
+  { 28, -1, -1, sizeof(::DeleteRequest)},
+  { 35, -1, -1, sizeof(::HelloReply)},
+  { 43, -1, -1, sizeof(::QueryNode)},
+  { 53, -1, -1, sizeof(::SearchRequest)},
+  { 69, -1, -1, sizeof(::SearchReply_Document)},
+  { 79, -1, -1, sizeof(::SearchReply)},
+  { 92, -1, -1, sizeof(::BatchSearchRequest)},
+  { 99, -1, -1, sizeof(::ServerMessage)},
 };
 
 static const ::_pb::Message* const file_default_instances[] = {
   &::_IndexRequest_WordFrequenciesEntry_DoNotUse_default_instance_._instance,
   &::_IndexRequest_default_instance_._instance,
   &::_IndexReply_default_instance_._instance,
+  &::_DeleteRequest_default_instance_._instance,
+  &::_HelloReply_default_instance_._instance,
+  &::_QueryNode_default_instance_._instance,
   &::_SearchRequest_default_instance_._instance,
   &::_SearchReply_Document_default_instance_._instance,
   &::_SearchReply_default_instance_._instance,
+  &::_BatchSearchRequest_default_instance_._instance,
   &::_ServerMessage_default_instance_._instance,
 };
 
 const char descriptor_table_protodef_serverMessages_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
-  "\n\024serverMessages.proto\"\256\001\n\014IndexRequest\022"
+  "\n\024serverMessages.proto\"\317\001\n\014IndexRequest\022"
   "\021\n\tclient_id\030\001 \001(\t\022\025\n\rdocument_path\030\002 \001("
   "\t\022<\n\020word_frequencies\030\003 \003(\0132\".IndexReque"
-  "st.WordFrequenciesEntry\0326\n\024WordFrequenci"
-  "esEntry\022\013\n\003key\030\001 \001(\t\022\r\n\005value\030\002 \001(\005:\0028\001\""
-  "5\n\nIndexReply\022\016\n\006status\030\001 \001(\t\022\027\n\017documen"
-  "t_number\030\002 \001(\003\"9\n\rSearchRequest\022\r\n\005terms"
-  "\030\001 \003(\t\022\031\n\021logical_operators\030\002 \003(\t\"\257\001\n\013Se"
-  "archReply\022(\n\tdocuments\030\001 \003(\0132\025.SearchRep"
-  "ly.Document\022\025\n\rtotal_results\030\002 \001(\005\022\026\n\016ex"
-  "ecution_time\030\003 \001(\001\032G\n\010Document\022\025\n\rdocume"
-  "nt_path\030\001 \001(\t\022\021\n\tfrequency\030\002 \001(\005\022\021\n\tclie"
-  "nt_id\030\003 \001(\t\"\260\002\n\rServerMessage\022(\n\004type\030\001 "
-  "\001(\0162\032.ServerMessage.MessageType\022$\n\rindex"
-  "_request\030\002 \001(\0132\r.IndexRequest\022&\n\016search_"
-  "request\030\003 \001(\0132\016.SearchRequest\022 \n\013index_r"
-  "eply\030\004 \001(\0132\013.IndexReply\022\"\n\014search_reply\030"
-  "\005 \001(\0132\014.SearchReply\"a\n\013MessageType\022\021\n\rIN"
-  "DEX_REQUEST\020\000\022\022\n\016SEARCH_REQUEST\020\001\022\017\n\013IND"
-  "EX_REPLY\020\002\022\020\n\014SEARCH_REPLY\020\003\022\010\n\004QUIT\020\004b\006"
-  "proto3"
+  "st.WordFrequenciesEntry\022\037\n\027replace_docum"
+  "ent_number\030\004 \001(\003\0326\n\024WordFrequenciesEntry"
+  "\022\013\n\003key\030\001 \001(\t\022\r\n\005value\030\002 \001(\005:\0028\001\"5\n\nInde"
+  "xReply\022\016\n\006status\030\001 \001(\t\022\027\n\017document_numbe"
+  "r\030\002 \001(\003\")\n\rDeleteRequest\022\030\n\020document_num"
+  "bers\030\001 \003(\003\"4\n\nHelloReply\022\021\n\tserver_id\030\001 "
+  "\001(\t\022\023\n\013client_name\030\002 \001(\t\"\250\001\n\tQueryNode\022!"
+  "\n\004type\030\001 \001(\0162\023.QueryNode.NodeType\022\014\n\004ter"
+  "m\030\002 \001(\t\022\034\n\010children\030\003 \003(\0132\n.QueryNode\022\034\n"
+  "\024minimum_should_match\030\004 \001(\005\".\n\010NodeType\022"
+  "\010\n\004TERM\020\000\022\007\n\003AND\020\001\022\006\n\002OR\020\002\022\007\n\003NOT\020\003\"\321\002\n\r"
+  "SearchRequest\022\r\n\005terms\030\001 \003(\t\022\031\n\021logical_"
+  "operators\030\002 \003(\t\022\t\n\001k\030\003 \001(\005\022\'\n\007ranking\030\004 "
+  "\001(\0162\026.SearchRequest.Ranking\022\031\n\005query\030\005 \001"
+  "(\0132\n.QueryNode\022\016\n\006offset\030\006 \001(\005\022\032\n\022contin"
+  "uation_token\030\007 \001(\t\022\022\n\nchunk_size\030\010 \001(\005\022!"
+  "\n\004mode\030\t \001(\0162\023.SearchRequest.Mode\022\026\n\016tim"
+  "e_budget_ms\030\n \001(\005\"\"\n\007Ranking\022\r\n\tFREQUENC"
+  "Y\020\000\022\010\n\004BM25\020\001\"(\n\004Mode\022\t\n\005TOP_K\020\000\022\t\n\005COUN"
+  "T\020\001\022\n\n\006EXISTS\020\002\"\233\002\n\013SearchReply\022(\n\tdocum"
+  "ents\030\001 \003(\0132\025.SearchReply.Document\022\025\n\rtot"
+  "al_results\030\002 \001(\005\022\026\n\016execution_time\030\003 \001(\001"
+  "\022\031\n\021total_is_estimate\030\005 \001(\010\022\032\n\022continuat"
+  "ion_token\030\006 \001(\t\022\023\n\013more_chunks\030\007 \001(\010\022\017\n\007"
+  "partial\030\010 \001(\010\032V\n\010Document\022\025\n\rdocument_pa"
+  "th\030\001 \001(\t\022\021\n\tfrequency\030\002 \001(\005\022\021\n\tclient_id"
+  "\030\003 \001(\t\022\r\n\005score\030\004 \001(\001\"6\n\022BatchSearchRequ"
+  "est\022 \n\010searches\030\001 \003(\0132\016.SearchRequest\"\354\002"
+  "\n\rServerMessage\022(\n\004type\030\001 \001(\0162\032.ServerMe"
+  "ssage.MessageType\022$\n\rindex_request\030\002 \001(\013"
+  "2\r.IndexRequest\022&\n\016search_request\030\003 \001(\0132"
+  "\016.SearchRequest\022 \n\013index_reply\030\004 \001(\0132\013.I"
+  "ndexReply\022\"\n\014search_reply\030\005 \001(\0132\014.Search"
+  "Reply\022&\n\016delete_request\030\006 \001(\0132\016.DeleteRe"
+  "quest\"u\n\013MessageType\022\021\n\rINDEX_REQUEST\020\000\022"
+  "\022\n\016SEARCH_REQUEST\020\001\022\017\n\013INDEX_REPLY\020\002\022\020\n\014"
+  "SEARCH_REPLY\020\003\022\010\n\004QUIT\020\004\022\022\n\016DELETE_REQUE"
+  "ST\020\005b\006proto3"
   ;
 static ::_pbi::once_flag descriptor_table_serverMessages_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_serverMessages_2eproto = {
-    false, false, 806, descriptor_table_protodef_serverMessages_2eproto,
+    false, false, 1612, descriptor_table_protodef_serverMessages_2eproto,
     "serverMessages.proto",
-    &descriptor_table_serverMessages_2eproto_once, nullptr, 0, 7,
+    &descriptor_table_serverMessages_2eproto_once, nullptr, 0, 11,
     schemas, file_default_instances, TableStruct_serverMessages_2eproto::offsets,
     file_level_metadata_serverMessages_2eproto, file_level_enum_descriptors_serverMessages_2eproto,
     file_level_service_descriptors_serverMessages_2eproto,
@@ -249,10 +396,79 @@ PROTOBUF_ATTRIBUTE_WEAK const ::_pbi::DescriptorTable* descriptor_table_serverMe
 
 // Force running AddDescriptors() at dynamic initialization time.
 PROTOBUF_ATTRIBUTE_INIT_PRIORITY2 static ::_pbi::AddDescriptorsRunner dynamic_init_dummy_serverMessages_2eproto(&descriptor_table_serverMessages_2eproto);
-const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* ServerMessage_MessageType_descriptor() {
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* QueryNode_NodeType_descriptor() {
   ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_serverMessages_2eproto);
   return file_level_enum_descriptors_serverMessages_2eproto[0];
 }
+bool QueryNode_NodeType_IsValid(int value) {
+  switch (value) {
+    case 0:
+    case 1:
+    case 2:
+    case 3:
+      return true;
+    default:
+      return false;
+  }
+}
+
+#if (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
+constexpr QueryNode_NodeType QueryNode::TERM;
+constexpr QueryNode_NodeType QueryNode::AND;
+constexpr QueryNode_NodeType QueryNode::OR;
+constexpr QueryNode_NodeType QueryNode::NOT;
+constexpr QueryNode_NodeType QueryNode::NodeType_MIN;
+constexpr QueryNode_NodeType QueryNode::NodeType_MAX;
+constexpr int QueryNode::NodeType_ARRAYSIZE;
+#endif  // (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* SearchRequest_Ranking_descriptor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_serverMessages_2eproto);
+  return file_level_enum_descriptors_serverMessages_2eproto[1];
+}
+bool SearchRequest_Ranking_IsValid(int value) {
+  switch (value) {
+    case 0:
+    case 1:
+      return true;
+    default:
+      return false;
+  }
+}
+
+#if (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
+constexpr SearchRequest_Ranking SearchRequest::FREQUENCY;
+constexpr SearchRequest_Ranking SearchRequest::BM25;
+constexpr SearchRequest_Ranking SearchRequest::Ranking_MIN;
+constexpr SearchRequest_Ranking SearchRequest::Ranking_MAX;
+constexpr int SearchRequest::Ranking_ARRAYSIZE;
+#endif  // (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* SearchRequest_Mode_descriptor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_serverMessages_2eproto);
+  return file_level_enum_descriptors_serverMessages_2eproto[2];
+}
+bool SearchRequest_Mode_IsValid(int value) {
+  switch (value) {
+    case 0:
+    case 1:
+    case 2:
+      return true;
+    default:
+      return false;
+  }
+}
+
+#if (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
+constexpr SearchRequest_Mode SearchRequest::TOP_K;
+constexpr SearchRequest_Mode SearchRequest::COUNT;
+constexpr SearchRequest_Mode SearchRequest::EXISTS;
+constexpr SearchRequest_Mode SearchRequest::Mode_MIN;
+constexpr SearchRequest_Mode SearchRequest::Mode_MAX;
+constexpr int SearchRequest::Mode_ARRAYSIZE;
+#endif  // (__cplusplus < 201703) && (!defined(_MSC_VER) || (_MSC_VER >= 1900 && _MSC_VER < 1912))
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* ServerMessage_MessageType_descriptor() {
+  ::PROTOBUF_NAMESPACE_ID::internal::AssignDescriptors(&descriptor_table_serverMessages_2eproto);
+  return file_level_enum_descriptors_serverMessages_2eproto[3];
+}
 bool ServerMessage_MessageType_IsValid(int value) {
   switch (value) {
     case 0:
@@ -260,6 +476,7 @@ bool ServerMessage_MessageType_IsValid(int value) {
     case 2:
     case 3:
     case 4:
+    case 5:
       return true;
     default:
       return false;
@@ -272,6 +489,7 @@ constexpr ServerMessage_MessageType ServerMessage::SEARCH_REQUEST;
 constexpr ServerMessage_MessageType ServerMessage::INDEX_REPLY;
 constexpr ServerMessage_MessageType ServerMessage::SEARCH_REPLY;
 constexpr ServerMessage_MessageType ServerMessage::QUIT;
+constexpr ServerMessage_MessageType ServerMessage::DELETE_REQUEST;
 constexpr ServerMessage_MessageType ServerMessage::MessageType_MIN;
 constexpr ServerMessage_MessageType ServerMessage::MessageType_MAX;
 constexpr int ServerMessage::MessageType_ARRAYSIZE;
@@ -313,6 +531,7 @@ IndexRequest::IndexRequest(const IndexRequest& from)
       /*decltype(_impl_.word_frequencies_)*/{}
     , decltype(_impl_.client_id_){}
     , decltype(_impl_.document_path_){}
+    , decltype(_impl_.replace_document_number_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
@@ -333,6 +552,7 @@ IndexRequest::IndexRequest(const IndexRequest& from)
     _this->_impl_.document_path_.Set(from._internal_document_path(), 
       _this->GetArenaForAllocation());
   }
+  _this->_impl_.replace_document_number_ = from._impl_.replace_document_number_;
   // @@protoc_insertion_point(copy_constructor:IndexRequest)
 }
 
@@ -344,6 +564,7 @@ inline void IndexRequest::SharedCtor(
       /*decltype(_impl_.word_frequencies_)*/{::_pbi::ArenaInitialized(), arena}
     , decltype(_impl_.client_id_){}
     , decltype(_impl_.document_path_){}
+    , decltype(_impl_.replace_document_number_){int64_t{0}}
     , /*decltype(_impl_._cached_size_)*/{}
   };
   _impl_.client_id_.InitDefault();
@@ -391,6 +612,7 @@ void IndexRequest::Clear() {
   _impl_.word_frequencies_.Clear();
   _impl_.client_id_.ClearToEmpty();
   _impl_.document_path_.ClearToEmpty();
+  _impl_.replace_document_number_ = int64_t{0};
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -433,6 +655,14 @@ const char* IndexRequest::_InternalParse(const char* ptr, ::_pbi::ParseContext*
         } else
           goto handle_unusual;
         continue;
+      // int64 replace_document_number = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _impl_.replace_document_number_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -508,6 +738,12 @@ uint8_t* IndexRequest::_InternalSerialize(
     }
   }
 
+  // int64 replace_document_number = 4;
+  if (this->_internal_replace_document_number() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt64ToArray(4, this->_internal_replace_document_number(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -547,6 +783,11 @@ size_t IndexRequest::ByteSizeLong() const {
         this->_internal_document_path());
   }
 
+  // int64 replace_document_number = 4;
+  if (this->_internal_replace_document_number() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int64SizePlusOne(this->_internal_replace_document_number());
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -572,6 +813,9 @@ void IndexRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::P
   if (!from._internal_document_path().empty()) {
     _this->_internal_set_document_path(from._internal_document_path());
   }
+  if (from._internal_replace_document_number() != 0) {
+    _this->_internal_set_replace_document_number(from._internal_replace_document_number());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -600,6 +844,7 @@ void IndexRequest::InternalSwap(IndexRequest* other) {
       &_impl_.document_path_, lhs_arena,
       &other->_impl_.document_path_, rhs_arena
   );
+  swap(_impl_.replace_document_number_, other->_impl_.replace_document_number_);
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata IndexRequest::GetMetadata() const {
@@ -840,41 +1085,41 @@ void IndexReply::InternalSwap(IndexReply* other) {
 
 // ===================================================================
 
-class SearchRequest::_Internal {
+class DeleteRequest::_Internal {
  public:
 };
 
-SearchRequest::SearchRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+DeleteRequest::DeleteRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                          bool is_message_owned)
   : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
   SharedCtor(arena, is_message_owned);
-  // @@protoc_insertion_point(arena_constructor:SearchRequest)
+  // @@protoc_insertion_point(arena_constructor:DeleteRequest)
 }
-SearchRequest::SearchRequest(const SearchRequest& from)
+DeleteRequest::DeleteRequest(const DeleteRequest& from)
   : ::PROTOBUF_NAMESPACE_ID::Message() {
-  SearchRequest* const _this = this; (void)_this;
+  DeleteRequest* const _this = this; (void)_this;
   new (&_impl_) Impl_{
-      decltype(_impl_.terms_){from._impl_.terms_}
-    , decltype(_impl_.logical_operators_){from._impl_.logical_operators_}
+      decltype(_impl_.document_numbers_){from._impl_.document_numbers_}
+    , /*decltype(_impl_._document_numbers_cached_byte_size_)*/{0}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  // @@protoc_insertion_point(copy_constructor:SearchRequest)
+  // @@protoc_insertion_point(copy_constructor:DeleteRequest)
 }
 
-inline void SearchRequest::SharedCtor(
+inline void DeleteRequest::SharedCtor(
     ::_pb::Arena* arena, bool is_message_owned) {
   (void)arena;
   (void)is_message_owned;
   new (&_impl_) Impl_{
-      decltype(_impl_.terms_){arena}
-    , decltype(_impl_.logical_operators_){arena}
+      decltype(_impl_.document_numbers_){arena}
+    , /*decltype(_impl_._document_numbers_cached_byte_size_)*/{0}
     , /*decltype(_impl_._cached_size_)*/{}
   };
 }
 
-SearchRequest::~SearchRequest() {
-  // @@protoc_insertion_point(destructor:SearchRequest)
+DeleteRequest::~DeleteRequest() {
+  // @@protoc_insertion_point(destructor:DeleteRequest)
   if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
   (void)arena;
     return;
@@ -882,60 +1127,39 @@ SearchRequest::~SearchRequest() {
   SharedDtor();
 }
 
-inline void SearchRequest::SharedDtor() {
+inline void DeleteRequest::SharedDtor() {
   GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
-  _impl_.terms_.~RepeatedPtrField();
-  _impl_.logical_operators_.~RepeatedPtrField();
+  _impl_.document_numbers_.~RepeatedField();
 }
 
-void SearchRequest::SetCachedSize(int size) const {
+void DeleteRequest::SetCachedSize(int size) const {
   _impl_._cached_size_.Set(size);
 }
 
-void SearchRequest::Clear() {
-// @@protoc_insertion_point(message_clear_start:SearchRequest)
+void DeleteRequest::Clear() {
+// @@protoc_insertion_point(message_clear_start:DeleteRequest)
   uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
-  _impl_.terms_.Clear();
-  _impl_.logical_operators_.Clear();
+  _impl_.document_numbers_.Clear();
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-const char* SearchRequest::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+const char* DeleteRequest::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
 #define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
   while (!ctx->Done(&ptr)) {
     uint32_t tag;
     ptr = ::_pbi::ReadTag(ptr, &tag);
     switch (tag >> 3) {
-      // repeated string terms = 1;
+      // repeated int64 document_numbers = 1;
       case 1:
         if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
-          ptr -= 1;
-          do {
-            ptr += 1;
-            auto str = _internal_add_terms();
-            ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
-            CHK_(ptr);
-            CHK_(::_pbi::VerifyUTF8(str, "SearchRequest.terms"));
-            if (!ctx->DataAvailable(ptr)) break;
-          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<10>(ptr));
-        } else
-          goto handle_unusual;
-        continue;
-      // repeated string logical_operators = 2;
-      case 2:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
-          ptr -= 1;
-          do {
-            ptr += 1;
-            auto str = _internal_add_logical_operators();
-            ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
-            CHK_(ptr);
-            CHK_(::_pbi::VerifyUTF8(str, "SearchRequest.logical_operators"));
-            if (!ctx->DataAvailable(ptr)) break;
-          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<18>(ptr));
+          ptr = ::PROTOBUF_NAMESPACE_ID::internal::PackedInt64Parser(_internal_mutable_document_numbers(), ptr, ctx);
+          CHK_(ptr);
+        } else if (static_cast<uint8_t>(tag) == 8) {
+          _internal_add_document_numbers(::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr));
+          CHK_(ptr);
         } else
           goto handle_unusual;
         continue;
@@ -962,106 +1186,91 @@ failure:
 #undef CHK_
 }
 
-uint8_t* SearchRequest::_InternalSerialize(
+uint8_t* DeleteRequest::_InternalSerialize(
     uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
-  // @@protoc_insertion_point(serialize_to_array_start:SearchRequest)
+  // @@protoc_insertion_point(serialize_to_array_start:DeleteRequest)
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
-  // repeated string terms = 1;
-  for (int i = 0, n = this->_internal_terms_size(); i < n; i++) {
-    const auto& s = this->_internal_terms(i);
-    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
-      s.data(), static_cast<int>(s.length()),
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
-      "SearchRequest.terms");
-    target = stream->WriteString(1, s, target);
-  }
-
-  // repeated string logical_operators = 2;
-  for (int i = 0, n = this->_internal_logical_operators_size(); i < n; i++) {
-    const auto& s = this->_internal_logical_operators(i);
-    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
-      s.data(), static_cast<int>(s.length()),
-      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
-      "SearchRequest.logical_operators");
-    target = stream->WriteString(2, s, target);
+  // repeated int64 document_numbers = 1;
+  {
+    int byte_size = _impl_._document_numbers_cached_byte_size_.load(std::memory_order_relaxed);
+    if (byte_size > 0) {
+      target = stream->WriteInt64Packed(
+          1, _internal_document_numbers(), byte_size, target);
+    }
   }
 
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
   }
-  // @@protoc_insertion_point(serialize_to_array_end:SearchRequest)
+  // @@protoc_insertion_point(serialize_to_array_end:DeleteRequest)
   return target;
 }
 
-size_t SearchRequest::ByteSizeLong() const {
-// @@protoc_insertion_point(message_byte_size_start:SearchRequest)
+size_t DeleteRequest::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:DeleteRequest)
   size_t total_size = 0;
 
   uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
-  // repeated string terms = 1;
-  total_size += 1 *
-      ::PROTOBUF_NAMESPACE_ID::internal::FromIntSize(_impl_.terms_.size());
-  for (int i = 0, n = _impl_.terms_.size(); i < n; i++) {
-    total_size += ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
-      _impl_.terms_.Get(i));
-  }
-
-  // repeated string logical_operators = 2;
-  total_size += 1 *
-      ::PROTOBUF_NAMESPACE_ID::internal::FromIntSize(_impl_.logical_operators_.size());
-  for (int i = 0, n = _impl_.logical_operators_.size(); i < n; i++) {
-    total_size += ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
-      _impl_.logical_operators_.Get(i));
+  // repeated int64 document_numbers = 1;
+  {
+    size_t data_size = ::_pbi::WireFormatLite::
+      Int64Size(this->_impl_.document_numbers_);
+    if (data_size > 0) {
+      total_size += 1 +
+        ::_pbi::WireFormatLite::Int32Size(static_cast<int32_t>(data_size));
+    }
+    int cached_size = ::_pbi::ToCachedSize(data_size);
+    _impl_._document_numbers_cached_byte_size_.store(cached_size,
+                                    std::memory_order_relaxed);
+    total_size += data_size;
   }
 
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
-const ::PROTOBUF_NAMESPACE_ID::Message::ClassData SearchRequest::_class_data_ = {
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData DeleteRequest::_class_data_ = {
     ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
-    SearchRequest::MergeImpl
+    DeleteRequest::MergeImpl
 };
-const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*SearchRequest::GetClassData() const { return &_class_data_; }
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*DeleteRequest::GetClassData() const { return &_class_data_; }
 
 
-void SearchRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
-  auto* const _this = static_cast<SearchRequest*>(&to_msg);
-  auto& from = static_cast<const SearchRequest&>(from_msg);
-  // @@protoc_insertion_point(class_specific_merge_from_start:SearchRequest)
+void DeleteRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<DeleteRequest*>(&to_msg);
+  auto& from = static_cast<const DeleteRequest&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:DeleteRequest)
   GOOGLE_DCHECK_NE(&from, _this);
   uint32_t cached_has_bits = 0;
   (void) cached_has_bits;
 
-  _this->_impl_.terms_.MergeFrom(from._impl_.terms_);
-  _this->_impl_.logical_operators_.MergeFrom(from._impl_.logical_operators_);
+  _this->_impl_.document_numbers_.MergeFrom(from._impl_.document_numbers_);
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
-void SearchRequest::CopyFrom(const SearchRequest& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:SearchRequest)
+void DeleteRequest::CopyFrom(const DeleteRequest& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:DeleteRequest)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-bool SearchRequest::IsInitialized() const {
+bool DeleteRequest::IsInitialized() const {
   return true;
 }
 
-void SearchRequest::InternalSwap(SearchRequest* other) {
+void DeleteRequest::InternalSwap(DeleteRequest* other) {
   using std::swap;
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
-  _impl_.terms_.InternalSwap(&other->_impl_.terms_);
-  _impl_.logical_operators_.InternalSwap(&other->_impl_.logical_operators_);
+  _impl_.document_numbers_.InternalSwap(&other->_impl_.document_numbers_);
 }
 
-::PROTOBUF_NAMESPACE_ID::Metadata SearchRequest::GetMetadata() const {
+::PROTOBUF_NAMESPACE_ID::Metadata DeleteRequest::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_serverMessages_2eproto_getter, &descriptor_table_serverMessages_2eproto_once,
       file_level_metadata_serverMessages_2eproto[3]);
@@ -1069,68 +1278,65 @@ void SearchRequest::InternalSwap(SearchRequest* other) {
 
 // ===================================================================
 
-class SearchReply_Document::_Internal {
+class HelloReply::_Internal {
  public:
 };
 
-SearchReply_Document::SearchReply_Document(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+HelloReply::HelloReply(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                          bool is_message_owned)
   : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
   SharedCtor(arena, is_message_owned);
-  // @@protoc_insertion_point(arena_constructor:SearchReply.Document)
+  // @@protoc_insertion_point(arena_constructor:HelloReply)
 }
-SearchReply_Document::SearchReply_Document(const SearchReply_Document& from)
+HelloReply::HelloReply(const HelloReply& from)
   : ::PROTOBUF_NAMESPACE_ID::Message() {
-  SearchReply_Document* const _this = this; (void)_this;
+  HelloReply* const _this = this; (void)_this;
   new (&_impl_) Impl_{
-      decltype(_impl_.document_path_){}
-    , decltype(_impl_.client_id_){}
-    , decltype(_impl_.frequency_){}
+      decltype(_impl_.server_id_){}
+    , decltype(_impl_.client_name_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
-  _impl_.document_path_.InitDefault();
+  _impl_.server_id_.InitDefault();
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    _impl_.document_path_.Set("", GetArenaForAllocation());
+    _impl_.server_id_.Set("", GetArenaForAllocation());
   #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (!from._internal_document_path().empty()) {
-    _this->_impl_.document_path_.Set(from._internal_document_path(), 
+  if (!from._internal_server_id().empty()) {
+    _this->_impl_.server_id_.Set(from._internal_server_id(), 
       _this->GetArenaForAllocation());
   }
-  _impl_.client_id_.InitDefault();
+  _impl_.client_name_.InitDefault();
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    _impl_.client_id_.Set("", GetArenaForAllocation());
+    _impl_.client_name_.Set("", GetArenaForAllocation());
   #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  if (!from._internal_client_id().empty()) {
-    _this->_impl_.client_id_.Set(from._internal_client_id(), 
+  if (!from._internal_client_name().empty()) {
+    _this->_impl_.client_name_.Set(from._internal_client_name(), 
       _this->GetArenaForAllocation());
   }
-  _this->_impl_.frequency_ = from._impl_.frequency_;
-  // @@protoc_insertion_point(copy_constructor:SearchReply.Document)
+  // @@protoc_insertion_point(copy_constructor:HelloReply)
 }
 
-inline void SearchReply_Document::SharedCtor(
+inline void HelloReply::SharedCtor(
     ::_pb::Arena* arena, bool is_message_owned) {
   (void)arena;
   (void)is_message_owned;
   new (&_impl_) Impl_{
-      decltype(_impl_.document_path_){}
-    , decltype(_impl_.client_id_){}
-    , decltype(_impl_.frequency_){0}
+      decltype(_impl_.server_id_){}
+    , decltype(_impl_.client_name_){}
     , /*decltype(_impl_._cached_size_)*/{}
   };
-  _impl_.document_path_.InitDefault();
+  _impl_.server_id_.InitDefault();
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    _impl_.document_path_.Set("", GetArenaForAllocation());
+    _impl_.server_id_.Set("", GetArenaForAllocation());
   #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
-  _impl_.client_id_.InitDefault();
+  _impl_.client_name_.InitDefault();
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
-    _impl_.client_id_.Set("", GetArenaForAllocation());
+    _impl_.client_name_.Set("", GetArenaForAllocation());
   #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
-SearchReply_Document::~SearchReply_Document() {
-  // @@protoc_insertion_point(destructor:SearchReply.Document)
+HelloReply::~HelloReply() {
+  // @@protoc_insertion_point(destructor:HelloReply)
   if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
   (void)arena;
     return;
@@ -1138,59 +1344,1113 @@ SearchReply_Document::~SearchReply_Document() {
   SharedDtor();
 }
 
-inline void SearchReply_Document::SharedDtor() {
+inline void HelloReply::SharedDtor() {
   GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
-  _impl_.document_path_.Destroy();
-  _impl_.client_id_.Destroy();
+  _impl_.server_id_.Destroy();
+  _impl_.client_name_.Destroy();
 }
 
-void SearchReply_Document::SetCachedSize(int size) const {
+void HelloReply::SetCachedSize(int size) const {
   _impl_._cached_size_.Set(size);
 }
 
-void SearchReply_Document::Clear() {
-// @@protoc_insertion_point(message_clear_start:SearchReply.Document)
+void HelloReply::Clear() {
+// @@protoc_insertion_point(message_clear_start:HelloReply)
   uint32_t cached_has_bits = 0;
   // Prevent compiler warnings about cached_has_bits being unused
   (void) cached_has_bits;
 
-  _impl_.document_path_.ClearToEmpty();
-  _impl_.client_id_.ClearToEmpty();
-  _impl_.frequency_ = 0;
+  _impl_.server_id_.ClearToEmpty();
+  _impl_.client_name_.ClearToEmpty();
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
-const char* SearchReply_Document::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+const char* HelloReply::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
 #define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
   while (!ctx->Done(&ptr)) {
     uint32_t tag;
     ptr = ::_pbi::ReadTag(ptr, &tag);
     switch (tag >> 3) {
-      // string document_path = 1;
+      // string server_id = 1;
       case 1:
         if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
-          auto str = _internal_mutable_document_path();
+          auto str = _internal_mutable_server_id();
           ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
           CHK_(ptr);
-          CHK_(::_pbi::VerifyUTF8(str, "SearchReply.Document.document_path"));
+          CHK_(::_pbi::VerifyUTF8(str, "HelloReply.server_id"));
         } else
           goto handle_unusual;
         continue;
-      // int32 frequency = 2;
+      // string client_name = 2;
       case 2:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
-          _impl_.frequency_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
-          CHK_(ptr);
-        } else
-          goto handle_unusual;
-        continue;
-      // string client_id = 3;
-      case 3:
-        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
-          auto str = _internal_mutable_client_id();
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          auto str = _internal_mutable_client_name();
           ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
           CHK_(ptr);
-          CHK_(::_pbi::VerifyUTF8(str, "SearchReply.Document.client_id"));
+          CHK_(::_pbi::VerifyUTF8(str, "HelloReply.client_name"));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* HelloReply::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:HelloReply)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // string server_id = 1;
+  if (!this->_internal_server_id().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_server_id().data(), static_cast<int>(this->_internal_server_id().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "HelloReply.server_id");
+    target = stream->WriteStringMaybeAliased(
+        1, this->_internal_server_id(), target);
+  }
+
+  // string client_name = 2;
+  if (!this->_internal_client_name().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_client_name().data(), static_cast<int>(this->_internal_client_name().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "HelloReply.client_name");
+    target = stream->WriteStringMaybeAliased(
+        2, this->_internal_client_name(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:HelloReply)
+  return target;
+}
+
+size_t HelloReply::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:HelloReply)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // string server_id = 1;
+  if (!this->_internal_server_id().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_server_id());
+  }
+
+  // string client_name = 2;
+  if (!this->_internal_client_name().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_client_name());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData HelloReply::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    HelloReply::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*HelloReply::GetClassData() const { return &_class_data_; }
+
+
+void HelloReply::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<HelloReply*>(&to_msg);
+  auto& from = static_cast<const HelloReply&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:HelloReply)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if (!from._internal_server_id().empty()) {
+    _this->_internal_set_server_id(from._internal_server_id());
+  }
+  if (!from._internal_client_name().empty()) {
+    _this->_internal_set_client_name(from._internal_client_name());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void HelloReply::CopyFrom(const HelloReply& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:HelloReply)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool HelloReply::IsInitialized() const {
+  return true;
+}
+
+void HelloReply::InternalSwap(HelloReply* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.server_id_, lhs_arena,
+      &other->_impl_.server_id_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.client_name_, lhs_arena,
+      &other->_impl_.client_name_, rhs_arena
+  );
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata HelloReply::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_serverMessages_2eproto_getter, &descriptor_table_serverMessages_2eproto_once,
+      file_level_metadata_serverMessages_2eproto[4]);
+}
+
+// ===================================================================
+
+class QueryNode::_Internal {
+ public:
+};
+
+QueryNode::QueryNode(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:QueryNode)
+}
+QueryNode::QueryNode(const QueryNode& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  QueryNode* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.children_){from._impl_.children_}
+    , decltype(_impl_.term_){}
+    , decltype(_impl_.type_){}
+    , decltype(_impl_.minimum_should_match_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.term_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.term_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_term().empty()) {
+    _this->_impl_.term_.Set(from._internal_term(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.type_, &from._impl_.type_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.minimum_should_match_) -
+    reinterpret_cast<char*>(&_impl_.type_)) + sizeof(_impl_.minimum_should_match_));
+  // @@protoc_insertion_point(copy_constructor:QueryNode)
+}
+
+inline void QueryNode::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.children_){arena}
+    , decltype(_impl_.term_){}
+    , decltype(_impl_.type_){0}
+    , decltype(_impl_.minimum_should_match_){0}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+  _impl_.term_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.term_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+QueryNode::~QueryNode() {
+  // @@protoc_insertion_point(destructor:QueryNode)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void QueryNode::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.children_.~RepeatedPtrField();
+  _impl_.term_.Destroy();
+}
+
+void QueryNode::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void QueryNode::Clear() {
+// @@protoc_insertion_point(message_clear_start:QueryNode)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.children_.Clear();
+  _impl_.term_.ClearToEmpty();
+  ::memset(&_impl_.type_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.minimum_should_match_) -
+      reinterpret_cast<char*>(&_impl_.type_)) + sizeof(_impl_.minimum_should_match_));
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* QueryNode::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // .QueryNode.NodeType type = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 8)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          _internal_set_type(static_cast<::QueryNode_NodeType>(val));
+        } else
+          goto handle_unusual;
+        continue;
+      // string term = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          auto str = _internal_mutable_term();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "QueryNode.term"));
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated .QueryNode children = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_children(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<26>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      // int32 minimum_should_match = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          _impl_.minimum_should_match_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* QueryNode::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:QueryNode)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // .QueryNode.NodeType type = 1;
+  if (this->_internal_type() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      1, this->_internal_type(), target);
+  }
+
+  // string term = 2;
+  if (!this->_internal_term().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_term().data(), static_cast<int>(this->_internal_term().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "QueryNode.term");
+    target = stream->WriteStringMaybeAliased(
+        2, this->_internal_term(), target);
+  }
+
+  // repeated .QueryNode children = 3;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_children_size()); i < n; i++) {
+    const auto& repfield = this->_internal_children(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(3, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  // int32 minimum_should_match = 4;
+  if (this->_internal_minimum_should_match() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(4, this->_internal_minimum_should_match(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:QueryNode)
+  return target;
+}
+
+size_t QueryNode::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:QueryNode)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .QueryNode children = 3;
+  total_size += 1UL * this->_internal_children_size();
+  for (const auto& msg : this->_impl_.children_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  // string term = 2;
+  if (!this->_internal_term().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_term());
+  }
+
+  // .QueryNode.NodeType type = 1;
+  if (this->_internal_type() != 0) {
+    total_size += 1 +
+      ::_pbi::WireFormatLite::EnumSize(this->_internal_type());
+  }
+
+  // int32 minimum_should_match = 4;
+  if (this->_internal_minimum_should_match() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_minimum_should_match());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData QueryNode::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    QueryNode::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*QueryNode::GetClassData() const { return &_class_data_; }
+
+
+void QueryNode::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<QueryNode*>(&to_msg);
+  auto& from = static_cast<const QueryNode&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:QueryNode)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.children_.MergeFrom(from._impl_.children_);
+  if (!from._internal_term().empty()) {
+    _this->_internal_set_term(from._internal_term());
+  }
+  if (from._internal_type() != 0) {
+    _this->_internal_set_type(from._internal_type());
+  }
+  if (from._internal_minimum_should_match() != 0) {
+    _this->_internal_set_minimum_should_match(from._internal_minimum_should_match());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void QueryNode::CopyFrom(const QueryNode& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:QueryNode)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool QueryNode::IsInitialized() const {
+  return true;
+}
+
+void QueryNode::InternalSwap(QueryNode* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.children_.InternalSwap(&other->_impl_.children_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.term_, lhs_arena,
+      &other->_impl_.term_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(QueryNode, _impl_.minimum_should_match_)
+      + sizeof(QueryNode::_impl_.minimum_should_match_)
+      - PROTOBUF_FIELD_OFFSET(QueryNode, _impl_.type_)>(
+          reinterpret_cast<char*>(&_impl_.type_),
+          reinterpret_cast<char*>(&other->_impl_.type_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata QueryNode::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_serverMessages_2eproto_getter, &descriptor_table_serverMessages_2eproto_once,
+      file_level_metadata_serverMessages_2eproto[5]);
+}
+
+// ===================================================================
+
+class SearchRequest::_Internal {
+ public:
+  static const ::QueryNode& query(const SearchRequest* msg);
+};
+
+const ::QueryNode&
+SearchRequest::_Internal::query(const SearchRequest* msg) {
+  return *msg->_impl_.query_;
+}
+SearchRequest::SearchRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:SearchRequest)
+}
+SearchRequest::SearchRequest(const SearchRequest& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  SearchRequest* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.terms_){from._impl_.terms_}
+    , decltype(_impl_.logical_operators_){from._impl_.logical_operators_}
+    , decltype(_impl_.continuation_token_){}
+    , decltype(_impl_.query_){nullptr}
+    , decltype(_impl_.k_){}
+    , decltype(_impl_.ranking_){}
+    , decltype(_impl_.offset_){}
+    , decltype(_impl_.chunk_size_){}
+    , decltype(_impl_.mode_){}
+    , decltype(_impl_.time_budget_ms_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.continuation_token_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.continuation_token_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_continuation_token().empty()) {
+    _this->_impl_.continuation_token_.Set(from._internal_continuation_token(), 
+      _this->GetArenaForAllocation());
+  }
+  if (from._internal_has_query()) {
+    _this->_impl_.query_ = new ::QueryNode(*from._impl_.query_);
+  }
+  ::memcpy(&_impl_.k_, &from._impl_.k_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.time_budget_ms_) -
+    reinterpret_cast<char*>(&_impl_.k_)) + sizeof(_impl_.time_budget_ms_));
+  // @@protoc_insertion_point(copy_constructor:SearchRequest)
+}
+
+inline void SearchRequest::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.terms_){arena}
+    , decltype(_impl_.logical_operators_){arena}
+    , decltype(_impl_.continuation_token_){}
+    , decltype(_impl_.query_){nullptr}
+    , decltype(_impl_.k_){0}
+    , decltype(_impl_.ranking_){0}
+    , decltype(_impl_.offset_){0}
+    , decltype(_impl_.chunk_size_){0}
+    , decltype(_impl_.mode_){0}
+    , decltype(_impl_.time_budget_ms_){0}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+  _impl_.continuation_token_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.continuation_token_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+SearchRequest::~SearchRequest() {
+  // @@protoc_insertion_point(destructor:SearchRequest)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void SearchRequest::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.terms_.~RepeatedPtrField();
+  _impl_.logical_operators_.~RepeatedPtrField();
+  _impl_.continuation_token_.Destroy();
+  if (this != internal_default_instance()) delete _impl_.query_;
+}
+
+void SearchRequest::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void SearchRequest::Clear() {
+// @@protoc_insertion_point(message_clear_start:SearchRequest)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.terms_.Clear();
+  _impl_.logical_operators_.Clear();
+  _impl_.continuation_token_.ClearToEmpty();
+  if (GetArenaForAllocation() == nullptr && _impl_.query_ != nullptr) {
+    delete _impl_.query_;
+  }
+  _impl_.query_ = nullptr;
+  ::memset(&_impl_.k_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.time_budget_ms_) -
+      reinterpret_cast<char*>(&_impl_.k_)) + sizeof(_impl_.time_budget_ms_));
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* SearchRequest::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated string terms = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            auto str = _internal_add_terms();
+            ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+            CHK_(ptr);
+            CHK_(::_pbi::VerifyUTF8(str, "SearchRequest.terms"));
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<10>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      // repeated string logical_operators = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 18)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            auto str = _internal_add_logical_operators();
+            ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+            CHK_(ptr);
+            CHK_(::_pbi::VerifyUTF8(str, "SearchRequest.logical_operators"));
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<18>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      // int32 k = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 24)) {
+          _impl_.k_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // .SearchRequest.Ranking ranking = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 32)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          _internal_set_ranking(static_cast<::SearchRequest_Ranking>(val));
+        } else
+          goto handle_unusual;
+        continue;
+      // .QueryNode query = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 42)) {
+          ptr = ctx->ParseMessage(_internal_mutable_query(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // int32 offset = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 48)) {
+          _impl_.offset_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // string continuation_token = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 58)) {
+          auto str = _internal_mutable_continuation_token();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "SearchRequest.continuation_token"));
+        } else
+          goto handle_unusual;
+        continue;
+      // int32 chunk_size = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 64)) {
+          _impl_.chunk_size_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // .SearchRequest.Mode mode = 9;
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 72)) {
+          uint64_t val = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+          _internal_set_mode(static_cast<::SearchRequest_Mode>(val));
+        } else
+          goto handle_unusual;
+        continue;
+      // int32 time_budget_ms = 10;
+      case 10:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 80)) {
+          _impl_.time_budget_ms_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* SearchRequest::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:SearchRequest)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated string terms = 1;
+  for (int i = 0, n = this->_internal_terms_size(); i < n; i++) {
+    const auto& s = this->_internal_terms(i);
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      s.data(), static_cast<int>(s.length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "SearchRequest.terms");
+    target = stream->WriteString(1, s, target);
+  }
+
+  // repeated string logical_operators = 2;
+  for (int i = 0, n = this->_internal_logical_operators_size(); i < n; i++) {
+    const auto& s = this->_internal_logical_operators(i);
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      s.data(), static_cast<int>(s.length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "SearchRequest.logical_operators");
+    target = stream->WriteString(2, s, target);
+  }
+
+  // int32 k = 3;
+  if (this->_internal_k() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(3, this->_internal_k(), target);
+  }
+
+  // .SearchRequest.Ranking ranking = 4;
+  if (this->_internal_ranking() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      4, this->_internal_ranking(), target);
+  }
+
+  // .QueryNode query = 5;
+  if (this->_internal_has_query()) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(5, _Internal::query(this),
+        _Internal::query(this).GetCachedSize(), target, stream);
+  }
+
+  // int32 offset = 6;
+  if (this->_internal_offset() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(6, this->_internal_offset(), target);
+  }
+
+  // string continuation_token = 7;
+  if (!this->_internal_continuation_token().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_continuation_token().data(), static_cast<int>(this->_internal_continuation_token().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "SearchRequest.continuation_token");
+    target = stream->WriteStringMaybeAliased(
+        7, this->_internal_continuation_token(), target);
+  }
+
+  // int32 chunk_size = 8;
+  if (this->_internal_chunk_size() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(8, this->_internal_chunk_size(), target);
+  }
+
+  // .SearchRequest.Mode mode = 9;
+  if (this->_internal_mode() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteEnumToArray(
+      9, this->_internal_mode(), target);
+  }
+
+  // int32 time_budget_ms = 10;
+  if (this->_internal_time_budget_ms() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteInt32ToArray(10, this->_internal_time_budget_ms(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:SearchRequest)
+  return target;
+}
+
+size_t SearchRequest::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:SearchRequest)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated string terms = 1;
+  total_size += 1 *
+      ::PROTOBUF_NAMESPACE_ID::internal::FromIntSize(_impl_.terms_.size());
+  for (int i = 0, n = _impl_.terms_.size(); i < n; i++) {
+    total_size += ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+      _impl_.terms_.Get(i));
+  }
+
+  // repeated string logical_operators = 2;
+  total_size += 1 *
+      ::PROTOBUF_NAMESPACE_ID::internal::FromIntSize(_impl_.logical_operators_.size());
+  for (int i = 0, n = _impl_.logical_operators_.size(); i < n; i++) {
+    total_size += ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+      _impl_.logical_operators_.Get(i));
+  }
+
+  // string continuation_token = 7;
+  if (!this->_internal_continuation_token().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_continuation_token());
+  }
+
+  // .QueryNode query = 5;
+  if (this->_internal_has_query()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.query_);
+  }
+
+  // int32 k = 3;
+  if (this->_internal_k() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_k());
+  }
+
+  // .SearchRequest.Ranking ranking = 4;
+  if (this->_internal_ranking() != 0) {
+    total_size += 1 +
+      ::_pbi::WireFormatLite::EnumSize(this->_internal_ranking());
+  }
+
+  // int32 offset = 6;
+  if (this->_internal_offset() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_offset());
+  }
+
+  // int32 chunk_size = 8;
+  if (this->_internal_chunk_size() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_chunk_size());
+  }
+
+  // .SearchRequest.Mode mode = 9;
+  if (this->_internal_mode() != 0) {
+    total_size += 1 +
+      ::_pbi::WireFormatLite::EnumSize(this->_internal_mode());
+  }
+
+  // int32 time_budget_ms = 10;
+  if (this->_internal_time_budget_ms() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_time_budget_ms());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData SearchRequest::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    SearchRequest::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*SearchRequest::GetClassData() const { return &_class_data_; }
+
+
+void SearchRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<SearchRequest*>(&to_msg);
+  auto& from = static_cast<const SearchRequest&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:SearchRequest)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.terms_.MergeFrom(from._impl_.terms_);
+  _this->_impl_.logical_operators_.MergeFrom(from._impl_.logical_operators_);
+  if (!from._internal_continuation_token().empty()) {
+    _this->_internal_set_continuation_token(from._internal_continuation_token());
+  }
+  if (from._internal_has_query()) {
+    _this->_internal_mutable_query()->::QueryNode::MergeFrom(
+        from._internal_query());
+  }
+  if (from._internal_k() != 0) {
+    _this->_internal_set_k(from._internal_k());
+  }
+  if (from._internal_ranking() != 0) {
+    _this->_internal_set_ranking(from._internal_ranking());
+  }
+  if (from._internal_offset() != 0) {
+    _this->_internal_set_offset(from._internal_offset());
+  }
+  if (from._internal_chunk_size() != 0) {
+    _this->_internal_set_chunk_size(from._internal_chunk_size());
+  }
+  if (from._internal_mode() != 0) {
+    _this->_internal_set_mode(from._internal_mode());
+  }
+  if (from._internal_time_budget_ms() != 0) {
+    _this->_internal_set_time_budget_ms(from._internal_time_budget_ms());
+  }
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void SearchRequest::CopyFrom(const SearchRequest& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:SearchRequest)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool SearchRequest::IsInitialized() const {
+  return true;
+}
+
+void SearchRequest::InternalSwap(SearchRequest* other) {
+  using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.terms_.InternalSwap(&other->_impl_.terms_);
+  _impl_.logical_operators_.InternalSwap(&other->_impl_.logical_operators_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.continuation_token_, lhs_arena,
+      &other->_impl_.continuation_token_, rhs_arena
+  );
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(SearchRequest, _impl_.time_budget_ms_)
+      + sizeof(SearchRequest::_impl_.time_budget_ms_)
+      - PROTOBUF_FIELD_OFFSET(SearchRequest, _impl_.query_)>(
+          reinterpret_cast<char*>(&_impl_.query_),
+          reinterpret_cast<char*>(&other->_impl_.query_));
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata SearchRequest::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_serverMessages_2eproto_getter, &descriptor_table_serverMessages_2eproto_once,
+      file_level_metadata_serverMessages_2eproto[6]);
+}
+
+// ===================================================================
+
+class SearchReply_Document::_Internal {
+ public:
+};
+
+SearchReply_Document::SearchReply_Document(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:SearchReply.Document)
+}
+SearchReply_Document::SearchReply_Document(const SearchReply_Document& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  SearchReply_Document* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.document_path_){}
+    , decltype(_impl_.client_id_){}
+    , decltype(_impl_.score_){}
+    , decltype(_impl_.frequency_){}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.document_path_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.document_path_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_document_path().empty()) {
+    _this->_impl_.document_path_.Set(from._internal_document_path(), 
+      _this->GetArenaForAllocation());
+  }
+  _impl_.client_id_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.client_id_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_client_id().empty()) {
+    _this->_impl_.client_id_.Set(from._internal_client_id(), 
+      _this->GetArenaForAllocation());
+  }
+  ::memcpy(&_impl_.score_, &from._impl_.score_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.frequency_) -
+    reinterpret_cast<char*>(&_impl_.score_)) + sizeof(_impl_.frequency_));
+  // @@protoc_insertion_point(copy_constructor:SearchReply.Document)
+}
+
+inline void SearchReply_Document::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.document_path_){}
+    , decltype(_impl_.client_id_){}
+    , decltype(_impl_.score_){0}
+    , decltype(_impl_.frequency_){0}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+  _impl_.document_path_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.document_path_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  _impl_.client_id_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.client_id_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+}
+
+SearchReply_Document::~SearchReply_Document() {
+  // @@protoc_insertion_point(destructor:SearchReply.Document)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void SearchReply_Document::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.document_path_.Destroy();
+  _impl_.client_id_.Destroy();
+}
+
+void SearchReply_Document::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void SearchReply_Document::Clear() {
+// @@protoc_insertion_point(message_clear_start:SearchReply.Document)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.document_path_.ClearToEmpty();
+  _impl_.client_id_.ClearToEmpty();
+  ::memset(&_impl_.score_, 0, static_cast<size_t>(
+      reinterpret_cast<char*>(&_impl_.frequency_) -
+      reinterpret_cast<char*>(&_impl_.score_)) + sizeof(_impl_.frequency_));
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* SearchReply_Document::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // string document_path = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          auto str = _internal_mutable_document_path();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "SearchReply.Document.document_path"));
+        } else
+          goto handle_unusual;
+        continue;
+      // int32 frequency = 2;
+      case 2:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 16)) {
+          _impl_.frequency_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint32(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // string client_id = 3;
+      case 3:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 26)) {
+          auto str = _internal_mutable_client_id();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "SearchReply.Document.client_id"));
+        } else
+          goto handle_unusual;
+        continue;
+      // double score = 4;
+      case 4:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 33)) {
+          _impl_.score_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<double>(ptr);
+          ptr += sizeof(double);
         } else
           goto handle_unusual;
         continue;
@@ -1249,6 +2509,16 @@ uint8_t* SearchReply_Document::_InternalSerialize(
         3, this->_internal_client_id(), target);
   }
 
+  // double score = 4;
+  static_assert(sizeof(uint64_t) == sizeof(double), "Code assumes uint64_t and double are the same size.");
+  double tmp_score = this->_internal_score();
+  uint64_t raw_score;
+  memcpy(&raw_score, &tmp_score, sizeof(tmp_score));
+  if (raw_score != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(4, this->_internal_score(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -1279,6 +2549,15 @@ size_t SearchReply_Document::ByteSizeLong() const {
         this->_internal_client_id());
   }
 
+  // double score = 4;
+  static_assert(sizeof(uint64_t) == sizeof(double), "Code assumes uint64_t and double are the same size.");
+  double tmp_score = this->_internal_score();
+  uint64_t raw_score;
+  memcpy(&raw_score, &tmp_score, sizeof(tmp_score));
+  if (raw_score != 0) {
+    total_size += 1 + 8;
+  }
+
   // int32 frequency = 2;
   if (this->_internal_frequency() != 0) {
     total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_frequency());
@@ -1308,6 +2587,13 @@ void SearchReply_Document::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, c
   if (!from._internal_client_id().empty()) {
     _this->_internal_set_client_id(from._internal_client_id());
   }
+  static_assert(sizeof(uint64_t) == sizeof(double), "Code assumes uint64_t and double are the same size.");
+  double tmp_score = from._internal_score();
+  uint64_t raw_score;
+  memcpy(&raw_score, &tmp_score, sizeof(tmp_score));
+  if (raw_score != 0) {
+    _this->_internal_set_score(from._internal_score());
+  }
   if (from._internal_frequency() != 0) {
     _this->_internal_set_frequency(from._internal_frequency());
   }
@@ -1338,13 +2624,18 @@ void SearchReply_Document::InternalSwap(SearchReply_Document* other) {
       &_impl_.client_id_, lhs_arena,
       &other->_impl_.client_id_, rhs_arena
   );
-  swap(_impl_.frequency_, other->_impl_.frequency_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(SearchReply_Document, _impl_.frequency_)
+      + sizeof(SearchReply_Document::_impl_.frequency_)
+      - PROTOBUF_FIELD_OFFSET(SearchReply_Document, _impl_.score_)>(
+          reinterpret_cast<char*>(&_impl_.score_),
+          reinterpret_cast<char*>(&other->_impl_.score_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata SearchReply_Document::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_serverMessages_2eproto_getter, &descriptor_table_serverMessages_2eproto_once,
-      file_level_metadata_serverMessages_2eproto[4]);
+      file_level_metadata_serverMessages_2eproto[7]);
 }
 
 // ===================================================================
@@ -1364,14 +2655,26 @@ SearchReply::SearchReply(const SearchReply& from)
   SearchReply* const _this = this; (void)_this;
   new (&_impl_) Impl_{
       decltype(_impl_.documents_){from._impl_.documents_}
+    , decltype(_impl_.continuation_token_){}
     , decltype(_impl_.execution_time_){}
     , decltype(_impl_.total_results_){}
+    , decltype(_impl_.total_is_estimate_){}
+    , decltype(_impl_.more_chunks_){}
+    , decltype(_impl_.partial_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  _impl_.continuation_token_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.continuation_token_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (!from._internal_continuation_token().empty()) {
+    _this->_impl_.continuation_token_.Set(from._internal_continuation_token(), 
+      _this->GetArenaForAllocation());
+  }
   ::memcpy(&_impl_.execution_time_, &from._impl_.execution_time_,
-    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.total_results_) -
-    reinterpret_cast<char*>(&_impl_.execution_time_)) + sizeof(_impl_.total_results_));
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.partial_) -
+    reinterpret_cast<char*>(&_impl_.execution_time_)) + sizeof(_impl_.partial_));
   // @@protoc_insertion_point(copy_constructor:SearchReply)
 }
 
@@ -1381,10 +2684,18 @@ inline void SearchReply::SharedCtor(
   (void)is_message_owned;
   new (&_impl_) Impl_{
       decltype(_impl_.documents_){arena}
+    , decltype(_impl_.continuation_token_){}
     , decltype(_impl_.execution_time_){0}
     , decltype(_impl_.total_results_){0}
+    , decltype(_impl_.total_is_estimate_){false}
+    , decltype(_impl_.more_chunks_){false}
+    , decltype(_impl_.partial_){false}
     , /*decltype(_impl_._cached_size_)*/{}
   };
+  _impl_.continuation_token_.InitDefault();
+  #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+    _impl_.continuation_token_.Set("", GetArenaForAllocation());
+  #endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
 }
 
 SearchReply::~SearchReply() {
@@ -1399,6 +2710,7 @@ SearchReply::~SearchReply() {
 inline void SearchReply::SharedDtor() {
   GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
   _impl_.documents_.~RepeatedPtrField();
+  _impl_.continuation_token_.Destroy();
 }
 
 void SearchReply::SetCachedSize(int size) const {
@@ -1412,9 +2724,10 @@ void SearchReply::Clear() {
   (void) cached_has_bits;
 
   _impl_.documents_.Clear();
+  _impl_.continuation_token_.ClearToEmpty();
   ::memset(&_impl_.execution_time_, 0, static_cast<size_t>(
-      reinterpret_cast<char*>(&_impl_.total_results_) -
-      reinterpret_cast<char*>(&_impl_.execution_time_)) + sizeof(_impl_.total_results_));
+      reinterpret_cast<char*>(&_impl_.partial_) -
+      reinterpret_cast<char*>(&_impl_.execution_time_)) + sizeof(_impl_.partial_));
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
 
@@ -1453,6 +2766,40 @@ const char* SearchReply::_InternalParse(const char* ptr, ::_pbi::ParseContext* c
         } else
           goto handle_unusual;
         continue;
+      // bool total_is_estimate = 5;
+      case 5:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 40)) {
+          _impl_.total_is_estimate_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // string continuation_token = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 50)) {
+          auto str = _internal_mutable_continuation_token();
+          ptr = ::_pbi::InlineGreedyStringParser(str, ptr, ctx);
+          CHK_(ptr);
+          CHK_(::_pbi::VerifyUTF8(str, "SearchReply.continuation_token"));
+        } else
+          goto handle_unusual;
+        continue;
+      // bool more_chunks = 7;
+      case 7:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 56)) {
+          _impl_.more_chunks_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
+      // bool partial = 8;
+      case 8:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 64)) {
+          _impl_.partial_ = ::PROTOBUF_NAMESPACE_ID::internal::ReadVarint64(&ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -1506,6 +2853,34 @@ uint8_t* SearchReply::_InternalSerialize(
     target = ::_pbi::WireFormatLite::WriteDoubleToArray(3, this->_internal_execution_time(), target);
   }
 
+  // bool total_is_estimate = 5;
+  if (this->_internal_total_is_estimate() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(5, this->_internal_total_is_estimate(), target);
+  }
+
+  // string continuation_token = 6;
+  if (!this->_internal_continuation_token().empty()) {
+    ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::VerifyUtf8String(
+      this->_internal_continuation_token().data(), static_cast<int>(this->_internal_continuation_token().length()),
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::SERIALIZE,
+      "SearchReply.continuation_token");
+    target = stream->WriteStringMaybeAliased(
+        6, this->_internal_continuation_token(), target);
+  }
+
+  // bool more_chunks = 7;
+  if (this->_internal_more_chunks() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(7, this->_internal_more_chunks(), target);
+  }
+
+  // bool partial = 8;
+  if (this->_internal_partial() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(8, this->_internal_partial(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -1529,6 +2904,13 @@ size_t SearchReply::ByteSizeLong() const {
       ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
   }
 
+  // string continuation_token = 6;
+  if (!this->_internal_continuation_token().empty()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::StringSize(
+        this->_internal_continuation_token());
+  }
+
   // double execution_time = 3;
   static_assert(sizeof(uint64_t) == sizeof(double), "Code assumes uint64_t and double are the same size.");
   double tmp_execution_time = this->_internal_execution_time();
@@ -1543,6 +2925,21 @@ size_t SearchReply::ByteSizeLong() const {
     total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(this->_internal_total_results());
   }
 
+  // bool total_is_estimate = 5;
+  if (this->_internal_total_is_estimate() != 0) {
+    total_size += 1 + 1;
+  }
+
+  // bool more_chunks = 7;
+  if (this->_internal_more_chunks() != 0) {
+    total_size += 1 + 1;
+  }
+
+  // bool partial = 8;
+  if (this->_internal_partial() != 0) {
+    total_size += 1 + 1;
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -1562,6 +2959,9 @@ void SearchReply::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PR
   (void) cached_has_bits;
 
   _this->_impl_.documents_.MergeFrom(from._impl_.documents_);
+  if (!from._internal_continuation_token().empty()) {
+    _this->_internal_set_continuation_token(from._internal_continuation_token());
+  }
   static_assert(sizeof(uint64_t) == sizeof(double), "Code assumes uint64_t and double are the same size.");
   double tmp_execution_time = from._internal_execution_time();
   uint64_t raw_execution_time;
@@ -1572,6 +2972,15 @@ void SearchReply::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PR
   if (from._internal_total_results() != 0) {
     _this->_internal_set_total_results(from._internal_total_results());
   }
+  if (from._internal_total_is_estimate() != 0) {
+    _this->_internal_set_total_is_estimate(from._internal_total_is_estimate());
+  }
+  if (from._internal_more_chunks() != 0) {
+    _this->_internal_set_more_chunks(from._internal_more_chunks());
+  }
+  if (from._internal_partial() != 0) {
+    _this->_internal_set_partial(from._internal_partial());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -1588,11 +2997,17 @@ bool SearchReply::IsInitialized() const {
 
 void SearchReply::InternalSwap(SearchReply* other) {
   using std::swap;
+  auto* lhs_arena = GetArenaForAllocation();
+  auto* rhs_arena = other->GetArenaForAllocation();
   _internal_metadata_.InternalSwap(&other->_internal_metadata_);
   _impl_.documents_.InternalSwap(&other->_impl_.documents_);
+  ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr::InternalSwap(
+      &_impl_.continuation_token_, lhs_arena,
+      &other->_impl_.continuation_token_, rhs_arena
+  );
   ::PROTOBUF_NAMESPACE_ID::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(SearchReply, _impl_.total_results_)
-      + sizeof(SearchReply::_impl_.total_results_)
+      PROTOBUF_FIELD_OFFSET(SearchReply, _impl_.partial_)
+      + sizeof(SearchReply::_impl_.partial_)
       - PROTOBUF_FIELD_OFFSET(SearchReply, _impl_.execution_time_)>(
           reinterpret_cast<char*>(&_impl_.execution_time_),
           reinterpret_cast<char*>(&other->_impl_.execution_time_));
@@ -1601,7 +3016,192 @@ void SearchReply::InternalSwap(SearchReply* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata SearchReply::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_serverMessages_2eproto_getter, &descriptor_table_serverMessages_2eproto_once,
-      file_level_metadata_serverMessages_2eproto[5]);
+      file_level_metadata_serverMessages_2eproto[8]);
+}
+
+// ===================================================================
+
+class BatchSearchRequest::_Internal {
+ public:
+};
+
+BatchSearchRequest::BatchSearchRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                         bool is_message_owned)
+  : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
+  SharedCtor(arena, is_message_owned);
+  // @@protoc_insertion_point(arena_constructor:BatchSearchRequest)
+}
+BatchSearchRequest::BatchSearchRequest(const BatchSearchRequest& from)
+  : ::PROTOBUF_NAMESPACE_ID::Message() {
+  BatchSearchRequest* const _this = this; (void)_this;
+  new (&_impl_) Impl_{
+      decltype(_impl_.searches_){from._impl_.searches_}
+    , /*decltype(_impl_._cached_size_)*/{}};
+
+  _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+  // @@protoc_insertion_point(copy_constructor:BatchSearchRequest)
+}
+
+inline void BatchSearchRequest::SharedCtor(
+    ::_pb::Arena* arena, bool is_message_owned) {
+  (void)arena;
+  (void)is_message_owned;
+  new (&_impl_) Impl_{
+      decltype(_impl_.searches_){arena}
+    , /*decltype(_impl_._cached_size_)*/{}
+  };
+}
+
+BatchSearchRequest::~BatchSearchRequest() {
+  // @@protoc_insertion_point(destructor:BatchSearchRequest)
+  if (auto *arena = _internal_metadata_.DeleteReturnArena<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>()) {
+  (void)arena;
+    return;
+  }
+  SharedDtor();
+}
+
+inline void BatchSearchRequest::SharedDtor() {
+  GOOGLE_DCHECK(GetArenaForAllocation() == nullptr);
+  _impl_.searches_.~RepeatedPtrField();
+}
+
+void BatchSearchRequest::SetCachedSize(int size) const {
+  _impl_._cached_size_.Set(size);
+}
+
+void BatchSearchRequest::Clear() {
+// @@protoc_insertion_point(message_clear_start:BatchSearchRequest)
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.searches_.Clear();
+  _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
+}
+
+const char* BatchSearchRequest::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
+#define CHK_(x) if (PROTOBUF_PREDICT_FALSE(!(x))) goto failure
+  while (!ctx->Done(&ptr)) {
+    uint32_t tag;
+    ptr = ::_pbi::ReadTag(ptr, &tag);
+    switch (tag >> 3) {
+      // repeated .SearchRequest searches = 1;
+      case 1:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 10)) {
+          ptr -= 1;
+          do {
+            ptr += 1;
+            ptr = ctx->ParseMessage(_internal_add_searches(), ptr);
+            CHK_(ptr);
+            if (!ctx->DataAvailable(ptr)) break;
+          } while (::PROTOBUF_NAMESPACE_ID::internal::ExpectTag<10>(ptr));
+        } else
+          goto handle_unusual;
+        continue;
+      default:
+        goto handle_unusual;
+    }  // switch
+  handle_unusual:
+    if ((tag == 0) || ((tag & 7) == 4)) {
+      CHK_(ptr);
+      ctx->SetLastTag(tag);
+      goto message_done;
+    }
+    ptr = UnknownFieldParse(
+        tag,
+        _internal_metadata_.mutable_unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(),
+        ptr, ctx);
+    CHK_(ptr != nullptr);
+  }  // while
+message_done:
+  return ptr;
+failure:
+  ptr = nullptr;
+  goto message_done;
+#undef CHK_
+}
+
+uint8_t* BatchSearchRequest::_InternalSerialize(
+    uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:BatchSearchRequest)
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  // repeated .SearchRequest searches = 1;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_searches_size()); i < n; i++) {
+    const auto& repfield = this->_internal_searches(i);
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+        InternalWriteMessage(1, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+        _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:BatchSearchRequest)
+  return target;
+}
+
+size_t BatchSearchRequest::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:BatchSearchRequest)
+  size_t total_size = 0;
+
+  uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .SearchRequest searches = 1;
+  total_size += 1UL * this->_internal_searches_size();
+  for (const auto& msg : this->_impl_.searches_) {
+    total_size +=
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(msg);
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData BatchSearchRequest::_class_data_ = {
+    ::PROTOBUF_NAMESPACE_ID::Message::CopyWithSourceCheck,
+    BatchSearchRequest::MergeImpl
+};
+const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*BatchSearchRequest::GetClassData() const { return &_class_data_; }
+
+
+void BatchSearchRequest::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg) {
+  auto* const _this = static_cast<BatchSearchRequest*>(&to_msg);
+  auto& from = static_cast<const BatchSearchRequest&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:BatchSearchRequest)
+  GOOGLE_DCHECK_NE(&from, _this);
+  uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_impl_.searches_.MergeFrom(from._impl_.searches_);
+  _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void BatchSearchRequest::CopyFrom(const BatchSearchRequest& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:BatchSearchRequest)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool BatchSearchRequest::IsInitialized() const {
+  return true;
+}
+
+void BatchSearchRequest::InternalSwap(BatchSearchRequest* other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.searches_.InternalSwap(&other->_impl_.searches_);
+}
+
+::PROTOBUF_NAMESPACE_ID::Metadata BatchSearchRequest::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_serverMessages_2eproto_getter, &descriptor_table_serverMessages_2eproto_once,
+      file_level_metadata_serverMessages_2eproto[9]);
 }
 
 // ===================================================================
@@ -1612,6 +3212,7 @@ class ServerMessage::_Internal {
   static const ::SearchRequest& search_request(const ServerMessage* msg);
   static const ::IndexReply& index_reply(const ServerMessage* msg);
   static const ::SearchReply& search_reply(const ServerMessage* msg);
+  static const ::DeleteRequest& delete_request(const ServerMessage* msg);
 };
 
 const ::IndexRequest&
@@ -1630,6 +3231,10 @@ const ::SearchReply&
 ServerMessage::_Internal::search_reply(const ServerMessage* msg) {
   return *msg->_impl_.search_reply_;
 }
+const ::DeleteRequest&
+ServerMessage::_Internal::delete_request(const ServerMessage* msg) {
+  return *msg->_impl_.delete_request_;
+}
 ServerMessage::ServerMessage(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                          bool is_message_owned)
   : ::PROTOBUF_NAMESPACE_ID::Message(arena, is_message_owned) {
@@ -1644,6 +3249,7 @@ ServerMessage::ServerMessage(const ServerMessage& from)
     , decltype(_impl_.search_request_){nullptr}
     , decltype(_impl_.index_reply_){nullptr}
     , decltype(_impl_.search_reply_){nullptr}
+    , decltype(_impl_.delete_request_){nullptr}
     , decltype(_impl_.type_){}
     , /*decltype(_impl_._cached_size_)*/{}};
 
@@ -1660,6 +3266,9 @@ ServerMessage::ServerMessage(const ServerMessage& from)
   if (from._internal_has_search_reply()) {
     _this->_impl_.search_reply_ = new ::SearchReply(*from._impl_.search_reply_);
   }
+  if (from._internal_has_delete_request()) {
+    _this->_impl_.delete_request_ = new ::DeleteRequest(*from._impl_.delete_request_);
+  }
   _this->_impl_.type_ = from._impl_.type_;
   // @@protoc_insertion_point(copy_constructor:ServerMessage)
 }
@@ -1673,6 +3282,7 @@ inline void ServerMessage::SharedCtor(
     , decltype(_impl_.search_request_){nullptr}
     , decltype(_impl_.index_reply_){nullptr}
     , decltype(_impl_.search_reply_){nullptr}
+    , decltype(_impl_.delete_request_){nullptr}
     , decltype(_impl_.type_){0}
     , /*decltype(_impl_._cached_size_)*/{}
   };
@@ -1693,6 +3303,7 @@ inline void ServerMessage::SharedDtor() {
   if (this != internal_default_instance()) delete _impl_.search_request_;
   if (this != internal_default_instance()) delete _impl_.index_reply_;
   if (this != internal_default_instance()) delete _impl_.search_reply_;
+  if (this != internal_default_instance()) delete _impl_.delete_request_;
 }
 
 void ServerMessage::SetCachedSize(int size) const {
@@ -1721,6 +3332,10 @@ void ServerMessage::Clear() {
     delete _impl_.search_reply_;
   }
   _impl_.search_reply_ = nullptr;
+  if (GetArenaForAllocation() == nullptr && _impl_.delete_request_ != nullptr) {
+    delete _impl_.delete_request_;
+  }
+  _impl_.delete_request_ = nullptr;
   _impl_.type_ = 0;
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
@@ -1772,6 +3387,14 @@ const char* ServerMessage::_InternalParse(const char* ptr, ::_pbi::ParseContext*
         } else
           goto handle_unusual;
         continue;
+      // .DeleteRequest delete_request = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 50)) {
+          ptr = ctx->ParseMessage(_internal_mutable_delete_request(), ptr);
+          CHK_(ptr);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -1836,6 +3459,13 @@ uint8_t* ServerMessage::_InternalSerialize(
         _Internal::search_reply(this).GetCachedSize(), target, stream);
   }
 
+  // .DeleteRequest delete_request = 6;
+  if (this->_internal_has_delete_request()) {
+    target = ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::
+      InternalWriteMessage(6, _Internal::delete_request(this),
+        _Internal::delete_request(this).GetCachedSize(), target, stream);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -1880,6 +3510,13 @@ size_t ServerMessage::ByteSizeLong() const {
         *_impl_.search_reply_);
   }
 
+  // .DeleteRequest delete_request = 6;
+  if (this->_internal_has_delete_request()) {
+    total_size += 1 +
+      ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::MessageSize(
+        *_impl_.delete_request_);
+  }
+
   // .ServerMessage.MessageType type = 1;
   if (this->_internal_type() != 0) {
     total_size += 1 +
@@ -1920,6 +3557,10 @@ void ServerMessage::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::
     _this->_internal_mutable_search_reply()->::SearchReply::MergeFrom(
         from._internal_search_reply());
   }
+  if (from._internal_has_delete_request()) {
+    _this->_internal_mutable_delete_request()->::DeleteRequest::MergeFrom(
+        from._internal_delete_request());
+  }
   if (from._internal_type() != 0) {
     _this->_internal_set_type(from._internal_type());
   }
@@ -1951,7 +3592,7 @@ void ServerMessage::InternalSwap(ServerMessage* other) {
 ::PROTOBUF_NAMESPACE_ID::Metadata ServerMessage::GetMetadata() const {
   return ::_pbi::AssignDescriptors(
       &descriptor_table_serverMessages_2eproto_getter, &descriptor_table_serverMessages_2eproto_once,
-      file_level_metadata_serverMessages_2eproto[6]);
+      file_level_metadata_serverMessages_2eproto[10]);
 }
 
 // @@protoc_insertion_point(namespace_scope)
@@ -1968,6 +3609,18 @@ template<> PROTOBUF_NOINLINE ::IndexReply*
 Arena::CreateMaybeMessage< ::IndexReply >(Arena* arena) {
   return Arena::CreateMessageInternal< ::IndexReply >(arena);
 }
+template<> PROTOBUF_NOINLINE ::DeleteRequest*
+Arena::CreateMaybeMessage< ::DeleteRequest >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::DeleteRequest >(arena);
+}
+template<> PROTOBUF_NOINLINE ::HelloReply*
+Arena::CreateMaybeMessage< ::HelloReply >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::HelloReply >(arena);
+}
+template<> PROTOBUF_NOINLINE ::QueryNode*
+Arena::CreateMaybeMessage< ::QueryNode >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::QueryNode >(arena);
+}
 template<> PROTOBUF_NOINLINE ::SearchRequest*
 Arena::CreateMaybeMessage< ::SearchRequest >(Arena* arena) {
   return Arena::CreateMessageInternal< ::SearchRequest >(arena);
@@ -1980,6 +3633,10 @@ template<> PROTOBUF_NOINLINE ::SearchReply*
 Arena::CreateMaybeMessage< ::SearchReply >(Arena* arena) {
   return Arena::CreateMessageInternal< ::SearchReply >(arena);
 }
+template<> PROTOBUF_NOINLINE ::BatchSearchRequest*
+Arena::CreateMaybeMessage< ::BatchSearchRequest >(Arena* arena) {
+  return Arena::CreateMessageInternal< ::BatchSearchRequest >(arena);
+}
 template<> PROTOBUF_NOINLINE ::ServerMessage*
 Arena::CreateMaybeMessage< ::ServerMessage >(Arena* arena) {
   return Arena::CreateMessageInternal< ::ServerMessage >(arena);
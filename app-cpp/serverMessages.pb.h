@@ -48,6 +48,15 @@ struct TableStruct_serverMessages_2eproto {
   static const uint32_t offsets[];
 };
 extern const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_serverMessages_2eproto;
+class BatchSearchRequest;
+struct BatchSearchRequestDefaultTypeInternal;
+extern BatchSearchRequestDefaultTypeInternal _BatchSearchRequest_default_instance_;
+class DeleteRequest;
+struct DeleteRequestDefaultTypeInternal;
+extern DeleteRequestDefaultTypeInternal _DeleteRequest_default_instance_;
+class HelloReply;
+struct HelloReplyDefaultTypeInternal;
+extern HelloReplyDefaultTypeInternal _HelloReply_default_instance_;
 class IndexReply;
 struct IndexReplyDefaultTypeInternal;
 extern IndexReplyDefaultTypeInternal _IndexReply_default_instance_;
@@ -57,6 +66,9 @@ extern IndexRequestDefaultTypeInternal _IndexRequest_default_instance_;
 class IndexRequest_WordFrequenciesEntry_DoNotUse;
 struct IndexRequest_WordFrequenciesEntry_DoNotUseDefaultTypeInternal;
 extern IndexRequest_WordFrequenciesEntry_DoNotUseDefaultTypeInternal _IndexRequest_WordFrequenciesEntry_DoNotUse_default_instance_;
+class QueryNode;
+struct QueryNodeDefaultTypeInternal;
+extern QueryNodeDefaultTypeInternal _QueryNode_default_instance_;
 class SearchReply;
 struct SearchReplyDefaultTypeInternal;
 extern SearchReplyDefaultTypeInternal _SearchReply_default_instance_;
@@ -70,27 +82,110 @@ class ServerMessage;
 struct ServerMessageDefaultTypeInternal;
 extern ServerMessageDefaultTypeInternal _ServerMessage_default_instance_;
 PROTOBUF_NAMESPACE_OPEN
+template<> ::BatchSearchRequest* Arena::CreateMaybeMessage<::BatchSearchRequest>(Arena*);
+template<> ::DeleteRequest* Arena::CreateMaybeMessage<::DeleteRequest>(Arena*);
+template<> ::HelloReply* Arena::CreateMaybeMessage<::HelloReply>(Arena*);
 template<> ::IndexReply* Arena::CreateMaybeMessage<::IndexReply>(Arena*);
 template<> ::IndexRequest* Arena::CreateMaybeMessage<::IndexRequest>(Arena*);
 template<> ::IndexRequest_WordFrequenciesEntry_DoNotUse* Arena::CreateMaybeMessage<::IndexRequest_WordFrequenciesEntry_DoNotUse>(Arena*);
+template<> ::QueryNode* Arena::CreateMaybeMessage<::QueryNode>(Arena*);
 template<> ::SearchReply* Arena::CreateMaybeMessage<::SearchReply>(Arena*);
 template<> ::SearchReply_Document* Arena::CreateMaybeMessage<::SearchReply_Document>(Arena*);
 template<> ::SearchRequest* Arena::CreateMaybeMessage<::SearchRequest>(Arena*);
 template<> ::ServerMessage* Arena::CreateMaybeMessage<::ServerMessage>(Arena*);
 PROTOBUF_NAMESPACE_CLOSE
 
+enum QueryNode_NodeType : int {
+  QueryNode_NodeType_TERM = 0,
+  QueryNode_NodeType_AND = 1,
+  QueryNode_NodeType_OR = 2,
+  QueryNode_NodeType_NOT = 3,
+  QueryNode_NodeType_QueryNode_NodeType_INT_MIN_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::min(),
+  QueryNode_NodeType_QueryNode_NodeType_INT_MAX_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::max()
+};
+bool QueryNode_NodeType_IsValid(int value);
+constexpr QueryNode_NodeType QueryNode_NodeType_NodeType_MIN = QueryNode_NodeType_TERM;
+constexpr QueryNode_NodeType QueryNode_NodeType_NodeType_MAX = QueryNode_NodeType_NOT;
+constexpr int QueryNode_NodeType_NodeType_ARRAYSIZE = QueryNode_NodeType_NodeType_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* QueryNode_NodeType_descriptor();
+template<typename T>
+inline const std::string& QueryNode_NodeType_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, QueryNode_NodeType>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function QueryNode_NodeType_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    QueryNode_NodeType_descriptor(), enum_t_value);
+}
+inline bool QueryNode_NodeType_Parse(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, QueryNode_NodeType* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<QueryNode_NodeType>(
+    QueryNode_NodeType_descriptor(), name, value);
+}
+enum SearchRequest_Ranking : int {
+  SearchRequest_Ranking_FREQUENCY = 0,
+  SearchRequest_Ranking_BM25 = 1,
+  SearchRequest_Ranking_SearchRequest_Ranking_INT_MIN_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::min(),
+  SearchRequest_Ranking_SearchRequest_Ranking_INT_MAX_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::max()
+};
+bool SearchRequest_Ranking_IsValid(int value);
+constexpr SearchRequest_Ranking SearchRequest_Ranking_Ranking_MIN = SearchRequest_Ranking_FREQUENCY;
+constexpr SearchRequest_Ranking SearchRequest_Ranking_Ranking_MAX = SearchRequest_Ranking_BM25;
+constexpr int SearchRequest_Ranking_Ranking_ARRAYSIZE = SearchRequest_Ranking_Ranking_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* SearchRequest_Ranking_descriptor();
+template<typename T>
+inline const std::string& SearchRequest_Ranking_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, SearchRequest_Ranking>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function SearchRequest_Ranking_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    SearchRequest_Ranking_descriptor(), enum_t_value);
+}
+inline bool SearchRequest_Ranking_Parse(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, SearchRequest_Ranking* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<SearchRequest_Ranking>(
+    SearchRequest_Ranking_descriptor(), name, value);
+}
+enum SearchRequest_Mode : int {
+  SearchRequest_Mode_TOP_K = 0,
+  SearchRequest_Mode_COUNT = 1,
+  SearchRequest_Mode_EXISTS = 2,
+  SearchRequest_Mode_SearchRequest_Mode_INT_MIN_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::min(),
+  SearchRequest_Mode_SearchRequest_Mode_INT_MAX_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::max()
+};
+bool SearchRequest_Mode_IsValid(int value);
+constexpr SearchRequest_Mode SearchRequest_Mode_Mode_MIN = SearchRequest_Mode_TOP_K;
+constexpr SearchRequest_Mode SearchRequest_Mode_Mode_MAX = SearchRequest_Mode_EXISTS;
+constexpr int SearchRequest_Mode_Mode_ARRAYSIZE = SearchRequest_Mode_Mode_MAX + 1;
+
+const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* SearchRequest_Mode_descriptor();
+template<typename T>
+inline const std::string& SearchRequest_Mode_Name(T enum_t_value) {
+  static_assert(::std::is_same<T, SearchRequest_Mode>::value ||
+    ::std::is_integral<T>::value,
+    "Incorrect type passed to function SearchRequest_Mode_Name.");
+  return ::PROTOBUF_NAMESPACE_ID::internal::NameOfEnum(
+    SearchRequest_Mode_descriptor(), enum_t_value);
+}
+inline bool SearchRequest_Mode_Parse(
+    ::PROTOBUF_NAMESPACE_ID::ConstStringParam name, SearchRequest_Mode* value) {
+  return ::PROTOBUF_NAMESPACE_ID::internal::ParseNamedEnum<SearchRequest_Mode>(
+    SearchRequest_Mode_descriptor(), name, value);
+}
 enum ServerMessage_MessageType : int {
   ServerMessage_MessageType_INDEX_REQUEST = 0,
   ServerMessage_MessageType_SEARCH_REQUEST = 1,
   ServerMessage_MessageType_INDEX_REPLY = 2,
   ServerMessage_MessageType_SEARCH_REPLY = 3,
   ServerMessage_MessageType_QUIT = 4,
+  ServerMessage_MessageType_DELETE_REQUEST = 5,
   ServerMessage_MessageType_ServerMessage_MessageType_INT_MIN_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::min(),
   ServerMessage_MessageType_ServerMessage_MessageType_INT_MAX_SENTINEL_DO_NOT_USE_ = std::numeric_limits<int32_t>::max()
 };
 bool ServerMessage_MessageType_IsValid(int value);
 constexpr ServerMessage_MessageType ServerMessage_MessageType_MessageType_MIN = ServerMessage_MessageType_INDEX_REQUEST;
-constexpr ServerMessage_MessageType ServerMessage_MessageType_MessageType_MAX = ServerMessage_MessageType_QUIT;
+constexpr ServerMessage_MessageType ServerMessage_MessageType_MessageType_MAX = ServerMessage_MessageType_DELETE_REQUEST;
 constexpr int ServerMessage_MessageType_MessageType_ARRAYSIZE = ServerMessage_MessageType_MessageType_MAX + 1;
 
 const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor* ServerMessage_MessageType_descriptor();
@@ -262,6 +357,7 @@ class IndexRequest final :
     kWordFrequenciesFieldNumber = 3,
     kClientIdFieldNumber = 1,
     kDocumentPathFieldNumber = 2,
+    kReplaceDocumentNumberFieldNumber = 4,
   };
   // map<string, int32> word_frequencies = 3;
   int word_frequencies_size() const;
@@ -308,6 +404,15 @@ class IndexRequest final :
   std::string* _internal_mutable_document_path();
   public:
 
+  // int64 replace_document_number = 4;
+  void clear_replace_document_number();
+  int64_t replace_document_number() const;
+  void set_replace_document_number(int64_t value);
+  private:
+  int64_t _internal_replace_document_number() const;
+  void _internal_set_replace_document_number(int64_t value);
+  public:
+
   // @@protoc_insertion_point(class_scope:IndexRequest)
  private:
   class _Internal;
@@ -323,6 +428,7 @@ class IndexRequest final :
         ::PROTOBUF_NAMESPACE_ID::internal::WireFormatLite::TYPE_INT32> word_frequencies_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr client_id_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr document_path_;
+    int64_t replace_document_number_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -494,24 +600,24 @@ class IndexReply final :
 };
 // -------------------------------------------------------------------
 
-class SearchRequest final :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:SearchRequest) */ {
+class DeleteRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:DeleteRequest) */ {
  public:
-  inline SearchRequest() : SearchRequest(nullptr) {}
-  ~SearchRequest() override;
-  explicit PROTOBUF_CONSTEXPR SearchRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+  inline DeleteRequest() : DeleteRequest(nullptr) {}
+  ~DeleteRequest() override;
+  explicit PROTOBUF_CONSTEXPR DeleteRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-  SearchRequest(const SearchRequest& from);
-  SearchRequest(SearchRequest&& from) noexcept
-    : SearchRequest() {
+  DeleteRequest(const DeleteRequest& from);
+  DeleteRequest(DeleteRequest&& from) noexcept
+    : DeleteRequest() {
     *this = ::std::move(from);
   }
 
-  inline SearchRequest& operator=(const SearchRequest& from) {
+  inline DeleteRequest& operator=(const DeleteRequest& from) {
     CopyFrom(from);
     return *this;
   }
-  inline SearchRequest& operator=(SearchRequest&& from) noexcept {
+  inline DeleteRequest& operator=(DeleteRequest&& from) noexcept {
     if (this == &from) return *this;
     if (GetOwningArena() == from.GetOwningArena()
   #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -534,20 +640,20 @@ class SearchRequest final :
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const SearchRequest& default_instance() {
+  static const DeleteRequest& default_instance() {
     return *internal_default_instance();
   }
-  static inline const SearchRequest* internal_default_instance() {
-    return reinterpret_cast<const SearchRequest*>(
-               &_SearchRequest_default_instance_);
+  static inline const DeleteRequest* internal_default_instance() {
+    return reinterpret_cast<const DeleteRequest*>(
+               &_DeleteRequest_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
     3;
 
-  friend void swap(SearchRequest& a, SearchRequest& b) {
+  friend void swap(DeleteRequest& a, DeleteRequest& b) {
     a.Swap(&b);
   }
-  inline void Swap(SearchRequest* other) {
+  inline void Swap(DeleteRequest* other) {
     if (other == this) return;
   #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
     if (GetOwningArena() != nullptr &&
@@ -560,7 +666,7 @@ class SearchRequest final :
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
     }
   }
-  void UnsafeArenaSwap(SearchRequest* other) {
+  void UnsafeArenaSwap(DeleteRequest* other) {
     if (other == this) return;
     GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
@@ -568,14 +674,14 @@ class SearchRequest final :
 
   // implements Message ----------------------------------------------
 
-  SearchRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
-    return CreateMaybeMessage<SearchRequest>(arena);
+  DeleteRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<DeleteRequest>(arena);
   }
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
-  void CopyFrom(const SearchRequest& from);
+  void CopyFrom(const DeleteRequest& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom( const SearchRequest& from) {
-    SearchRequest::MergeImpl(*this, from);
+  void MergeFrom( const DeleteRequest& from) {
+    DeleteRequest::MergeImpl(*this, from);
   }
   private:
   static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
@@ -593,15 +699,15 @@ class SearchRequest final :
   void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
-  void InternalSwap(SearchRequest* other);
+  void InternalSwap(DeleteRequest* other);
 
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "SearchRequest";
+    return "DeleteRequest";
   }
   protected:
-  explicit SearchRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+  explicit DeleteRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                        bool is_message_owned = false);
   public:
 
@@ -615,58 +721,31 @@ class SearchRequest final :
   // accessors -------------------------------------------------------
 
   enum : int {
-    kTermsFieldNumber = 1,
-    kLogicalOperatorsFieldNumber = 2,
+    kDocumentNumbersFieldNumber = 1,
   };
-  // repeated string terms = 1;
-  int terms_size() const;
-  private:
-  int _internal_terms_size() const;
-  public:
-  void clear_terms();
-  const std::string& terms(int index) const;
-  std::string* mutable_terms(int index);
-  void set_terms(int index, const std::string& value);
-  void set_terms(int index, std::string&& value);
-  void set_terms(int index, const char* value);
-  void set_terms(int index, const char* value, size_t size);
-  std::string* add_terms();
-  void add_terms(const std::string& value);
-  void add_terms(std::string&& value);
-  void add_terms(const char* value);
-  void add_terms(const char* value, size_t size);
-  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>& terms() const;
-  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>* mutable_terms();
-  private:
-  const std::string& _internal_terms(int index) const;
-  std::string* _internal_add_terms();
-  public:
-
-  // repeated string logical_operators = 2;
-  int logical_operators_size() const;
+  // repeated int64 document_numbers = 1;
+  int document_numbers_size() const;
   private:
-  int _internal_logical_operators_size() const;
+  int _internal_document_numbers_size() const;
   public:
-  void clear_logical_operators();
-  const std::string& logical_operators(int index) const;
-  std::string* mutable_logical_operators(int index);
-  void set_logical_operators(int index, const std::string& value);
-  void set_logical_operators(int index, std::string&& value);
-  void set_logical_operators(int index, const char* value);
-  void set_logical_operators(int index, const char* value, size_t size);
-  std::string* add_logical_operators();
-  void add_logical_operators(const std::string& value);
-  void add_logical_operators(std::string&& value);
-  void add_logical_operators(const char* value);
-  void add_logical_operators(const char* value, size_t size);
-  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>& logical_operators() const;
-  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>* mutable_logical_operators();
+  void clear_document_numbers();
   private:
-  const std::string& _internal_logical_operators(int index) const;
-  std::string* _internal_add_logical_operators();
+  int64_t _internal_document_numbers(int index) const;
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int64_t >&
+      _internal_document_numbers() const;
+  void _internal_add_document_numbers(int64_t value);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< int64_t >*
+      _internal_mutable_document_numbers();
   public:
-
-  // @@protoc_insertion_point(class_scope:SearchRequest)
+  int64_t document_numbers(int index) const;
+  void set_document_numbers(int index, int64_t value);
+  void add_document_numbers(int64_t value);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int64_t >&
+      document_numbers() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedField< int64_t >*
+      mutable_document_numbers();
+
+  // @@protoc_insertion_point(class_scope:DeleteRequest)
  private:
   class _Internal;
 
@@ -674,8 +753,8 @@ class SearchRequest final :
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
-    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string> terms_;
-    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string> logical_operators_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedField< int64_t > document_numbers_;
+    mutable std::atomic<int> _document_numbers_cached_byte_size_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -683,24 +762,24 @@ class SearchRequest final :
 };
 // -------------------------------------------------------------------
 
-class SearchReply_Document final :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:SearchReply.Document) */ {
+class HelloReply final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:HelloReply) */ {
  public:
-  inline SearchReply_Document() : SearchReply_Document(nullptr) {}
-  ~SearchReply_Document() override;
-  explicit PROTOBUF_CONSTEXPR SearchReply_Document(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+  inline HelloReply() : HelloReply(nullptr) {}
+  ~HelloReply() override;
+  explicit PROTOBUF_CONSTEXPR HelloReply(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-  SearchReply_Document(const SearchReply_Document& from);
-  SearchReply_Document(SearchReply_Document&& from) noexcept
-    : SearchReply_Document() {
+  HelloReply(const HelloReply& from);
+  HelloReply(HelloReply&& from) noexcept
+    : HelloReply() {
     *this = ::std::move(from);
   }
 
-  inline SearchReply_Document& operator=(const SearchReply_Document& from) {
+  inline HelloReply& operator=(const HelloReply& from) {
     CopyFrom(from);
     return *this;
   }
-  inline SearchReply_Document& operator=(SearchReply_Document&& from) noexcept {
+  inline HelloReply& operator=(HelloReply&& from) noexcept {
     if (this == &from) return *this;
     if (GetOwningArena() == from.GetOwningArena()
   #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -723,20 +802,20 @@ class SearchReply_Document final :
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const SearchReply_Document& default_instance() {
+  static const HelloReply& default_instance() {
     return *internal_default_instance();
   }
-  static inline const SearchReply_Document* internal_default_instance() {
-    return reinterpret_cast<const SearchReply_Document*>(
-               &_SearchReply_Document_default_instance_);
+  static inline const HelloReply* internal_default_instance() {
+    return reinterpret_cast<const HelloReply*>(
+               &_HelloReply_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
     4;
 
-  friend void swap(SearchReply_Document& a, SearchReply_Document& b) {
+  friend void swap(HelloReply& a, HelloReply& b) {
     a.Swap(&b);
   }
-  inline void Swap(SearchReply_Document* other) {
+  inline void Swap(HelloReply* other) {
     if (other == this) return;
   #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
     if (GetOwningArena() != nullptr &&
@@ -749,7 +828,7 @@ class SearchReply_Document final :
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
     }
   }
-  void UnsafeArenaSwap(SearchReply_Document* other) {
+  void UnsafeArenaSwap(HelloReply* other) {
     if (other == this) return;
     GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
@@ -757,14 +836,14 @@ class SearchReply_Document final :
 
   // implements Message ----------------------------------------------
 
-  SearchReply_Document* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
-    return CreateMaybeMessage<SearchReply_Document>(arena);
+  HelloReply* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<HelloReply>(arena);
   }
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
-  void CopyFrom(const SearchReply_Document& from);
+  void CopyFrom(const HelloReply& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom( const SearchReply_Document& from) {
-    SearchReply_Document::MergeImpl(*this, from);
+  void MergeFrom( const HelloReply& from) {
+    HelloReply::MergeImpl(*this, from);
   }
   private:
   static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
@@ -782,15 +861,15 @@ class SearchReply_Document final :
   void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
-  void InternalSwap(SearchReply_Document* other);
+  void InternalSwap(HelloReply* other);
 
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "SearchReply.Document";
+    return "HelloReply";
   }
   protected:
-  explicit SearchReply_Document(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+  explicit HelloReply(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                        bool is_message_owned = false);
   public:
 
@@ -804,48 +883,38 @@ class SearchReply_Document final :
   // accessors -------------------------------------------------------
 
   enum : int {
-    kDocumentPathFieldNumber = 1,
-    kClientIdFieldNumber = 3,
-    kFrequencyFieldNumber = 2,
+    kServerIdFieldNumber = 1,
+    kClientNameFieldNumber = 2,
   };
-  // string document_path = 1;
-  void clear_document_path();
-  const std::string& document_path() const;
+  // string server_id = 1;
+  void clear_server_id();
+  const std::string& server_id() const;
   template <typename ArgT0 = const std::string&, typename... ArgT>
-  void set_document_path(ArgT0&& arg0, ArgT... args);
-  std::string* mutable_document_path();
-  PROTOBUF_NODISCARD std::string* release_document_path();
-  void set_allocated_document_path(std::string* document_path);
+  void set_server_id(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_server_id();
+  PROTOBUF_NODISCARD std::string* release_server_id();
+  void set_allocated_server_id(std::string* server_id);
   private:
-  const std::string& _internal_document_path() const;
-  inline PROTOBUF_ALWAYS_INLINE void _internal_set_document_path(const std::string& value);
-  std::string* _internal_mutable_document_path();
+  const std::string& _internal_server_id() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_server_id(const std::string& value);
+  std::string* _internal_mutable_server_id();
   public:
 
-  // string client_id = 3;
-  void clear_client_id();
-  const std::string& client_id() const;
+  // string client_name = 2;
+  void clear_client_name();
+  const std::string& client_name() const;
   template <typename ArgT0 = const std::string&, typename... ArgT>
-  void set_client_id(ArgT0&& arg0, ArgT... args);
-  std::string* mutable_client_id();
-  PROTOBUF_NODISCARD std::string* release_client_id();
-  void set_allocated_client_id(std::string* client_id);
-  private:
-  const std::string& _internal_client_id() const;
-  inline PROTOBUF_ALWAYS_INLINE void _internal_set_client_id(const std::string& value);
-  std::string* _internal_mutable_client_id();
-  public:
-
-  // int32 frequency = 2;
-  void clear_frequency();
-  int32_t frequency() const;
-  void set_frequency(int32_t value);
+  void set_client_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_client_name();
+  PROTOBUF_NODISCARD std::string* release_client_name();
+  void set_allocated_client_name(std::string* client_name);
   private:
-  int32_t _internal_frequency() const;
-  void _internal_set_frequency(int32_t value);
+  const std::string& _internal_client_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_client_name(const std::string& value);
+  std::string* _internal_mutable_client_name();
   public:
 
-  // @@protoc_insertion_point(class_scope:SearchReply.Document)
+  // @@protoc_insertion_point(class_scope:HelloReply)
  private:
   class _Internal;
 
@@ -853,9 +922,8 @@ class SearchReply_Document final :
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
-    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr document_path_;
-    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr client_id_;
-    int32_t frequency_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr server_id_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr client_name_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -863,24 +931,24 @@ class SearchReply_Document final :
 };
 // -------------------------------------------------------------------
 
-class SearchReply final :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:SearchReply) */ {
+class QueryNode final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:QueryNode) */ {
  public:
-  inline SearchReply() : SearchReply(nullptr) {}
-  ~SearchReply() override;
-  explicit PROTOBUF_CONSTEXPR SearchReply(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+  inline QueryNode() : QueryNode(nullptr) {}
+  ~QueryNode() override;
+  explicit PROTOBUF_CONSTEXPR QueryNode(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-  SearchReply(const SearchReply& from);
-  SearchReply(SearchReply&& from) noexcept
-    : SearchReply() {
+  QueryNode(const QueryNode& from);
+  QueryNode(QueryNode&& from) noexcept
+    : QueryNode() {
     *this = ::std::move(from);
   }
 
-  inline SearchReply& operator=(const SearchReply& from) {
+  inline QueryNode& operator=(const QueryNode& from) {
     CopyFrom(from);
     return *this;
   }
-  inline SearchReply& operator=(SearchReply&& from) noexcept {
+  inline QueryNode& operator=(QueryNode&& from) noexcept {
     if (this == &from) return *this;
     if (GetOwningArena() == from.GetOwningArena()
   #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -903,20 +971,20 @@ class SearchReply final :
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const SearchReply& default_instance() {
+  static const QueryNode& default_instance() {
     return *internal_default_instance();
   }
-  static inline const SearchReply* internal_default_instance() {
-    return reinterpret_cast<const SearchReply*>(
-               &_SearchReply_default_instance_);
+  static inline const QueryNode* internal_default_instance() {
+    return reinterpret_cast<const QueryNode*>(
+               &_QueryNode_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
     5;
 
-  friend void swap(SearchReply& a, SearchReply& b) {
+  friend void swap(QueryNode& a, QueryNode& b) {
     a.Swap(&b);
   }
-  inline void Swap(SearchReply* other) {
+  inline void Swap(QueryNode* other) {
     if (other == this) return;
   #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
     if (GetOwningArena() != nullptr &&
@@ -929,7 +997,7 @@ class SearchReply final :
       ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
     }
   }
-  void UnsafeArenaSwap(SearchReply* other) {
+  void UnsafeArenaSwap(QueryNode* other) {
     if (other == this) return;
     GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
     InternalSwap(other);
@@ -937,14 +1005,14 @@ class SearchReply final :
 
   // implements Message ----------------------------------------------
 
-  SearchReply* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
-    return CreateMaybeMessage<SearchReply>(arena);
+  QueryNode* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<QueryNode>(arena);
   }
   using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
-  void CopyFrom(const SearchReply& from);
+  void CopyFrom(const QueryNode& from);
   using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
-  void MergeFrom( const SearchReply& from) {
-    SearchReply::MergeImpl(*this, from);
+  void MergeFrom( const QueryNode& from) {
+    QueryNode::MergeImpl(*this, from);
   }
   private:
   static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
@@ -962,15 +1030,15 @@ class SearchReply final :
   void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
   void SharedDtor();
   void SetCachedSize(int size) const final;
-  void InternalSwap(SearchReply* other);
+  void InternalSwap(QueryNode* other);
 
   private:
   friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
   static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
-    return "SearchReply";
+    return "QueryNode";
   }
   protected:
-  explicit SearchReply(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+  explicit QueryNode(::PROTOBUF_NAMESPACE_ID::Arena* arena,
                        bool is_message_owned = false);
   public:
 
@@ -981,52 +1049,99 @@ class SearchReply final :
 
   // nested types ----------------------------------------------------
 
-  typedef SearchReply_Document Document;
+  typedef QueryNode_NodeType NodeType;
+  static constexpr NodeType TERM =
+    QueryNode_NodeType_TERM;
+  static constexpr NodeType AND =
+    QueryNode_NodeType_AND;
+  static constexpr NodeType OR =
+    QueryNode_NodeType_OR;
+  static constexpr NodeType NOT =
+    QueryNode_NodeType_NOT;
+  static inline bool NodeType_IsValid(int value) {
+    return QueryNode_NodeType_IsValid(value);
+  }
+  static constexpr NodeType NodeType_MIN =
+    QueryNode_NodeType_NodeType_MIN;
+  static constexpr NodeType NodeType_MAX =
+    QueryNode_NodeType_NodeType_MAX;
+  static constexpr int NodeType_ARRAYSIZE =
+    QueryNode_NodeType_NodeType_ARRAYSIZE;
+  static inline const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor*
+  NodeType_descriptor() {
+    return QueryNode_NodeType_descriptor();
+  }
+  template<typename T>
+  static inline const std::string& NodeType_Name(T enum_t_value) {
+    static_assert(::std::is_same<T, NodeType>::value ||
+      ::std::is_integral<T>::value,
+      "Incorrect type passed to function NodeType_Name.");
+    return QueryNode_NodeType_Name(enum_t_value);
+  }
+  static inline bool NodeType_Parse(::PROTOBUF_NAMESPACE_ID::ConstStringParam name,
+      NodeType* value) {
+    return QueryNode_NodeType_Parse(name, value);
+  }
 
   // accessors -------------------------------------------------------
 
   enum : int {
-    kDocumentsFieldNumber = 1,
-    kExecutionTimeFieldNumber = 3,
-    kTotalResultsFieldNumber = 2,
+    kChildrenFieldNumber = 3,
+    kTermFieldNumber = 2,
+    kTypeFieldNumber = 1,
+    kMinimumShouldMatchFieldNumber = 4,
   };
-  // repeated .SearchReply.Document documents = 1;
-  int documents_size() const;
+  // repeated .QueryNode children = 3;
+  int children_size() const;
   private:
-  int _internal_documents_size() const;
+  int _internal_children_size() const;
   public:
-  void clear_documents();
-  ::SearchReply_Document* mutable_documents(int index);
-  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::SearchReply_Document >*
-      mutable_documents();
+  void clear_children();
+  ::QueryNode* mutable_children(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::QueryNode >*
+      mutable_children();
   private:
-  const ::SearchReply_Document& _internal_documents(int index) const;
-  ::SearchReply_Document* _internal_add_documents();
+  const ::QueryNode& _internal_children(int index) const;
+  ::QueryNode* _internal_add_children();
+  public:
+  const ::QueryNode& children(int index) const;
+  ::QueryNode* add_children();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::QueryNode >&
+      children() const;
+
+  // string term = 2;
+  void clear_term();
+  const std::string& term() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_term(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_term();
+  PROTOBUF_NODISCARD std::string* release_term();
+  void set_allocated_term(std::string* term);
+  private:
+  const std::string& _internal_term() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_term(const std::string& value);
+  std::string* _internal_mutable_term();
   public:
-  const ::SearchReply_Document& documents(int index) const;
-  ::SearchReply_Document* add_documents();
-  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::SearchReply_Document >&
-      documents() const;
 
-  // double execution_time = 3;
-  void clear_execution_time();
-  double execution_time() const;
-  void set_execution_time(double value);
+  // .QueryNode.NodeType type = 1;
+  void clear_type();
+  ::QueryNode_NodeType type() const;
+  void set_type(::QueryNode_NodeType value);
   private:
-  double _internal_execution_time() const;
-  void _internal_set_execution_time(double value);
+  ::QueryNode_NodeType _internal_type() const;
+  void _internal_set_type(::QueryNode_NodeType value);
   public:
 
-  // int32 total_results = 2;
-  void clear_total_results();
-  int32_t total_results() const;
-  void set_total_results(int32_t value);
+  // int32 minimum_should_match = 4;
+  void clear_minimum_should_match();
+  int32_t minimum_should_match() const;
+  void set_minimum_should_match(int32_t value);
   private:
-  int32_t _internal_total_results() const;
-  void _internal_set_total_results(int32_t value);
+  int32_t _internal_minimum_should_match() const;
+  void _internal_set_minimum_should_match(int32_t value);
   public:
 
-  // @@protoc_insertion_point(class_scope:SearchReply)
+  // @@protoc_insertion_point(class_scope:QueryNode)
  private:
   class _Internal;
 
@@ -1034,9 +1149,10 @@ class SearchReply final :
   typedef void InternalArenaConstructable_;
   typedef void DestructorSkippable_;
   struct Impl_ {
-    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::SearchReply_Document > documents_;
-    double execution_time_;
-    int32_t total_results_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::QueryNode > children_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr term_;
+    int type_;
+    int32_t minimum_should_match_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
   union { Impl_ _impl_; };
@@ -1044,24 +1160,24 @@ class SearchReply final :
 };
 // -------------------------------------------------------------------
 
-class ServerMessage final :
-    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:ServerMessage) */ {
+class SearchRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:SearchRequest) */ {
  public:
-  inline ServerMessage() : ServerMessage(nullptr) {}
-  ~ServerMessage() override;
-  explicit PROTOBUF_CONSTEXPR ServerMessage(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+  inline SearchRequest() : SearchRequest(nullptr) {}
+  ~SearchRequest() override;
+  explicit PROTOBUF_CONSTEXPR SearchRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
 
-  ServerMessage(const ServerMessage& from);
-  ServerMessage(ServerMessage&& from) noexcept
-    : ServerMessage() {
+  SearchRequest(const SearchRequest& from);
+  SearchRequest(SearchRequest&& from) noexcept
+    : SearchRequest() {
     *this = ::std::move(from);
   }
 
-  inline ServerMessage& operator=(const ServerMessage& from) {
+  inline SearchRequest& operator=(const SearchRequest& from) {
     CopyFrom(from);
     return *this;
   }
-  inline ServerMessage& operator=(ServerMessage&& from) noexcept {
+  inline SearchRequest& operator=(SearchRequest&& from) noexcept {
     if (this == &from) return *this;
     if (GetOwningArena() == from.GetOwningArena()
   #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
@@ -1084,17 +1200,948 @@ class ServerMessage final :
   static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
     return default_instance().GetMetadata().reflection;
   }
-  static const ServerMessage& default_instance() {
+  static const SearchRequest& default_instance() {
     return *internal_default_instance();
   }
-  static inline const ServerMessage* internal_default_instance() {
-    return reinterpret_cast<const ServerMessage*>(
-               &_ServerMessage_default_instance_);
+  static inline const SearchRequest* internal_default_instance() {
+    return reinterpret_cast<const SearchRequest*>(
+               &_SearchRequest_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
     6;
 
-  friend void swap(ServerMessage& a, ServerMessage& b) {
+  friend void swap(SearchRequest& a, SearchRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(SearchRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(SearchRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  SearchRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<SearchRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const SearchRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const SearchRequest& from) {
+    SearchRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(SearchRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "SearchRequest";
+  }
+  protected:
+  explicit SearchRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  typedef SearchRequest_Ranking Ranking;
+  static constexpr Ranking FREQUENCY =
+    SearchRequest_Ranking_FREQUENCY;
+  static constexpr Ranking BM25 =
+    SearchRequest_Ranking_BM25;
+  static inline bool Ranking_IsValid(int value) {
+    return SearchRequest_Ranking_IsValid(value);
+  }
+  static constexpr Ranking Ranking_MIN =
+    SearchRequest_Ranking_Ranking_MIN;
+  static constexpr Ranking Ranking_MAX =
+    SearchRequest_Ranking_Ranking_MAX;
+  static constexpr int Ranking_ARRAYSIZE =
+    SearchRequest_Ranking_Ranking_ARRAYSIZE;
+  static inline const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor*
+  Ranking_descriptor() {
+    return SearchRequest_Ranking_descriptor();
+  }
+  template<typename T>
+  static inline const std::string& Ranking_Name(T enum_t_value) {
+    static_assert(::std::is_same<T, Ranking>::value ||
+      ::std::is_integral<T>::value,
+      "Incorrect type passed to function Ranking_Name.");
+    return SearchRequest_Ranking_Name(enum_t_value);
+  }
+  static inline bool Ranking_Parse(::PROTOBUF_NAMESPACE_ID::ConstStringParam name,
+      Ranking* value) {
+    return SearchRequest_Ranking_Parse(name, value);
+  }
+
+  typedef SearchRequest_Mode Mode;
+  static constexpr Mode TOP_K =
+    SearchRequest_Mode_TOP_K;
+  static constexpr Mode COUNT =
+    SearchRequest_Mode_COUNT;
+  static constexpr Mode EXISTS =
+    SearchRequest_Mode_EXISTS;
+  static inline bool Mode_IsValid(int value) {
+    return SearchRequest_Mode_IsValid(value);
+  }
+  static constexpr Mode Mode_MIN =
+    SearchRequest_Mode_Mode_MIN;
+  static constexpr Mode Mode_MAX =
+    SearchRequest_Mode_Mode_MAX;
+  static constexpr int Mode_ARRAYSIZE =
+    SearchRequest_Mode_Mode_ARRAYSIZE;
+  static inline const ::PROTOBUF_NAMESPACE_ID::EnumDescriptor*
+  Mode_descriptor() {
+    return SearchRequest_Mode_descriptor();
+  }
+  template<typename T>
+  static inline const std::string& Mode_Name(T enum_t_value) {
+    static_assert(::std::is_same<T, Mode>::value ||
+      ::std::is_integral<T>::value,
+      "Incorrect type passed to function Mode_Name.");
+    return SearchRequest_Mode_Name(enum_t_value);
+  }
+  static inline bool Mode_Parse(::PROTOBUF_NAMESPACE_ID::ConstStringParam name,
+      Mode* value) {
+    return SearchRequest_Mode_Parse(name, value);
+  }
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kTermsFieldNumber = 1,
+    kLogicalOperatorsFieldNumber = 2,
+    kContinuationTokenFieldNumber = 7,
+    kQueryFieldNumber = 5,
+    kKFieldNumber = 3,
+    kRankingFieldNumber = 4,
+    kOffsetFieldNumber = 6,
+    kChunkSizeFieldNumber = 8,
+    kModeFieldNumber = 9,
+    kTimeBudgetMsFieldNumber = 10,
+  };
+  // repeated string terms = 1;
+  int terms_size() const;
+  private:
+  int _internal_terms_size() const;
+  public:
+  void clear_terms();
+  const std::string& terms(int index) const;
+  std::string* mutable_terms(int index);
+  void set_terms(int index, const std::string& value);
+  void set_terms(int index, std::string&& value);
+  void set_terms(int index, const char* value);
+  void set_terms(int index, const char* value, size_t size);
+  std::string* add_terms();
+  void add_terms(const std::string& value);
+  void add_terms(std::string&& value);
+  void add_terms(const char* value);
+  void add_terms(const char* value, size_t size);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>& terms() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>* mutable_terms();
+  private:
+  const std::string& _internal_terms(int index) const;
+  std::string* _internal_add_terms();
+  public:
+
+  // repeated string logical_operators = 2;
+  int logical_operators_size() const;
+  private:
+  int _internal_logical_operators_size() const;
+  public:
+  void clear_logical_operators();
+  const std::string& logical_operators(int index) const;
+  std::string* mutable_logical_operators(int index);
+  void set_logical_operators(int index, const std::string& value);
+  void set_logical_operators(int index, std::string&& value);
+  void set_logical_operators(int index, const char* value);
+  void set_logical_operators(int index, const char* value, size_t size);
+  std::string* add_logical_operators();
+  void add_logical_operators(const std::string& value);
+  void add_logical_operators(std::string&& value);
+  void add_logical_operators(const char* value);
+  void add_logical_operators(const char* value, size_t size);
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>& logical_operators() const;
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string>* mutable_logical_operators();
+  private:
+  const std::string& _internal_logical_operators(int index) const;
+  std::string* _internal_add_logical_operators();
+  public:
+
+  // string continuation_token = 7;
+  void clear_continuation_token();
+  const std::string& continuation_token() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_continuation_token(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_continuation_token();
+  PROTOBUF_NODISCARD std::string* release_continuation_token();
+  void set_allocated_continuation_token(std::string* continuation_token);
+  private:
+  const std::string& _internal_continuation_token() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_continuation_token(const std::string& value);
+  std::string* _internal_mutable_continuation_token();
+  public:
+
+  // .QueryNode query = 5;
+  bool has_query() const;
+  private:
+  bool _internal_has_query() const;
+  public:
+  void clear_query();
+  const ::QueryNode& query() const;
+  PROTOBUF_NODISCARD ::QueryNode* release_query();
+  ::QueryNode* mutable_query();
+  void set_allocated_query(::QueryNode* query);
+  private:
+  const ::QueryNode& _internal_query() const;
+  ::QueryNode* _internal_mutable_query();
+  public:
+  void unsafe_arena_set_allocated_query(
+      ::QueryNode* query);
+  ::QueryNode* unsafe_arena_release_query();
+
+  // int32 k = 3;
+  void clear_k();
+  int32_t k() const;
+  void set_k(int32_t value);
+  private:
+  int32_t _internal_k() const;
+  void _internal_set_k(int32_t value);
+  public:
+
+  // .SearchRequest.Ranking ranking = 4;
+  void clear_ranking();
+  ::SearchRequest_Ranking ranking() const;
+  void set_ranking(::SearchRequest_Ranking value);
+  private:
+  ::SearchRequest_Ranking _internal_ranking() const;
+  void _internal_set_ranking(::SearchRequest_Ranking value);
+  public:
+
+  // int32 offset = 6;
+  void clear_offset();
+  int32_t offset() const;
+  void set_offset(int32_t value);
+  private:
+  int32_t _internal_offset() const;
+  void _internal_set_offset(int32_t value);
+  public:
+
+  // int32 chunk_size = 8;
+  void clear_chunk_size();
+  int32_t chunk_size() const;
+  void set_chunk_size(int32_t value);
+  private:
+  int32_t _internal_chunk_size() const;
+  void _internal_set_chunk_size(int32_t value);
+  public:
+
+  // .SearchRequest.Mode mode = 9;
+  void clear_mode();
+  ::SearchRequest_Mode mode() const;
+  void set_mode(::SearchRequest_Mode value);
+  private:
+  ::SearchRequest_Mode _internal_mode() const;
+  void _internal_set_mode(::SearchRequest_Mode value);
+  public:
+
+  // int32 time_budget_ms = 10;
+  void clear_time_budget_ms();
+  int32_t time_budget_ms() const;
+  void set_time_budget_ms(int32_t value);
+  private:
+  int32_t _internal_time_budget_ms() const;
+  void _internal_set_time_budget_ms(int32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:SearchRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string> terms_;
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField<std::string> logical_operators_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr continuation_token_;
+    ::QueryNode* query_;
+    int32_t k_;
+    int ranking_;
+    int32_t offset_;
+    int32_t chunk_size_;
+    int mode_;
+    int32_t time_budget_ms_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_serverMessages_2eproto;
+};
+// -------------------------------------------------------------------
+
+class SearchReply_Document final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:SearchReply.Document) */ {
+ public:
+  inline SearchReply_Document() : SearchReply_Document(nullptr) {}
+  ~SearchReply_Document() override;
+  explicit PROTOBUF_CONSTEXPR SearchReply_Document(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  SearchReply_Document(const SearchReply_Document& from);
+  SearchReply_Document(SearchReply_Document&& from) noexcept
+    : SearchReply_Document() {
+    *this = ::std::move(from);
+  }
+
+  inline SearchReply_Document& operator=(const SearchReply_Document& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline SearchReply_Document& operator=(SearchReply_Document&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const SearchReply_Document& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const SearchReply_Document* internal_default_instance() {
+    return reinterpret_cast<const SearchReply_Document*>(
+               &_SearchReply_Document_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    7;
+
+  friend void swap(SearchReply_Document& a, SearchReply_Document& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(SearchReply_Document* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(SearchReply_Document* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  SearchReply_Document* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<SearchReply_Document>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const SearchReply_Document& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const SearchReply_Document& from) {
+    SearchReply_Document::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(SearchReply_Document* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "SearchReply.Document";
+  }
+  protected:
+  explicit SearchReply_Document(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kDocumentPathFieldNumber = 1,
+    kClientIdFieldNumber = 3,
+    kScoreFieldNumber = 4,
+    kFrequencyFieldNumber = 2,
+  };
+  // string document_path = 1;
+  void clear_document_path();
+  const std::string& document_path() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_document_path(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_document_path();
+  PROTOBUF_NODISCARD std::string* release_document_path();
+  void set_allocated_document_path(std::string* document_path);
+  private:
+  const std::string& _internal_document_path() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_document_path(const std::string& value);
+  std::string* _internal_mutable_document_path();
+  public:
+
+  // string client_id = 3;
+  void clear_client_id();
+  const std::string& client_id() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_client_id(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_client_id();
+  PROTOBUF_NODISCARD std::string* release_client_id();
+  void set_allocated_client_id(std::string* client_id);
+  private:
+  const std::string& _internal_client_id() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_client_id(const std::string& value);
+  std::string* _internal_mutable_client_id();
+  public:
+
+  // double score = 4;
+  void clear_score();
+  double score() const;
+  void set_score(double value);
+  private:
+  double _internal_score() const;
+  void _internal_set_score(double value);
+  public:
+
+  // int32 frequency = 2;
+  void clear_frequency();
+  int32_t frequency() const;
+  void set_frequency(int32_t value);
+  private:
+  int32_t _internal_frequency() const;
+  void _internal_set_frequency(int32_t value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:SearchReply.Document)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr document_path_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr client_id_;
+    double score_;
+    int32_t frequency_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_serverMessages_2eproto;
+};
+// -------------------------------------------------------------------
+
+class SearchReply final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:SearchReply) */ {
+ public:
+  inline SearchReply() : SearchReply(nullptr) {}
+  ~SearchReply() override;
+  explicit PROTOBUF_CONSTEXPR SearchReply(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  SearchReply(const SearchReply& from);
+  SearchReply(SearchReply&& from) noexcept
+    : SearchReply() {
+    *this = ::std::move(from);
+  }
+
+  inline SearchReply& operator=(const SearchReply& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline SearchReply& operator=(SearchReply&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const SearchReply& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const SearchReply* internal_default_instance() {
+    return reinterpret_cast<const SearchReply*>(
+               &_SearchReply_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    8;
+
+  friend void swap(SearchReply& a, SearchReply& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(SearchReply* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(SearchReply* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  SearchReply* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<SearchReply>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const SearchReply& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const SearchReply& from) {
+    SearchReply::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(SearchReply* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "SearchReply";
+  }
+  protected:
+  explicit SearchReply(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  typedef SearchReply_Document Document;
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kDocumentsFieldNumber = 1,
+    kContinuationTokenFieldNumber = 6,
+    kExecutionTimeFieldNumber = 3,
+    kTotalResultsFieldNumber = 2,
+    kTotalIsEstimateFieldNumber = 5,
+    kMoreChunksFieldNumber = 7,
+    kPartialFieldNumber = 8,
+  };
+  // repeated .SearchReply.Document documents = 1;
+  int documents_size() const;
+  private:
+  int _internal_documents_size() const;
+  public:
+  void clear_documents();
+  ::SearchReply_Document* mutable_documents(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::SearchReply_Document >*
+      mutable_documents();
+  private:
+  const ::SearchReply_Document& _internal_documents(int index) const;
+  ::SearchReply_Document* _internal_add_documents();
+  public:
+  const ::SearchReply_Document& documents(int index) const;
+  ::SearchReply_Document* add_documents();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::SearchReply_Document >&
+      documents() const;
+
+  // string continuation_token = 6;
+  void clear_continuation_token();
+  const std::string& continuation_token() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_continuation_token(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_continuation_token();
+  PROTOBUF_NODISCARD std::string* release_continuation_token();
+  void set_allocated_continuation_token(std::string* continuation_token);
+  private:
+  const std::string& _internal_continuation_token() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_continuation_token(const std::string& value);
+  std::string* _internal_mutable_continuation_token();
+  public:
+
+  // double execution_time = 3;
+  void clear_execution_time();
+  double execution_time() const;
+  void set_execution_time(double value);
+  private:
+  double _internal_execution_time() const;
+  void _internal_set_execution_time(double value);
+  public:
+
+  // int32 total_results = 2;
+  void clear_total_results();
+  int32_t total_results() const;
+  void set_total_results(int32_t value);
+  private:
+  int32_t _internal_total_results() const;
+  void _internal_set_total_results(int32_t value);
+  public:
+
+  // bool total_is_estimate = 5;
+  void clear_total_is_estimate();
+  bool total_is_estimate() const;
+  void set_total_is_estimate(bool value);
+  private:
+  bool _internal_total_is_estimate() const;
+  void _internal_set_total_is_estimate(bool value);
+  public:
+
+  // bool more_chunks = 7;
+  void clear_more_chunks();
+  bool more_chunks() const;
+  void set_more_chunks(bool value);
+  private:
+  bool _internal_more_chunks() const;
+  void _internal_set_more_chunks(bool value);
+  public:
+
+  // bool partial = 8;
+  void clear_partial();
+  bool partial() const;
+  void set_partial(bool value);
+  private:
+  bool _internal_partial() const;
+  void _internal_set_partial(bool value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:SearchReply)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::SearchReply_Document > documents_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr continuation_token_;
+    double execution_time_;
+    int32_t total_results_;
+    bool total_is_estimate_;
+    bool more_chunks_;
+    bool partial_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_serverMessages_2eproto;
+};
+// -------------------------------------------------------------------
+
+class BatchSearchRequest final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:BatchSearchRequest) */ {
+ public:
+  inline BatchSearchRequest() : BatchSearchRequest(nullptr) {}
+  ~BatchSearchRequest() override;
+  explicit PROTOBUF_CONSTEXPR BatchSearchRequest(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  BatchSearchRequest(const BatchSearchRequest& from);
+  BatchSearchRequest(BatchSearchRequest&& from) noexcept
+    : BatchSearchRequest() {
+    *this = ::std::move(from);
+  }
+
+  inline BatchSearchRequest& operator=(const BatchSearchRequest& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline BatchSearchRequest& operator=(BatchSearchRequest&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const BatchSearchRequest& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const BatchSearchRequest* internal_default_instance() {
+    return reinterpret_cast<const BatchSearchRequest*>(
+               &_BatchSearchRequest_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    9;
+
+  friend void swap(BatchSearchRequest& a, BatchSearchRequest& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(BatchSearchRequest* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(BatchSearchRequest* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  BatchSearchRequest* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<BatchSearchRequest>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const BatchSearchRequest& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const BatchSearchRequest& from) {
+    BatchSearchRequest::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(BatchSearchRequest* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "BatchSearchRequest";
+  }
+  protected:
+  explicit BatchSearchRequest(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kSearchesFieldNumber = 1,
+  };
+  // repeated .SearchRequest searches = 1;
+  int searches_size() const;
+  private:
+  int _internal_searches_size() const;
+  public:
+  void clear_searches();
+  ::SearchRequest* mutable_searches(int index);
+  ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::SearchRequest >*
+      mutable_searches();
+  private:
+  const ::SearchRequest& _internal_searches(int index) const;
+  ::SearchRequest* _internal_add_searches();
+  public:
+  const ::SearchRequest& searches(int index) const;
+  ::SearchRequest* add_searches();
+  const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::SearchRequest >&
+      searches() const;
+
+  // @@protoc_insertion_point(class_scope:BatchSearchRequest)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::SearchRequest > searches_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_serverMessages_2eproto;
+};
+// -------------------------------------------------------------------
+
+class ServerMessage final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:ServerMessage) */ {
+ public:
+  inline ServerMessage() : ServerMessage(nullptr) {}
+  ~ServerMessage() override;
+  explicit PROTOBUF_CONSTEXPR ServerMessage(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  ServerMessage(const ServerMessage& from);
+  ServerMessage(ServerMessage&& from) noexcept
+    : ServerMessage() {
+    *this = ::std::move(from);
+  }
+
+  inline ServerMessage& operator=(const ServerMessage& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline ServerMessage& operator=(ServerMessage&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const ServerMessage& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const ServerMessage* internal_default_instance() {
+    return reinterpret_cast<const ServerMessage*>(
+               &_ServerMessage_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    10;
+
+  friend void swap(ServerMessage& a, ServerMessage& b) {
     a.Swap(&b);
   }
   inline void Swap(ServerMessage* other) {
@@ -1173,6 +2220,8 @@ class ServerMessage final :
     ServerMessage_MessageType_SEARCH_REPLY;
   static constexpr MessageType QUIT =
     ServerMessage_MessageType_QUIT;
+  static constexpr MessageType DELETE_REQUEST =
+    ServerMessage_MessageType_DELETE_REQUEST;
   static inline bool MessageType_IsValid(int value) {
     return ServerMessage_MessageType_IsValid(value);
   }
@@ -1205,6 +2254,7 @@ class ServerMessage final :
     kSearchRequestFieldNumber = 3,
     kIndexReplyFieldNumber = 4,
     kSearchReplyFieldNumber = 5,
+    kDeleteRequestFieldNumber = 6,
     kTypeFieldNumber = 1,
   };
   // .IndexRequest index_request = 2;
@@ -1279,6 +2329,24 @@ class ServerMessage final :
       ::SearchReply* search_reply);
   ::SearchReply* unsafe_arena_release_search_reply();
 
+  // .DeleteRequest delete_request = 6;
+  bool has_delete_request() const;
+  private:
+  bool _internal_has_delete_request() const;
+  public:
+  void clear_delete_request();
+  const ::DeleteRequest& delete_request() const;
+  PROTOBUF_NODISCARD ::DeleteRequest* release_delete_request();
+  ::DeleteRequest* mutable_delete_request();
+  void set_allocated_delete_request(::DeleteRequest* delete_request);
+  private:
+  const ::DeleteRequest& _internal_delete_request() const;
+  ::DeleteRequest* _internal_mutable_delete_request();
+  public:
+  void unsafe_arena_set_allocated_delete_request(
+      ::DeleteRequest* delete_request);
+  ::DeleteRequest* unsafe_arena_release_delete_request();
+
   // .ServerMessage.MessageType type = 1;
   void clear_type();
   ::ServerMessage_MessageType type() const;
@@ -1300,6 +2368,7 @@ class ServerMessage final :
     ::SearchRequest* search_request_;
     ::IndexReply* index_reply_;
     ::SearchReply* search_reply_;
+    ::DeleteRequest* delete_request_;
     int type_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
   };
@@ -1448,6 +2517,26 @@ IndexRequest::mutable_word_frequencies() {
   return _internal_mutable_word_frequencies();
 }
 
+// int64 replace_document_number = 4;
+inline void IndexRequest::clear_replace_document_number() {
+  _impl_.replace_document_number_ = int64_t{0};
+}
+inline int64_t IndexRequest::_internal_replace_document_number() const {
+  return _impl_.replace_document_number_;
+}
+inline int64_t IndexRequest::replace_document_number() const {
+  // @@protoc_insertion_point(field_get:IndexRequest.replace_document_number)
+  return _internal_replace_document_number();
+}
+inline void IndexRequest::_internal_set_replace_document_number(int64_t value) {
+  
+  _impl_.replace_document_number_ = value;
+}
+inline void IndexRequest::set_replace_document_number(int64_t value) {
+  _internal_set_replace_document_number(value);
+  // @@protoc_insertion_point(field_set:IndexRequest.replace_document_number)
+}
+
 // -------------------------------------------------------------------
 
 // IndexReply
@@ -1502,24 +2591,313 @@ inline void IndexReply::set_allocated_status(std::string* status) {
   // @@protoc_insertion_point(field_set_allocated:IndexReply.status)
 }
 
-// int64 document_number = 2;
-inline void IndexReply::clear_document_number() {
-  _impl_.document_number_ = int64_t{0};
+// int64 document_number = 2;
+inline void IndexReply::clear_document_number() {
+  _impl_.document_number_ = int64_t{0};
+}
+inline int64_t IndexReply::_internal_document_number() const {
+  return _impl_.document_number_;
+}
+inline int64_t IndexReply::document_number() const {
+  // @@protoc_insertion_point(field_get:IndexReply.document_number)
+  return _internal_document_number();
+}
+inline void IndexReply::_internal_set_document_number(int64_t value) {
+  
+  _impl_.document_number_ = value;
+}
+inline void IndexReply::set_document_number(int64_t value) {
+  _internal_set_document_number(value);
+  // @@protoc_insertion_point(field_set:IndexReply.document_number)
+}
+
+// -------------------------------------------------------------------
+
+// DeleteRequest
+
+// repeated int64 document_numbers = 1;
+inline int DeleteRequest::_internal_document_numbers_size() const {
+  return _impl_.document_numbers_.size();
+}
+inline int DeleteRequest::document_numbers_size() const {
+  return _internal_document_numbers_size();
+}
+inline void DeleteRequest::clear_document_numbers() {
+  _impl_.document_numbers_.Clear();
+}
+inline int64_t DeleteRequest::_internal_document_numbers(int index) const {
+  return _impl_.document_numbers_.Get(index);
+}
+inline int64_t DeleteRequest::document_numbers(int index) const {
+  // @@protoc_insertion_point(field_get:DeleteRequest.document_numbers)
+  return _internal_document_numbers(index);
+}
+inline void DeleteRequest::set_document_numbers(int index, int64_t value) {
+  _impl_.document_numbers_.Set(index, value);
+  // @@protoc_insertion_point(field_set:DeleteRequest.document_numbers)
+}
+inline void DeleteRequest::_internal_add_document_numbers(int64_t value) {
+  _impl_.document_numbers_.Add(value);
+}
+inline void DeleteRequest::add_document_numbers(int64_t value) {
+  _internal_add_document_numbers(value);
+  // @@protoc_insertion_point(field_add:DeleteRequest.document_numbers)
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int64_t >&
+DeleteRequest::_internal_document_numbers() const {
+  return _impl_.document_numbers_;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedField< int64_t >&
+DeleteRequest::document_numbers() const {
+  // @@protoc_insertion_point(field_list:DeleteRequest.document_numbers)
+  return _internal_document_numbers();
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< int64_t >*
+DeleteRequest::_internal_mutable_document_numbers() {
+  return &_impl_.document_numbers_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedField< int64_t >*
+DeleteRequest::mutable_document_numbers() {
+  // @@protoc_insertion_point(field_mutable_list:DeleteRequest.document_numbers)
+  return _internal_mutable_document_numbers();
+}
+
+// -------------------------------------------------------------------
+
+// HelloReply
+
+// string server_id = 1;
+inline void HelloReply::clear_server_id() {
+  _impl_.server_id_.ClearToEmpty();
+}
+inline const std::string& HelloReply::server_id() const {
+  // @@protoc_insertion_point(field_get:HelloReply.server_id)
+  return _internal_server_id();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void HelloReply::set_server_id(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.server_id_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:HelloReply.server_id)
+}
+inline std::string* HelloReply::mutable_server_id() {
+  std::string* _s = _internal_mutable_server_id();
+  // @@protoc_insertion_point(field_mutable:HelloReply.server_id)
+  return _s;
+}
+inline const std::string& HelloReply::_internal_server_id() const {
+  return _impl_.server_id_.Get();
+}
+inline void HelloReply::_internal_set_server_id(const std::string& value) {
+  
+  _impl_.server_id_.Set(value, GetArenaForAllocation());
+}
+inline std::string* HelloReply::_internal_mutable_server_id() {
+  
+  return _impl_.server_id_.Mutable(GetArenaForAllocation());
+}
+inline std::string* HelloReply::release_server_id() {
+  // @@protoc_insertion_point(field_release:HelloReply.server_id)
+  return _impl_.server_id_.Release();
+}
+inline void HelloReply::set_allocated_server_id(std::string* server_id) {
+  if (server_id != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.server_id_.SetAllocated(server_id, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.server_id_.IsDefault()) {
+    _impl_.server_id_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:HelloReply.server_id)
+}
+
+// string client_name = 2;
+inline void HelloReply::clear_client_name() {
+  _impl_.client_name_.ClearToEmpty();
+}
+inline const std::string& HelloReply::client_name() const {
+  // @@protoc_insertion_point(field_get:HelloReply.client_name)
+  return _internal_client_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void HelloReply::set_client_name(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.client_name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:HelloReply.client_name)
+}
+inline std::string* HelloReply::mutable_client_name() {
+  std::string* _s = _internal_mutable_client_name();
+  // @@protoc_insertion_point(field_mutable:HelloReply.client_name)
+  return _s;
+}
+inline const std::string& HelloReply::_internal_client_name() const {
+  return _impl_.client_name_.Get();
+}
+inline void HelloReply::_internal_set_client_name(const std::string& value) {
+  
+  _impl_.client_name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* HelloReply::_internal_mutable_client_name() {
+  
+  return _impl_.client_name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* HelloReply::release_client_name() {
+  // @@protoc_insertion_point(field_release:HelloReply.client_name)
+  return _impl_.client_name_.Release();
+}
+inline void HelloReply::set_allocated_client_name(std::string* client_name) {
+  if (client_name != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.client_name_.SetAllocated(client_name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.client_name_.IsDefault()) {
+    _impl_.client_name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:HelloReply.client_name)
+}
+
+// -------------------------------------------------------------------
+
+// QueryNode
+
+// .QueryNode.NodeType type = 1;
+inline void QueryNode::clear_type() {
+  _impl_.type_ = 0;
+}
+inline ::QueryNode_NodeType QueryNode::_internal_type() const {
+  return static_cast< ::QueryNode_NodeType >(_impl_.type_);
+}
+inline ::QueryNode_NodeType QueryNode::type() const {
+  // @@protoc_insertion_point(field_get:QueryNode.type)
+  return _internal_type();
+}
+inline void QueryNode::_internal_set_type(::QueryNode_NodeType value) {
+  
+  _impl_.type_ = value;
+}
+inline void QueryNode::set_type(::QueryNode_NodeType value) {
+  _internal_set_type(value);
+  // @@protoc_insertion_point(field_set:QueryNode.type)
+}
+
+// string term = 2;
+inline void QueryNode::clear_term() {
+  _impl_.term_.ClearToEmpty();
+}
+inline const std::string& QueryNode::term() const {
+  // @@protoc_insertion_point(field_get:QueryNode.term)
+  return _internal_term();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void QueryNode::set_term(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.term_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:QueryNode.term)
+}
+inline std::string* QueryNode::mutable_term() {
+  std::string* _s = _internal_mutable_term();
+  // @@protoc_insertion_point(field_mutable:QueryNode.term)
+  return _s;
+}
+inline const std::string& QueryNode::_internal_term() const {
+  return _impl_.term_.Get();
+}
+inline void QueryNode::_internal_set_term(const std::string& value) {
+  
+  _impl_.term_.Set(value, GetArenaForAllocation());
+}
+inline std::string* QueryNode::_internal_mutable_term() {
+  
+  return _impl_.term_.Mutable(GetArenaForAllocation());
+}
+inline std::string* QueryNode::release_term() {
+  // @@protoc_insertion_point(field_release:QueryNode.term)
+  return _impl_.term_.Release();
+}
+inline void QueryNode::set_allocated_term(std::string* term) {
+  if (term != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.term_.SetAllocated(term, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.term_.IsDefault()) {
+    _impl_.term_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:QueryNode.term)
+}
+
+// repeated .QueryNode children = 3;
+inline int QueryNode::_internal_children_size() const {
+  return _impl_.children_.size();
+}
+inline int QueryNode::children_size() const {
+  return _internal_children_size();
+}
+inline void QueryNode::clear_children() {
+  _impl_.children_.Clear();
+}
+inline ::QueryNode* QueryNode::mutable_children(int index) {
+  // @@protoc_insertion_point(field_mutable:QueryNode.children)
+  return _impl_.children_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::QueryNode >*
+QueryNode::mutable_children() {
+  // @@protoc_insertion_point(field_mutable_list:QueryNode.children)
+  return &_impl_.children_;
+}
+inline const ::QueryNode& QueryNode::_internal_children(int index) const {
+  return _impl_.children_.Get(index);
+}
+inline const ::QueryNode& QueryNode::children(int index) const {
+  // @@protoc_insertion_point(field_get:QueryNode.children)
+  return _internal_children(index);
+}
+inline ::QueryNode* QueryNode::_internal_add_children() {
+  return _impl_.children_.Add();
+}
+inline ::QueryNode* QueryNode::add_children() {
+  ::QueryNode* _add = _internal_add_children();
+  // @@protoc_insertion_point(field_add:QueryNode.children)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::QueryNode >&
+QueryNode::children() const {
+  // @@protoc_insertion_point(field_list:QueryNode.children)
+  return _impl_.children_;
+}
+
+// int32 minimum_should_match = 4;
+inline void QueryNode::clear_minimum_should_match() {
+  _impl_.minimum_should_match_ = 0;
 }
-inline int64_t IndexReply::_internal_document_number() const {
-  return _impl_.document_number_;
+inline int32_t QueryNode::_internal_minimum_should_match() const {
+  return _impl_.minimum_should_match_;
 }
-inline int64_t IndexReply::document_number() const {
-  // @@protoc_insertion_point(field_get:IndexReply.document_number)
-  return _internal_document_number();
+inline int32_t QueryNode::minimum_should_match() const {
+  // @@protoc_insertion_point(field_get:QueryNode.minimum_should_match)
+  return _internal_minimum_should_match();
 }
-inline void IndexReply::_internal_set_document_number(int64_t value) {
+inline void QueryNode::_internal_set_minimum_should_match(int32_t value) {
   
-  _impl_.document_number_ = value;
+  _impl_.minimum_should_match_ = value;
 }
-inline void IndexReply::set_document_number(int64_t value) {
-  _internal_set_document_number(value);
-  // @@protoc_insertion_point(field_set:IndexReply.document_number)
+inline void QueryNode::set_minimum_should_match(int32_t value) {
+  _internal_set_minimum_should_match(value);
+  // @@protoc_insertion_point(field_set:QueryNode.minimum_should_match)
 }
 
 // -------------------------------------------------------------------
@@ -1676,6 +3054,266 @@ SearchRequest::mutable_logical_operators() {
   return &_impl_.logical_operators_;
 }
 
+// int32 k = 3;
+inline void SearchRequest::clear_k() {
+  _impl_.k_ = 0;
+}
+inline int32_t SearchRequest::_internal_k() const {
+  return _impl_.k_;
+}
+inline int32_t SearchRequest::k() const {
+  // @@protoc_insertion_point(field_get:SearchRequest.k)
+  return _internal_k();
+}
+inline void SearchRequest::_internal_set_k(int32_t value) {
+  
+  _impl_.k_ = value;
+}
+inline void SearchRequest::set_k(int32_t value) {
+  _internal_set_k(value);
+  // @@protoc_insertion_point(field_set:SearchRequest.k)
+}
+
+// .SearchRequest.Ranking ranking = 4;
+inline void SearchRequest::clear_ranking() {
+  _impl_.ranking_ = 0;
+}
+inline ::SearchRequest_Ranking SearchRequest::_internal_ranking() const {
+  return static_cast< ::SearchRequest_Ranking >(_impl_.ranking_);
+}
+inline ::SearchRequest_Ranking SearchRequest::ranking() const {
+  // @@protoc_insertion_point(field_get:SearchRequest.ranking)
+  return _internal_ranking();
+}
+inline void SearchRequest::_internal_set_ranking(::SearchRequest_Ranking value) {
+  
+  _impl_.ranking_ = value;
+}
+inline void SearchRequest::set_ranking(::SearchRequest_Ranking value) {
+  _internal_set_ranking(value);
+  // @@protoc_insertion_point(field_set:SearchRequest.ranking)
+}
+
+// .QueryNode query = 5;
+inline bool SearchRequest::_internal_has_query() const {
+  return this != internal_default_instance() && _impl_.query_ != nullptr;
+}
+inline bool SearchRequest::has_query() const {
+  return _internal_has_query();
+}
+inline void SearchRequest::clear_query() {
+  if (GetArenaForAllocation() == nullptr && _impl_.query_ != nullptr) {
+    delete _impl_.query_;
+  }
+  _impl_.query_ = nullptr;
+}
+inline const ::QueryNode& SearchRequest::_internal_query() const {
+  const ::QueryNode* p = _impl_.query_;
+  return p != nullptr ? *p : reinterpret_cast<const ::QueryNode&>(
+      ::_QueryNode_default_instance_);
+}
+inline const ::QueryNode& SearchRequest::query() const {
+  // @@protoc_insertion_point(field_get:SearchRequest.query)
+  return _internal_query();
+}
+inline void SearchRequest::unsafe_arena_set_allocated_query(
+    ::QueryNode* query) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.query_);
+  }
+  _impl_.query_ = query;
+  if (query) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:SearchRequest.query)
+}
+inline ::QueryNode* SearchRequest::release_query() {
+  
+  ::QueryNode* temp = _impl_.query_;
+  _impl_.query_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::QueryNode* SearchRequest::unsafe_arena_release_query() {
+  // @@protoc_insertion_point(field_release:SearchRequest.query)
+  
+  ::QueryNode* temp = _impl_.query_;
+  _impl_.query_ = nullptr;
+  return temp;
+}
+inline ::QueryNode* SearchRequest::_internal_mutable_query() {
+  
+  if (_impl_.query_ == nullptr) {
+    auto* p = CreateMaybeMessage<::QueryNode>(GetArenaForAllocation());
+    _impl_.query_ = p;
+  }
+  return _impl_.query_;
+}
+inline ::QueryNode* SearchRequest::mutable_query() {
+  ::QueryNode* _msg = _internal_mutable_query();
+  // @@protoc_insertion_point(field_mutable:SearchRequest.query)
+  return _msg;
+}
+inline void SearchRequest::set_allocated_query(::QueryNode* query) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.query_;
+  }
+  if (query) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(query);
+    if (message_arena != submessage_arena) {
+      query = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, query, submessage_arena);
+    }
+    
+  } else {
+    
+  }
+  _impl_.query_ = query;
+  // @@protoc_insertion_point(field_set_allocated:SearchRequest.query)
+}
+
+// int32 offset = 6;
+inline void SearchRequest::clear_offset() {
+  _impl_.offset_ = 0;
+}
+inline int32_t SearchRequest::_internal_offset() const {
+  return _impl_.offset_;
+}
+inline int32_t SearchRequest::offset() const {
+  // @@protoc_insertion_point(field_get:SearchRequest.offset)
+  return _internal_offset();
+}
+inline void SearchRequest::_internal_set_offset(int32_t value) {
+  
+  _impl_.offset_ = value;
+}
+inline void SearchRequest::set_offset(int32_t value) {
+  _internal_set_offset(value);
+  // @@protoc_insertion_point(field_set:SearchRequest.offset)
+}
+
+// string continuation_token = 7;
+inline void SearchRequest::clear_continuation_token() {
+  _impl_.continuation_token_.ClearToEmpty();
+}
+inline const std::string& SearchRequest::continuation_token() const {
+  // @@protoc_insertion_point(field_get:SearchRequest.continuation_token)
+  return _internal_continuation_token();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void SearchRequest::set_continuation_token(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.continuation_token_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:SearchRequest.continuation_token)
+}
+inline std::string* SearchRequest::mutable_continuation_token() {
+  std::string* _s = _internal_mutable_continuation_token();
+  // @@protoc_insertion_point(field_mutable:SearchRequest.continuation_token)
+  return _s;
+}
+inline const std::string& SearchRequest::_internal_continuation_token() const {
+  return _impl_.continuation_token_.Get();
+}
+inline void SearchRequest::_internal_set_continuation_token(const std::string& value) {
+  
+  _impl_.continuation_token_.Set(value, GetArenaForAllocation());
+}
+inline std::string* SearchRequest::_internal_mutable_continuation_token() {
+  
+  return _impl_.continuation_token_.Mutable(GetArenaForAllocation());
+}
+inline std::string* SearchRequest::release_continuation_token() {
+  // @@protoc_insertion_point(field_release:SearchRequest.continuation_token)
+  return _impl_.continuation_token_.Release();
+}
+inline void SearchRequest::set_allocated_continuation_token(std::string* continuation_token) {
+  if (continuation_token != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.continuation_token_.SetAllocated(continuation_token, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.continuation_token_.IsDefault()) {
+    _impl_.continuation_token_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:SearchRequest.continuation_token)
+}
+
+// int32 chunk_size = 8;
+inline void SearchRequest::clear_chunk_size() {
+  _impl_.chunk_size_ = 0;
+}
+inline int32_t SearchRequest::_internal_chunk_size() const {
+  return _impl_.chunk_size_;
+}
+inline int32_t SearchRequest::chunk_size() const {
+  // @@protoc_insertion_point(field_get:SearchRequest.chunk_size)
+  return _internal_chunk_size();
+}
+inline void SearchRequest::_internal_set_chunk_size(int32_t value) {
+  
+  _impl_.chunk_size_ = value;
+}
+inline void SearchRequest::set_chunk_size(int32_t value) {
+  _internal_set_chunk_size(value);
+  // @@protoc_insertion_point(field_set:SearchRequest.chunk_size)
+}
+
+// .SearchRequest.Mode mode = 9;
+inline void SearchRequest::clear_mode() {
+  _impl_.mode_ = 0;
+}
+inline ::SearchRequest_Mode SearchRequest::_internal_mode() const {
+  return static_cast< ::SearchRequest_Mode >(_impl_.mode_);
+}
+inline ::SearchRequest_Mode SearchRequest::mode() const {
+  // @@protoc_insertion_point(field_get:SearchRequest.mode)
+  return _internal_mode();
+}
+inline void SearchRequest::_internal_set_mode(::SearchRequest_Mode value) {
+  
+  _impl_.mode_ = value;
+}
+inline void SearchRequest::set_mode(::SearchRequest_Mode value) {
+  _internal_set_mode(value);
+  // @@protoc_insertion_point(field_set:SearchRequest.mode)
+}
+
+// int32 time_budget_ms = 10;
+inline void SearchRequest::clear_time_budget_ms() {
+  _impl_.time_budget_ms_ = 0;
+}
+inline int32_t SearchRequest::_internal_time_budget_ms() const {
+  return _impl_.time_budget_ms_;
+}
+inline int32_t SearchRequest::time_budget_ms() const {
+  // @@protoc_insertion_point(field_get:SearchRequest.time_budget_ms)
+  return _internal_time_budget_ms();
+}
+inline void SearchRequest::_internal_set_time_budget_ms(int32_t value) {
+  
+  _impl_.time_budget_ms_ = value;
+}
+inline void SearchRequest::set_time_budget_ms(int32_t value) {
+  _internal_set_time_budget_ms(value);
+  // @@protoc_insertion_point(field_set:SearchRequest.time_budget_ms)
+}
+
 // -------------------------------------------------------------------
 
 // SearchReply_Document
@@ -1800,6 +3438,26 @@ inline void SearchReply_Document::set_allocated_client_id(std::string* client_id
   // @@protoc_insertion_point(field_set_allocated:SearchReply.Document.client_id)
 }
 
+// double score = 4;
+inline void SearchReply_Document::clear_score() {
+  _impl_.score_ = 0;
+}
+inline double SearchReply_Document::_internal_score() const {
+  return _impl_.score_;
+}
+inline double SearchReply_Document::score() const {
+  // @@protoc_insertion_point(field_get:SearchReply.Document.score)
+  return _internal_score();
+}
+inline void SearchReply_Document::_internal_set_score(double value) {
+  
+  _impl_.score_ = value;
+}
+inline void SearchReply_Document::set_score(double value) {
+  _internal_set_score(value);
+  // @@protoc_insertion_point(field_set:SearchReply.Document.score)
+}
+
 // -------------------------------------------------------------------
 
 // SearchReply
@@ -1884,6 +3542,160 @@ inline void SearchReply::set_execution_time(double value) {
   // @@protoc_insertion_point(field_set:SearchReply.execution_time)
 }
 
+// bool total_is_estimate = 5;
+inline void SearchReply::clear_total_is_estimate() {
+  _impl_.total_is_estimate_ = false;
+}
+inline bool SearchReply::_internal_total_is_estimate() const {
+  return _impl_.total_is_estimate_;
+}
+inline bool SearchReply::total_is_estimate() const {
+  // @@protoc_insertion_point(field_get:SearchReply.total_is_estimate)
+  return _internal_total_is_estimate();
+}
+inline void SearchReply::_internal_set_total_is_estimate(bool value) {
+  
+  _impl_.total_is_estimate_ = value;
+}
+inline void SearchReply::set_total_is_estimate(bool value) {
+  _internal_set_total_is_estimate(value);
+  // @@protoc_insertion_point(field_set:SearchReply.total_is_estimate)
+}
+
+// string continuation_token = 6;
+inline void SearchReply::clear_continuation_token() {
+  _impl_.continuation_token_.ClearToEmpty();
+}
+inline const std::string& SearchReply::continuation_token() const {
+  // @@protoc_insertion_point(field_get:SearchReply.continuation_token)
+  return _internal_continuation_token();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void SearchReply::set_continuation_token(ArgT0&& arg0, ArgT... args) {
+ 
+ _impl_.continuation_token_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:SearchReply.continuation_token)
+}
+inline std::string* SearchReply::mutable_continuation_token() {
+  std::string* _s = _internal_mutable_continuation_token();
+  // @@protoc_insertion_point(field_mutable:SearchReply.continuation_token)
+  return _s;
+}
+inline const std::string& SearchReply::_internal_continuation_token() const {
+  return _impl_.continuation_token_.Get();
+}
+inline void SearchReply::_internal_set_continuation_token(const std::string& value) {
+  
+  _impl_.continuation_token_.Set(value, GetArenaForAllocation());
+}
+inline std::string* SearchReply::_internal_mutable_continuation_token() {
+  
+  return _impl_.continuation_token_.Mutable(GetArenaForAllocation());
+}
+inline std::string* SearchReply::release_continuation_token() {
+  // @@protoc_insertion_point(field_release:SearchReply.continuation_token)
+  return _impl_.continuation_token_.Release();
+}
+inline void SearchReply::set_allocated_continuation_token(std::string* continuation_token) {
+  if (continuation_token != nullptr) {
+    
+  } else {
+    
+  }
+  _impl_.continuation_token_.SetAllocated(continuation_token, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.continuation_token_.IsDefault()) {
+    _impl_.continuation_token_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:SearchReply.continuation_token)
+}
+
+// bool more_chunks = 7;
+inline void SearchReply::clear_more_chunks() {
+  _impl_.more_chunks_ = false;
+}
+inline bool SearchReply::_internal_more_chunks() const {
+  return _impl_.more_chunks_;
+}
+inline bool SearchReply::more_chunks() const {
+  // @@protoc_insertion_point(field_get:SearchReply.more_chunks)
+  return _internal_more_chunks();
+}
+inline void SearchReply::_internal_set_more_chunks(bool value) {
+  
+  _impl_.more_chunks_ = value;
+}
+inline void SearchReply::set_more_chunks(bool value) {
+  _internal_set_more_chunks(value);
+  // @@protoc_insertion_point(field_set:SearchReply.more_chunks)
+}
+
+// bool partial = 8;
+inline void SearchReply::clear_partial() {
+  _impl_.partial_ = false;
+}
+inline bool SearchReply::_internal_partial() const {
+  return _impl_.partial_;
+}
+inline bool SearchReply::partial() const {
+  // @@protoc_insertion_point(field_get:SearchReply.partial)
+  return _internal_partial();
+}
+inline void SearchReply::_internal_set_partial(bool value) {
+  
+  _impl_.partial_ = value;
+}
+inline void SearchReply::set_partial(bool value) {
+  _internal_set_partial(value);
+  // @@protoc_insertion_point(field_set:SearchReply.partial)
+}
+
+// -------------------------------------------------------------------
+
+// BatchSearchRequest
+
+// repeated .SearchRequest searches = 1;
+inline int BatchSearchRequest::_internal_searches_size() const {
+  return _impl_.searches_.size();
+}
+inline int BatchSearchRequest::searches_size() const {
+  return _internal_searches_size();
+}
+inline void BatchSearchRequest::clear_searches() {
+  _impl_.searches_.Clear();
+}
+inline ::SearchRequest* BatchSearchRequest::mutable_searches(int index) {
+  // @@protoc_insertion_point(field_mutable:BatchSearchRequest.searches)
+  return _impl_.searches_.Mutable(index);
+}
+inline ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::SearchRequest >*
+BatchSearchRequest::mutable_searches() {
+  // @@protoc_insertion_point(field_mutable_list:BatchSearchRequest.searches)
+  return &_impl_.searches_;
+}
+inline const ::SearchRequest& BatchSearchRequest::_internal_searches(int index) const {
+  return _impl_.searches_.Get(index);
+}
+inline const ::SearchRequest& BatchSearchRequest::searches(int index) const {
+  // @@protoc_insertion_point(field_get:BatchSearchRequest.searches)
+  return _internal_searches(index);
+}
+inline ::SearchRequest* BatchSearchRequest::_internal_add_searches() {
+  return _impl_.searches_.Add();
+}
+inline ::SearchRequest* BatchSearchRequest::add_searches() {
+  ::SearchRequest* _add = _internal_add_searches();
+  // @@protoc_insertion_point(field_add:BatchSearchRequest.searches)
+  return _add;
+}
+inline const ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::SearchRequest >&
+BatchSearchRequest::searches() const {
+  // @@protoc_insertion_point(field_list:BatchSearchRequest.searches)
+  return _impl_.searches_;
+}
+
 // -------------------------------------------------------------------
 
 // ServerMessage
@@ -2268,6 +4080,96 @@ inline void ServerMessage::set_allocated_search_reply(::SearchReply* search_repl
   // @@protoc_insertion_point(field_set_allocated:ServerMessage.search_reply)
 }
 
+// .DeleteRequest delete_request = 6;
+inline bool ServerMessage::_internal_has_delete_request() const {
+  return this != internal_default_instance() && _impl_.delete_request_ != nullptr;
+}
+inline bool ServerMessage::has_delete_request() const {
+  return _internal_has_delete_request();
+}
+inline void ServerMessage::clear_delete_request() {
+  if (GetArenaForAllocation() == nullptr && _impl_.delete_request_ != nullptr) {
+    delete _impl_.delete_request_;
+  }
+  _impl_.delete_request_ = nullptr;
+}
+inline const ::DeleteRequest& ServerMessage::_internal_delete_request() const {
+  const ::DeleteRequest* p = _impl_.delete_request_;
+  return p != nullptr ? *p : reinterpret_cast<const ::DeleteRequest&>(
+      ::_DeleteRequest_default_instance_);
+}
+inline const ::DeleteRequest& ServerMessage::delete_request() const {
+  // @@protoc_insertion_point(field_get:ServerMessage.delete_request)
+  return _internal_delete_request();
+}
+inline void ServerMessage::unsafe_arena_set_allocated_delete_request(
+    ::DeleteRequest* delete_request) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.delete_request_);
+  }
+  _impl_.delete_request_ = delete_request;
+  if (delete_request) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:ServerMessage.delete_request)
+}
+inline ::DeleteRequest* ServerMessage::release_delete_request() {
+  
+  ::DeleteRequest* temp = _impl_.delete_request_;
+  _impl_.delete_request_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::DeleteRequest* ServerMessage::unsafe_arena_release_delete_request() {
+  // @@protoc_insertion_point(field_release:ServerMessage.delete_request)
+  
+  ::DeleteRequest* temp = _impl_.delete_request_;
+  _impl_.delete_request_ = nullptr;
+  return temp;
+}
+inline ::DeleteRequest* ServerMessage::_internal_mutable_delete_request() {
+  
+  if (_impl_.delete_request_ == nullptr) {
+    auto* p = CreateMaybeMessage<::DeleteRequest>(GetArenaForAllocation());
+    _impl_.delete_request_ = p;
+  }
+  return _impl_.delete_request_;
+}
+inline ::DeleteRequest* ServerMessage::mutable_delete_request() {
+  ::DeleteRequest* _msg = _internal_mutable_delete_request();
+  // @@protoc_insertion_point(field_mutable:ServerMessage.delete_request)
+  return _msg;
+}
+inline void ServerMessage::set_allocated_delete_request(::DeleteRequest* delete_request) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete _impl_.delete_request_;
+  }
+  if (delete_request) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(delete_request);
+    if (message_arena != submessage_arena) {
+      delete_request = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, delete_request, submessage_arena);
+    }
+    
+  } else {
+    
+  }
+  _impl_.delete_request_ = delete_request;
+  // @@protoc_insertion_point(field_set_allocated:ServerMessage.delete_request)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -2283,12 +4185,35 @@ inline void ServerMessage::set_allocated_search_reply(::SearchReply* search_repl
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
 
 PROTOBUF_NAMESPACE_OPEN
 
+template <> struct is_proto_enum< ::QueryNode_NodeType> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::QueryNode_NodeType>() {
+  return ::QueryNode_NodeType_descriptor();
+}
+template <> struct is_proto_enum< ::SearchRequest_Ranking> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::SearchRequest_Ranking>() {
+  return ::SearchRequest_Ranking_descriptor();
+}
+template <> struct is_proto_enum< ::SearchRequest_Mode> : ::std::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::SearchRequest_Mode>() {
+  return ::SearchRequest_Mode_descriptor();
+}
 template <> struct is_proto_enum< ::ServerMessage_MessageType> : ::std::true_type {};
 template <>
 inline const EnumDescriptor* GetEnumDescriptor< ::ServerMessage_MessageType>() {
@@ -1,8 +1,11 @@
 #include "ClientAppInterface.hpp"
+#include "QueryParser.hpp"
 
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <cstring>
+#include <cstdlib>
 
 ClientAppInterface::ClientAppInterface(std::shared_ptr<ClientProcessingEngine> engine) : engine(engine) {
     // TO-DO implement constructor
@@ -53,16 +56,38 @@ void ClientAppInterface::readCommands() {
         
 
         if (command.size() >= 5 && command.substr(0, 5) == "index") {
-            std::string folderPath = command.substr(6);
+            std::string folderPath = command.size() > 6 ? command.substr(6) : "";
+
+            // trailing --include=PATTERN / --exclude=PATTERN options filter the files to index
+            WalkFilters filters;
+            while (true) {
+                size_t optionStart = folderPath.rfind(" --");
+                if (optionStart == std::string::npos) {
+                    break;
+                }
+                std::string option = folderPath.substr(optionStart + 1);
+                if (option.starts_with("--include=")) {
+                    filters.includePatterns.push_back(option.substr(strlen("--include=")));
+                } else if (option.starts_with("--exclude=")) {
+                    filters.excludePatterns.push_back(option.substr(strlen("--exclude=")));
+                } else {
+                    break;
+                }
+                folderPath.erase(optionStart);
+            }
 
             if(folderPath.empty()) {
                 std::cout << "Please enter a valid folder path." << std::endl;
                 continue;
             }
 
-            auto result = engine->indexFolder(folderPath);
+            auto result = engine->indexFolder(folderPath, filters);
             std::cout << "Completed indexing " << result.totalBytesRead << " bytes of data" << std::endl;
             std::cout << "Completed indexing in " << result.executionTime << " seconds" << std::endl;
+            if (result.filesUnchanged > 0 || result.filesDeleted > 0) {
+                std::cout << "Sent " << result.filesIndexed << " new or changed files, skipped " << result.filesUnchanged
+                          << " unchanged files and deleted " << result.filesDeleted << " removed files" << std::endl;
+            }
 
             continue;
         }
@@ -77,24 +102,95 @@ void ClientAppInterface::readCommands() {
                 continue;
             }
 
-            std::vector<std::string> terms;
+            std::string queryText;
             std::istringstream stream(searchQuery);
             std::string term;
+            SearchOptions options;
+            options.topResults = 10;
 
+            // --top=N asks for the N best documents instead of 10, --offset=M skips the M best
+            // for the pages after the first, --bm25 ranks them with BM25; --count and --exists
+            // only ask how many documents match and whether any does; --timeout=MS has the
+            // server reply with what it found after MS milliseconds
             while (stream >> term) {
-                terms.push_back(term);
+                if (term.starts_with("--timeout=")) {
+                    options.timeBudgetMs = std::atoi(term.c_str() + strlen("--timeout="));
+                    continue;
+                }
+                if (term == "--count") {
+                    options.mode = SearchMode::COUNT;
+                    continue;
+                }
+                if (term == "--exists") {
+                    options.mode = SearchMode::EXISTS;
+                    continue;
+                }
+                if (term.starts_with("--top=")) {
+                    options.topResults = std::atoi(term.c_str() + strlen("--top="));
+                    continue;
+                }
+                if (term.starts_with("--offset=")) {
+                    options.offset = std::atoi(term.c_str() + strlen("--offset="));
+                    continue;
+                }
+                if (term == "--bm25") {
+                    options.bm25 = true;
+                    continue;
+                }
+                queryText += term + " ";
+            }
+
+            if (queryText.empty()) {
+                std::cout << "Please enter the search terms." << std::endl;
+                continue;
+            }
+            if (options.topResults <= 0) {
+                std::cout << "The --top option needs a positive number." << std::endl;
+                continue;
+            }
+            if (options.offset < 0) {
+                std::cout << "The --offset option needs a number of at least 0." << std::endl;
+                continue;
+            }
+
+            // terms combine with AND, OR, NOT and parentheses, words next to each other are ANDed
+            QueryParser parser(queryText);
+            QueryNode query;
+            if (!parser.parse(query)) {
+                std::cout << parser.errorMessage() << std::endl;
+                continue;
             }
 
-            SearchResult result = engine->search(terms);
+            SearchResult result = engine->search(query, options);
 
             std::cout << "\nSearch completed in " << result.executionTime << " seconds." << std::endl;
+            if (result.partial) {
+                std::cout << YELLOW << "The search ran out of time, these are the results found until then." << RESET << std::endl;
+            }
+
+            if (options.mode == SearchMode::COUNT) {
+                std::cout << "Matching documents: " << result.totalResults << std::endl;
+                continue;
+            }
+            if (options.mode == SearchMode::EXISTS) {
+                std::cout << (result.totalResults > 0 ? "Some documents match." : "No document matches.") << std::endl;
+                continue;
+            }
 
             if (result.documentFrequencies.empty()) {
                 std::cout << YELLOW << "No results found" << RESET << std::endl;
             } else {
-                std::cout << "Search Results: " << "( Top 10 out of " << result.documentFrequencies.size() << "): \n"<< std::endl;
+                std::cout << "Search Results: " << "( Top " << options.topResults << " out of " << (result.totalIsEstimate ? "at least " : "")
+                          << result.totalResults << "): \n"<< std::endl;
                 for (const auto &docFrequency : result.documentFrequencies) {
-                    std::cout << GREEN << docFrequency.origin << ": " << docFrequency.documentPath << " (Frequency: " << docFrequency.wordFrequency << ")" << RESET << std::endl;
+                    if (options.bm25) {
+                        std::cout << GREEN << docFrequency.origin << ": " << docFrequency.documentPath << " (Score: " << docFrequency.score << ")" << RESET << std::endl;
+                    } else {
+                        std::cout << GREEN << docFrequency.origin << ": " << docFrequency.documentPath << " (Frequency: " << docFrequency.wordFrequency << ")" << RESET << std::endl;
+                    }
+                }
+                if (!result.continuationToken.empty()) {
+                    std::cout << "More results: add --offset=" << options.offset + result.documentFrequencies.size() << std::endl;
                 }
             }
 
@@ -12,12 +12,49 @@
 #include <chrono>
 #include <condition_variable>
 #include <fstream>
-#include <filesystem>
 #include <algorithm>
+#include <atomic>
 #include <arpa/inet.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <optional>
 
 
 
+namespace {
+    // files at least this big are tokenized in parallel chunks instead of being read whole
+    constexpr size_t LARGE_FILE_THRESHOLD = 64 * 1024 * 1024;
+    constexpr size_t CHUNK_SIZE = 8 * 1024 * 1024;
+    constexpr size_t CHUNK_TAIL_READ = 4096;
+
+    // the walk streams files to the indexing threads, blocking while this many are waiting
+    constexpr size_t MAX_QUEUED_FILES = 4096;
+    constexpr int WALKER_THREADS = 4;
+
+    // documents per reply message the server streams search results in
+    constexpr int SEARCH_CHUNK_DOCUMENTS = 1000;
+
+    bool isWordCharacter(char character) {
+        return std::isalnum(static_cast<unsigned char>(character));
+    }
+
+    // pread until length bytes were read, returns how many bytes the file actually had
+    ssize_t readAt(int fileDescriptor, char* buffer, size_t length, off_t offset) {
+        size_t totalRead = 0;
+        while (totalRead < length) {
+            ssize_t result = pread(fileDescriptor, buffer + totalRead, length - totalRead, offset + totalRead);
+            if (result < 0) {
+                if (errno == EINTR) continue;
+                return -1;
+            }
+            if (result == 0) break;
+            totalRead += result;
+        }
+        return totalRead;
+    }
+}
+
+
 ClientProcessingEngine::ClientProcessingEngine() {
     clientSocket = -1;
 }
@@ -27,89 +64,290 @@ std::string ClientProcessingEngine::generateClientID() {
     return std::to_string(clientMap.size() + 1);
 }
 
-std::unordered_map<std::string, int> ClientProcessingEngine::extractWords(const std::string& fileContent) {
-    std::unordered_map<std::string, int> wordFrequency;
-    std::string currentWord;
+void ClientProcessingEngine::extractWords(std::string_view fileContent, WordCounter& wordCounter) {
+    wordCounter.clear();
+    wordCounter.countWords(fileContent);
+}
 
-    for (char charecter : fileContent) {
-        if (std::isalnum(charecter)) {
-            currentWord += charecter;
-        } else {
-            if (currentWord.length() > 2) {
-                wordFrequency[currentWord]++;
+
+// Counts the words of a file too big to hold in memory. The file is cut into fixed size
+// chunks that several threads read and tokenize with their own counters, merging them into
+// wordCounter as they go, so only one chunk per thread is ever in memory. A word belongs to
+// the chunk it starts in: a chunk skips the tail of a word running in from the previous
+// chunk, and reads past its own end to finish the last word it started.
+bool ClientProcessingEngine::countLargeFile(const std::string& filePath, size_t fileSize, WordCounter& wordCounter, uint64_t& contentHash) {
+    int fileDescriptor = open(filePath.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+
+    size_t chunkCount = (fileSize + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    size_t threadCount = std::min<size_t>(chunkCount, std::max(2u, std::thread::hardware_concurrency()));
+    std::atomic<size_t> nextChunk = 0;
+    std::atomic<bool> failed = false;
+    std::mutex mergeMutex;
+    std::vector<uint64_t> chunkHashes(chunkCount);
+
+    wordCounter.clear();
+
+    auto chunkWorker = [&]() {
+        WordCounter chunkCounter;
+        std::string buffer;
+
+        for (size_t chunk = nextChunk++; chunk < chunkCount && !failed; chunk = nextChunk++) {
+            size_t chunkBegin = chunk * CHUNK_SIZE;
+            size_t chunkEnd = std::min(chunkBegin + CHUNK_SIZE, fileSize);
+
+            // one byte of lookbehind tells whether the chunk starts in the middle of a word
+            size_t readBegin = chunkBegin == 0 ? 0 : chunkBegin - 1;
+            buffer.resize(chunkEnd - readBegin);
+            if (readAt(fileDescriptor, buffer.data(), buffer.size(), readBegin) != static_cast<ssize_t>(buffer.size())) {
+                failed = true;
+                break;
+            }
+            chunkHashes[chunk] = IndexManifest::hashContent(std::string_view(buffer).substr(chunkBegin - readBegin));
+
+            size_t wordsBegin = chunkBegin - readBegin;
+            if (wordsBegin > 0 && isWordCharacter(buffer[0])) {
+                while (wordsBegin < buffer.size() && isWordCharacter(buffer[wordsBegin])) {
+                    wordsBegin++;
+                }
             }
-            currentWord.clear();
+            if (wordsBegin == buffer.size()) {
+                continue;
+            }
+
+            size_t readEnd = chunkEnd;
+            while (readEnd < fileSize && isWordCharacter(buffer.back())) {
+                size_t tailStart = buffer.size();
+                buffer.resize(tailStart + CHUNK_TAIL_READ);
+                ssize_t tailRead = readAt(fileDescriptor, buffer.data() + tailStart, CHUNK_TAIL_READ, readEnd);
+                if (tailRead < 0) {
+                    failed = true;
+                    break;
+                }
+                readEnd += tailRead;
+
+                auto wordEnd = std::find_if_not(buffer.begin() + tailStart, buffer.begin() + tailStart + tailRead, isWordCharacter);
+                buffer.resize(wordEnd - buffer.begin());
+                if (wordEnd != buffer.begin() + tailStart + tailRead || tailRead == 0) {
+                    break;
+                }
+            }
+            if (failed) {
+                break;
+            }
+
+            chunkCounter.clear();
+            chunkCounter.countWords(std::string_view(buffer).substr(wordsBegin));
+
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            wordCounter.merge(chunkCounter);
         }
+    };
+
+    std::vector<std::thread> chunkThreads;
+    for (size_t i = 1; i < threadCount; i++) {
+        chunkThreads.emplace_back(chunkWorker);
     }
+    chunkWorker();
 
-    if(currentWord.length() > 2) {
-        wordFrequency[currentWord]++;
+    for (auto& thread : chunkThreads) {
+        thread.join();
     }
-    return wordFrequency;
+
+    close(fileDescriptor);
+    contentHash = IndexManifest::hashContent(std::string_view(reinterpret_cast<const char*>(chunkHashes.data()), chunkHashes.size() * sizeof(uint64_t)));
+    return !failed;
 }
 
 
-bool ClientProcessingEngine::sendIndexRequest(const IndexRequest& request) {
-    std::string serializedData;
+namespace {
+    void appendVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
 
-    // Serialize the IndexRequest
-    request.SerializeToString(&serializedData);
+    size_t varintSize(uint64_t value) {
+        size_t size = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            size++;
+        }
+        return size;
+    }
+
+    // length delimited protobuf field (wire type 2)
+    void appendBytesField(std::string& out, uint32_t fieldNumber, std::string_view bytes) {
+        appendVarint(out, (fieldNumber << 3) | 2);
+        appendVarint(out, bytes.size());
+        out.append(bytes.data(), bytes.size());
+    }
+}
+
+
+// Encodes a complete "INDEX:" frame (size prefix included) for an IndexRequest straight
+// from the counter, so the words are never copied into a protobuf map first. The
+// layout matches IndexRequest in serverMessages.proto, a map entry being a nested
+// message with the key as field 1 and the value as field 2.
+void ClientProcessingEngine::buildIndexFrame(std::string& frame, const std::string& clientID, const std::string& documentPath, long replaceDocumentNumber, const WordCounter& wordCounter) {
     const std::string prefix = "INDEX:";
-    std::string prefixedData = prefix + serializedData;
 
-    // Send data size
-    uint32_t dataSize = htonl(prefixedData.size());
-    if (send(clientSocket, &dataSize, sizeof(dataSize), 0) <= 0) {
-        std::cerr << "Error sending data size: " << strerror(errno) << std::endl;
-        return false;
+    frame.clear();
+    frame.append(sizeof(uint32_t), '\0');
+    frame.append(prefix);
+
+    appendBytesField(frame, 1, clientID);
+    appendBytesField(frame, 2, documentPath);
+    wordCounter.forEach([&frame](std::string_view word, int32_t count) {
+        size_t entrySize = 1 + varintSize(word.size()) + word.size() + 1 + varintSize(static_cast<uint32_t>(count));
+        appendVarint(frame, (3 << 3) | 2);
+        appendVarint(frame, entrySize);
+        appendBytesField(frame, 1, word);
+        appendVarint(frame, (2 << 3) | 0);
+        appendVarint(frame, static_cast<uint32_t>(count));
+    });
+    if (replaceDocumentNumber != 0) {
+        appendVarint(frame, (4 << 3) | 0);
+        appendVarint(frame, static_cast<uint64_t>(replaceDocumentNumber));
     }
 
-    // Send actual data with handling for partial sends
-    ssize_t bytesSent = 0;
-    while (bytesSent < prefixedData.size()) {
-        ssize_t result = send(clientSocket, prefixedData.c_str() + bytesSent, prefixedData.size() - bytesSent, 0);
+    uint32_t dataSize = htonl(static_cast<uint32_t>(frame.size() - sizeof(uint32_t)));
+    memcpy(frame.data(), &dataSize, sizeof(dataSize));
+}
+
+
+// Sends a message prefixed with its size, the caller holds socketMutex
+bool ClientProcessingEngine::sendFrame(const std::string& message) {
+    uint32_t messageSize = htonl(static_cast<uint32_t>(message.size()));
+    std::string frame(reinterpret_cast<const char*>(&messageSize), sizeof(messageSize));
+    frame += message;
+
+    size_t bytesSent = 0;
+    while (bytesSent < frame.size()) {
+        ssize_t result = send(clientSocket, frame.data() + bytesSent, frame.size() - bytesSent, 0);
         if (result < 0) {
-            std::cerr << "Error sending IndexRequest: " << strerror(errno) << std::endl;
+            std::cerr << "Error sending message: " << strerror(errno) << std::endl;
+            return false;
+        }
+        bytesSent += result;
+    }
+    return true;
+}
+
+// Receives one size prefixed reply, the caller holds socketMutex
+bool ClientProcessingEngine::receiveFrame(std::string& message) {
+    uint32_t messageSize;
+    size_t totalReceived = 0;
+    while (totalReceived < sizeof(messageSize)) {
+        ssize_t bytesReceived = recv(clientSocket, reinterpret_cast<char*>(&messageSize) + totalReceived, sizeof(messageSize) - totalReceived, 0);
+        if (bytesReceived <= 0) {
+            std::cerr << "Error receiving reply size: " << (bytesReceived == 0 ? "connection closed" : strerror(errno)) << std::endl;
+            return false;
+        }
+        totalReceived += bytesReceived;
+    }
+
+    message.resize(ntohl(messageSize));
+    totalReceived = 0;
+    while (totalReceived < message.size()) {
+        ssize_t bytesReceived = recv(clientSocket, message.data() + totalReceived, message.size() - totalReceived, 0);
+        if (bytesReceived <= 0) {
+            std::cerr << "Error receiving reply data: " << (bytesReceived == 0 ? "connection closed" : strerror(errno)) << std::endl;
             return false;
         }
+        totalReceived += bytesReceived;
+    }
+    return true;
+}
+
+
+// Returns the number the server gave the document, or -1 when the request failed
+long ClientProcessingEngine::sendIndexFrame(const std::string& frame) {
+    std::lock_guard<std::mutex> lock(socketMutex);
+
+    // Send the size prefixed frame with handling for partial sends
+    size_t bytesSent = 0;
+    while (bytesSent < frame.size()) {
+        ssize_t result = send(clientSocket, frame.data() + bytesSent, frame.size() - bytesSent, 0);
+        if (result < 0) {
+            std::cerr << "Error sending IndexRequest: " << strerror(errno) << std::endl;
+            return -1;
+        }
         bytesSent += result;
     }
-    // std::cout << "bytesSent: " << bytesSent << std::endl;
 
+    std::string replyData;
+    IndexReply reply;
+    if (!receiveFrame(replyData) || !reply.ParseFromString(replyData)) {
+        std::cerr << "Failed to receive IndexReply." << std::endl;
+        return -1;
+    }
+
+    return reply.document_number();
+}
 
-    char buffer[10240] = {0}; 
-    ssize_t bytesReceived = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
-    if (bytesReceived < 0) {
-        std::cerr << "Error receiving reply data: " << strerror(errno) << std::endl;
+
+bool ClientProcessingEngine::sendDeleteRequest(const std::vector<long>& documentNumbers) {
+    DeleteRequest request;
+    for (long documentNumber : documentNumbers) {
+        request.add_document_numbers(documentNumber);
+    }
+
+    std::lock_guard<std::mutex> lock(socketMutex);
+    std::string replyData;
+    if (!sendFrame("DELETE:" + request.SerializeAsString()) || !receiveFrame(replyData)) {
+        std::cerr << "Failed to send DeleteRequest." << std::endl;
         return false;
     }
-    if (bytesReceived == 0) {
-        std::cerr << "Server closed the connection prematurely." << std::endl;
+    return true;
+}
+
+
+bool ClientProcessingEngine::requestServerID() {
+    std::lock_guard<std::mutex> lock(socketMutex);
+
+    std::string replyData;
+    HelloReply reply;
+    if (!sendFrame("HELLO") || !receiveFrame(replyData) || !reply.ParseFromString(replyData)) {
         return false;
     }
 
+    serverID = reply.server_id();
     return true;
 }
 
-IndexResult ClientProcessingEngine::indexFolder(std::string folderPath) {
+
+IndexResult ClientProcessingEngine::indexFolder(std::string folderPath, const WalkFilters& filters) {
     IndexResult result = {0.0, 0};
     auto indexingStartTime = std::chrono::steady_clock::now();
     std::queue<std::string> fileQueue;
     std::mutex fileQueueMutex;
     std::condition_variable cv;
+    std::condition_variable queueNotFull;
     std::vector<std::thread> threads; 
     bool isDone = false;
-
-    // Load files into the queue
-    for (const auto& file : std::filesystem::recursive_directory_iterator(folderPath)) {
-        if (file.is_regular_file()) {
-            std::lock_guard<std::mutex> lock(fileQueueMutex);
-            fileQueue.push(file.path().string());
-        }
+    std::atomic<long> totalBytesRead = 0;
+    std::atomic<long> filesIndexed = 0;
+    std::atomic<long> filesUnchanged = 0;
+
+    // without a server id there is no telling whether the server still has what the manifest says
+    std::unique_ptr<IndexManifest> manifest;
+    if (!serverID.empty()) {
+        manifest = std::make_unique<IndexManifest>(IndexManifest::pathFor(folderPath, serverEndpoint), serverID);
+        manifest->load();
     }
 
     // Worker thread function
     auto worker = [&]() {
+        // per thread buffers, reused for every file this thread indexes
+        WordCounter wordCounter;
+        std::string content;
+        std::string frame;
+
         while (true) {
             std::string filePath;
 
@@ -122,29 +360,69 @@ IndexResult ClientProcessingEngine::indexFolder(std::string folderPath) {
                     continue;
                 }
 
-                filePath = fileQueue.front();
+                filePath = std::move(fileQueue.front());
                 fileQueue.pop();
             }
+            queueNotFull.notify_one();
 
             if (!filePath.empty()) {
-                std::ifstream file(filePath);
+                // looked up first, so a file that cannot be read now is not taken as deleted
+                std::optional<ManifestEntry> previous;
+                if (manifest) {
+                    previous = manifest->find(filePath);
+                }
+
+                struct stat status;
+                if (stat(filePath.c_str(), &status) != 0) {
+                    std::cout << "Cannot open the file: " << filePath << std::endl;
+                    continue;
+                }
+                size_t fileSize = status.st_size;
+                int64_t modifiedTime = status.st_mtim.tv_sec * 1000000000LL + status.st_mtim.tv_nsec;
+
+                // same size and modification time as last run: the server already has this file
+                if (previous && previous->size == fileSize && previous->modifiedTime == modifiedTime) {
+                    filesUnchanged++;
+                    continue;
+                }
+
+                std::ifstream file(filePath, std::ios::binary);
                 if (!file) {
                     std::cout << "Cannot open the file: " << filePath << std::endl;
                     continue;
                 }
 
-                std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-                auto wordFrequency = extractWords(content);
+                uint64_t contentHash;
+                if (fileSize >= LARGE_FILE_THRESHOLD) {
+                    if (!countLargeFile(filePath, fileSize, wordCounter, contentHash)) {
+                        std::cout << "Cannot read the file: " << filePath << std::endl;
+                        continue;
+                    }
+                } else {
+                    // the counter keeps views into content, so it is only reused after the frame is built
+                    content.resize(fileSize);
+                    file.read(content.data(), content.size());
+                    content.resize(file.gcount());
+                    contentHash = IndexManifest::hashContent(content);
+                    extractWords(content, wordCounter);
+                }
 
-                IndexRequest request;
-                request.set_client_id(generateClientID());
-                request.set_document_path(filePath);
-                for (const auto& pair : wordFrequency) {
-                    (*request.mutable_word_frequencies())[pair.first] = pair.second; // Populate the word frequencies map
+                // touched but not modified, only the manifest needs the new time
+                if (previous && previous->size == fileSize && previous->contentHash == contentHash) {
+                    manifest->update(filePath, {fileSize, modifiedTime, contentHash, previous->documentNumber});
+                    filesUnchanged++;
+                    continue;
                 }
 
-                if (sendIndexRequest(request)) {
-                    result.totalBytesRead += content.size(); // Accumulate total bytes read
+                buildIndexFrame(frame, generateClientID(), filePath, previous ? previous->documentNumber : 0, wordCounter);
+
+                long documentNumber = sendIndexFrame(frame);
+                if (documentNumber > 0) {
+                    totalBytesRead += fileSize; // Accumulate total bytes read
+                    filesIndexed++;
+                    if (manifest) {
+                        manifest->update(filePath, {fileSize, modifiedTime, contentHash, documentNumber});
+                    }
                 } else {
                     std::cerr << "Failed to send index request" << std::endl;
                 }
@@ -152,10 +430,24 @@ IndexResult ClientProcessingEngine::indexFolder(std::string folderPath) {
         }
     };
 
+    // Workers start right away and index files while the walk is still discovering them
     for (int i = 0; i < 6; i++) {
         threads.emplace_back(worker);
     }
 
+    DirectoryWalker walker(filters, WALKER_THREADS);
+    bool walked = walker.walk(folderPath, [&](std::string&& filePath) {
+        {
+            std::unique_lock<std::mutex> lock(fileQueueMutex);
+            queueNotFull.wait(lock, [&]() { return fileQueue.size() < MAX_QUEUED_FILES; });
+            fileQueue.push(std::move(filePath));
+        }
+        cv.notify_one();
+    });
+    if (!walked) {
+        std::cout << "Cannot open the folder: " << folderPath << std::endl;
+    }
+
     // Notify threads when work is done
     {
         std::lock_guard<std::mutex> lock(fileQueueMutex);
@@ -168,6 +460,27 @@ IndexResult ClientProcessingEngine::indexFolder(std::string folderPath) {
         thread.join();
     }
 
+    // files the manifest knows but the walk did not find anymore are deleted on the server,
+    // unless part of the folder could not be read and they may well still be there; files
+    // the filters of this run leave out are kept as indexed by an earlier one
+    if (manifest && walked && walker.errorCount() == 0) {
+        std::vector<long> documentNumbers;
+        auto inScope = [&walker, &folderPath](const std::string& documentPath) { return walker.passesFilters(folderPath, documentPath); };
+        for (const auto& [documentPath, entry] : manifest->takeMissing(inScope)) {
+            documentNumbers.push_back(entry.documentNumber);
+        }
+        if (!documentNumbers.empty() && sendDeleteRequest(documentNumbers)) {
+            result.filesDeleted = documentNumbers.size();
+        }
+    }
+    if (manifest) {
+        manifest->save();
+    }
+
+    result.totalBytesRead = totalBytesRead;
+    result.filesIndexed = filesIndexed;
+    result.filesUnchanged = filesUnchanged;
+
     auto indexingStopTime = std::chrono::steady_clock::now();
     result.executionTime = std::chrono::duration_cast<std::chrono::seconds>(indexingStopTime - indexingStartTime).count();
 
@@ -201,6 +514,11 @@ bool ClientProcessingEngine::connectToServer(std::string serverIP, std::string s
 
     std::string newClientId = generateClientID();
     clientMap[clientSocket] = {newClientId, clientSocket}; 
+
+    serverEndpoint = serverIP + ":" + serverPort;
+    if (!requestServerID()) {
+        std::cerr << "Server did not send its id, every index command will send all files" << std::endl;
+    }
     return true;
 }
 
@@ -228,62 +546,61 @@ void ClientProcessingEngine::disconnect() {
 }
 
 
-SearchResult ClientProcessingEngine::sendMessageAndReceiveResponse(const std::string& message) {
+SearchResult ClientProcessingEngine::sendMessageAndReceiveResponse(const std::string& message, const SearchOptions& options) {
     const std::string prefix = "SEARCH:";
     
     std::string prefixedMessage = prefix + message;
+    std::lock_guard<std::mutex> lock(socketMutex);
 
-    // Create a buffer for sending the message size and data
-    uint32_t messageSize = htonl(static_cast<uint32_t>(prefixedMessage.size())); // Convert size to network byte order
-    char buffer[sizeof(messageSize) + prefixedMessage.size()];
-
-    memcpy(buffer, &messageSize, sizeof(messageSize));
-    memcpy(buffer + sizeof(messageSize), prefixedMessage.data(), prefixedMessage.size());
-
-    // Send the buffer to the server
-    ssize_t bytesSent = send(clientSocket, buffer, sizeof(messageSize) + prefixedMessage.size(), 0);
-    if (bytesSent < 0) {
-        std::cerr << "Error sending message: " << strerror(errno) << std::endl;
-        return {}; 
-    }
-
-    // Receive the response size first
-    uint32_t responseSize;
-    ssize_t bytesReceived = recv(clientSocket, &responseSize, sizeof(responseSize), 0);
-    if (bytesReceived < 0) {
-        std::cerr << "Error receiving response size: " << strerror(errno) << std::endl;
+    SearchResult result;
+    if (!sendFrame(prefixedMessage) || !receiveSearchReply(result, options)) {
         return {};
     }
+    return result; 
+}
 
 
+// a large page comes in several replies, all but the last flagged more_chunks
+bool ClientProcessingEngine::receiveSearchReply(SearchResult& result, const SearchOptions& options) {
+    std::vector<DocPathFreqPair> documents;
+    bool moreChunks = true;
+    while (moreChunks) {
+        std::string response;
+        if (!receiveFrame(response)) {
+            return false;
+        }
 
-    responseSize = ntohl(responseSize); // Converting response size from network byte order
-
-
-    // If no docs found return empty object
-    if (!responseSize) {
-        return {}; 
-    }
+        // Deserialize the response
+        SearchReply searchReply;
+        if (!searchReply.ParseFromString(response)) {
+            std::cerr << "Received response size: " << response.size() << std::endl;
+            std::cerr << "Failed to parse SearchReply." << std::endl;
+            return false;
+        }
+        moreChunks = searchReply.more_chunks();
 
-    std::string response(responseSize, '\0');
-    bytesReceived = recv(clientSocket, &response[0], responseSize, 0);
-    if (bytesReceived < 0) {
-        std::cerr << "Error receiving response data: " << strerror(errno) << std::endl;
-        return {}; 
+        SearchResult chunk = fromSearchReply(searchReply);
+        if (options.onDocuments) {
+            options.onDocuments(chunk.documentFrequencies);
+        } else {
+            documents.insert(documents.end(), chunk.documentFrequencies.begin(), chunk.documentFrequencies.end());
+        }
+        // every chunk repeats the totals of the page
+        result = std::move(chunk);
     }
 
+    result.documentFrequencies = std::move(documents);
+    return true;
+}
 
-    // Deserialize the response
-    SearchReply searchReply;
-    if (!searchReply.ParseFromString(response)) {
-        std::cerr << "Received response size: " << response.size() << std::endl;
-        std::cerr << "Response content: " << response << std::endl; // Inspect the raw response
-        std::cerr << "Failed to parse SearchReply." << std::endl;
-        return {};
-    }
 
+SearchResult ClientProcessingEngine::fromSearchReply(const SearchReply& searchReply) {
     SearchResult result;
     result.executionTime = searchReply.execution_time();
+    result.totalResults = searchReply.total_results();
+    result.totalIsEstimate = searchReply.total_is_estimate();
+    result.continuationToken = searchReply.continuation_token();
+    result.partial = searchReply.partial();
 
 
     for (const auto& doc : searchReply.documents()) {
@@ -291,6 +608,7 @@ SearchResult ClientProcessingEngine::sendMessageAndReceiveResponse(const std::st
         docFrequency.documentPath = doc.document_path();
         docFrequency.wordFrequency = doc.frequency();
         docFrequency.origin = doc.client_id();
+        docFrequency.score = doc.score();
         result.documentFrequencies.push_back(docFrequency);
     }
 
@@ -298,17 +616,43 @@ SearchResult ClientProcessingEngine::sendMessageAndReceiveResponse(const std::st
 }
 
 
-SearchResult ClientProcessingEngine::search(std::vector<std::string> terms) {
-    SearchResult result = {0.0, {}}; 
+SearchResult ClientProcessingEngine::search(std::vector<std::string> terms, const SearchOptions& options) {
+    SearchRequest request;
+    for (const auto& term : terms) {
+        request.add_terms(term); 
+    }
+    return sendSearchRequest(request, options);
+}
+
+SearchResult ClientProcessingEngine::search(const QueryNode& query, const SearchOptions& options) {
+    SearchRequest request;
+    *request.mutable_query() = query;
+    return sendSearchRequest(request, options);
+}
+
+// the options of a single search and of every search in a batch
+void ClientProcessingEngine::applySearchOptions(SearchRequest& request, const SearchOptions& options) {
+    request.set_k(options.topResults);
+    request.set_ranking(options.bm25 ? SearchRequest::BM25 : SearchRequest::FREQUENCY);
+    request.set_offset(options.offset);
+    request.set_continuation_token(options.continuationToken);
+    request.set_time_budget_ms(options.timeBudgetMs);
+    if (options.mode == SearchMode::COUNT) {
+        request.set_mode(SearchRequest::COUNT);
+    } else if (options.mode == SearchMode::EXISTS) {
+        request.set_mode(SearchRequest::EXISTS);
+    }
+}
+
+SearchResult ClientProcessingEngine::sendSearchRequest(SearchRequest& request, const SearchOptions& options) {
+    SearchResult result;
 
 
     auto searchStartTime = std::chrono::steady_clock::now();
 
 
-    SearchRequest request;
-    for (const auto& term : terms) {
-        request.add_terms(term); 
-    }
+    applySearchOptions(request, options);
+    request.set_chunk_size(SEARCH_CHUNK_DOCUMENTS);
 
 
     std::string serializedRequest;
@@ -318,7 +662,7 @@ SearchResult ClientProcessingEngine::search(std::vector<std::string> terms) {
     }
 
 
-    result = sendMessageAndReceiveResponse(serializedRequest); 
+    result = sendMessageAndReceiveResponse(serializedRequest, options); 
 
 
     if (result.documentFrequencies.empty() && result.executionTime == 0.0) {
@@ -331,3 +675,28 @@ SearchResult ClientProcessingEngine::search(std::vector<std::string> terms) {
 
     return result;
 }
+
+
+std::vector<SearchResult> ClientProcessingEngine::searchBatch(const std::vector<QueryNode>& queries, const SearchOptions& options) {
+    BatchSearchRequest batchRequest;
+    for (const QueryNode& query : queries) {
+        SearchRequest* request = batchRequest.add_searches();
+        *request->mutable_query() = query;
+        applySearchOptions(*request, options);
+        request->set_chunk_size(SEARCH_CHUNK_DOCUMENTS);
+    }
+
+    // the replies of the searches follow each other, every one chunked as a single search's
+    std::lock_guard<std::mutex> lock(socketMutex);
+    if (!sendFrame("BATCH:" + batchRequest.SerializeAsString())) {
+        return {};
+    }
+
+    std::vector<SearchResult> results(queries.size());
+    for (SearchResult& result : results) {
+        if (!receiveSearchReply(result, options)) {
+            return {};
+        }
+    }
+    return results;
+}
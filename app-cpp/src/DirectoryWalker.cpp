@@ -0,0 +1,196 @@
+#include "DirectoryWalker.hpp"
+
+#include <iostream>
+#include <thread>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    // directories opened ahead of time wait in the queue with their descriptor, above this
+    // many they are queued by path instead so huge trees do not run out of descriptors
+    constexpr size_t MAX_QUEUED_DIRECTORY_FDS = 256;
+    constexpr size_t DIRENT_BUFFER_SIZE = 64 * 1024;
+
+    std::string joinPath(const std::string &parent, const char *name) {
+        if (parent.empty()) {
+            return name;
+        }
+        if (parent.back() == '/') {
+            return parent + name;
+        }
+        return parent + "/" + name;
+    }
+}
+
+DirectoryWalker::DirectoryWalker(WalkFilters filters, int threadCount) : filters(std::move(filters)), threadCount(threadCount) {}
+
+bool DirectoryWalker::matchesAny(const std::vector<std::string> &patterns, const std::string &name, const std::string &relativePath) const {
+    for (const auto &pattern : patterns) {
+        if (fnmatch(pattern.c_str(), name.c_str(), 0) == 0 || fnmatch(pattern.c_str(), relativePath.c_str(), 0) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool DirectoryWalker::passesFilters(const std::string &rootPath, const std::string &filePath) const {
+    std::string prefix = rootPath.ends_with('/') ? rootPath : rootPath + "/";
+    if (!filePath.starts_with(prefix)) {
+        return true;
+    }
+
+    // every directory on the way is tested against the exclusions, as the walk does
+    std::string relativePath = filePath.substr(prefix.size());
+    for (size_t end = relativePath.find('/');; end = relativePath.find('/', end + 1)) {
+        std::string path = relativePath.substr(0, end);
+        std::string name = path.substr(path.rfind('/') + 1);
+        if (matchesAny(filters.excludePatterns, name, path)) {
+            return false;
+        }
+        if (end == std::string::npos) {
+            return filters.includePatterns.empty() || matchesAny(filters.includePatterns, name, path);
+        }
+    }
+}
+
+void DirectoryWalker::processDirectory(DirectoryTask task, const std::function<void(std::string &&)> &onFile) {
+    int directoryFd = task.directoryFd;
+    if (directoryFd >= 0) {
+        queuedDirectoryFds--;
+    } else {
+        directoryFd = open(task.path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (directoryFd < 0) {
+            std::cerr << "Cannot open the directory: " << task.path << std::endl;
+            failedDirectories++;
+            return;
+        }
+    }
+
+    alignas(struct dirent64) char buffer[DIRENT_BUFFER_SIZE];
+    std::vector<DirectoryTask> subdirectories;
+
+    while (true) {
+        ssize_t bytesRead = getdents64(directoryFd, buffer, sizeof(buffer));
+        if (bytesRead < 0) {
+            std::cerr << "Cannot read the directory: " << task.path << ": " << strerror(errno) << std::endl;
+            failedDirectories++;
+            break;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < bytesRead;) {
+            auto *entry = reinterpret_cast<struct dirent64 *>(buffer + offset);
+            offset += entry->d_reclen;
+
+            const char *name = entry->d_name;
+            if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) {
+                continue;
+            }
+
+            // only entries the file system could not classify, and symlinks, need a stat;
+            // symlinks to files are indexed but symlinked directories are not followed
+            bool isDirectory = entry->d_type == DT_DIR;
+            bool isFile = entry->d_type == DT_REG;
+            if (entry->d_type == DT_UNKNOWN || entry->d_type == DT_LNK) {
+                struct stat status;
+                int flags = entry->d_type == DT_UNKNOWN ? AT_SYMLINK_NOFOLLOW : 0;
+                if (fstatat(directoryFd, name, &status, flags) == 0) {
+                    isDirectory = entry->d_type == DT_UNKNOWN && S_ISDIR(status.st_mode);
+                    isFile = S_ISREG(status.st_mode);
+                }
+            }
+            if (!isDirectory && !isFile) {
+                continue;
+            }
+
+            std::string entryName = name;
+            std::string relativePath = joinPath(task.relativePath, name);
+            if (matchesAny(filters.excludePatterns, entryName, relativePath)) {
+                continue;
+            }
+
+            if (isDirectory) {
+                int subdirectoryFd = -1;
+                if (queuedDirectoryFds < MAX_QUEUED_DIRECTORY_FDS) {
+                    subdirectoryFd = openat(directoryFd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+                    if (subdirectoryFd >= 0) {
+                        queuedDirectoryFds++;
+                    }
+                }
+                subdirectories.push_back({subdirectoryFd, joinPath(task.path, name), std::move(relativePath)});
+            } else if (filters.includePatterns.empty() || matchesAny(filters.includePatterns, entryName, relativePath)) {
+                onFile(joinPath(task.path, name));
+            }
+        }
+    }
+
+    close(directoryFd);
+
+    if (!subdirectories.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(tasksMutex);
+            for (auto &subdirectory : subdirectories) {
+                tasks.push_back(std::move(subdirectory));
+            }
+            pendingTasks += subdirectories.size();
+        }
+        tasksCv.notify_all();
+    }
+}
+
+void DirectoryWalker::runThread(const std::function<void(std::string &&)> &onFile) {
+    while (true) {
+        DirectoryTask task;
+        {
+            std::unique_lock<std::mutex> lock(tasksMutex);
+            tasksCv.wait(lock, [&]() { return !tasks.empty() || pendingTasks == 0; });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        processDirectory(std::move(task), onFile);
+
+        bool walkFinished;
+        {
+            std::lock_guard<std::mutex> lock(tasksMutex);
+            walkFinished = --pendingTasks == 0;
+        }
+        if (walkFinished) {
+            tasksCv.notify_all();
+        }
+    }
+}
+
+bool DirectoryWalker::walk(const std::string &rootPath, const std::function<void(std::string &&)> &onFile) {
+    int rootFd = open(rootPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (rootFd < 0) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        queuedDirectoryFds++;
+        tasks.push_back({rootFd, rootPath, ""});
+        pendingTasks = 1;
+    }
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < threadCount; i++) {
+        threads.emplace_back(&DirectoryWalker::runThread, this, std::cref(onFile));
+    }
+    runThread(onFile);
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    return true;
+}
@@ -0,0 +1,337 @@
+#include "DocumentBitmap.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    constexpr size_t CONTAINER_WORDS = 65536 / 64;
+    constexpr size_t RANK_STRIDE = 16;
+}
+
+bool DocumentBitmap::Container::add(uint16_t low) {
+    if (isBitmap()) {
+        uint64_t bit = 1ULL << (low % 64);
+        uint64_t &word = words[low / 64];
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        for (size_t block = low / 64 / RANK_STRIDE + 1; block < wordRanks.size(); block++) {
+            wordRanks[block]++;
+        }
+        cardinality++;
+        return true;
+    }
+
+    auto position = std::lower_bound(values.begin(), values.end(), low);
+    if (position != values.end() && *position == low) {
+        return false;
+    }
+    values.insert(position, low);
+    cardinality++;
+    if (values.size() > ARRAY_LIMIT) {
+        toBitmap();
+    }
+    return true;
+}
+
+bool DocumentBitmap::Container::contains(uint16_t low) const {
+    if (isBitmap()) {
+        return (words[low / 64] >> (low % 64)) & 1;
+    }
+    return std::binary_search(values.begin(), values.end(), low);
+}
+
+// documents of the container below low
+uint32_t DocumentBitmap::Container::rank(uint16_t low) const {
+    if (!isBitmap()) {
+        return std::lower_bound(values.begin(), values.end(), low) - values.begin();
+    }
+    size_t word = low / 64;
+    size_t block = word / RANK_STRIDE;
+    uint32_t rank = wordRanks[block];
+    for (size_t i = block * RANK_STRIDE; i < word; i++) {
+        rank += __builtin_popcountll(words[i]);
+    }
+    return rank + __builtin_popcountll(words[word] & ((1ULL << (low % 64)) - 1));
+}
+
+// first low value >= low, -1 if there is none
+int DocumentBitmap::Container::nextAtLeast(uint32_t low) const {
+    if (!isBitmap()) {
+        auto position = std::lower_bound(values.begin(), values.end(), low);
+        return position == values.end() ? -1 : *position;
+    }
+    for (size_t word = low / 64; word < CONTAINER_WORDS; word++) {
+        uint64_t bits = words[word];
+        if (word == low / 64) {
+            bits &= ~0ULL << (low % 64);
+        }
+        if (bits != 0) {
+            return word * 64 + __builtin_ctzll(bits);
+        }
+    }
+    return -1;
+}
+
+void DocumentBitmap::Container::toBitmap() {
+    words = toWords();
+    values.clear();
+    values.shrink_to_fit();
+    rebuildWordRanks();
+}
+
+void DocumentBitmap::Container::rebuildWordRanks() {
+    wordRanks.assign(CONTAINER_WORDS / RANK_STRIDE, 0);
+    uint32_t rank = 0;
+    for (size_t word = 0; word < CONTAINER_WORDS; word++) {
+        if (word % RANK_STRIDE == 0) {
+            wordRanks[word / RANK_STRIDE] = rank;
+        }
+        rank += __builtin_popcountll(words[word]);
+    }
+}
+
+std::vector<uint64_t> DocumentBitmap::Container::toWords() const {
+    if (isBitmap()) {
+        return words;
+    }
+    std::vector<uint64_t> result(CONTAINER_WORDS, 0);
+    for (uint16_t low : values) {
+        result[low / 64] |= 1ULL << (low % 64);
+    }
+    return result;
+}
+
+// container holding the set bits of words, as an array when few enough bits are set
+DocumentBitmap::Container DocumentBitmap::Container::fromWords(uint16_t key, std::vector<uint64_t> words) {
+    Container container;
+    container.key = key;
+    for (uint64_t word : words) {
+        container.cardinality += __builtin_popcountll(word);
+    }
+
+    if (container.cardinality > ARRAY_LIMIT) {
+        container.words = std::move(words);
+        container.rebuildWordRanks();
+        return container;
+    }
+
+    container.values.reserve(container.cardinality);
+    for (size_t word = 0; word < words.size(); word++) {
+        for (uint64_t bits = words[word]; bits != 0; bits &= bits - 1) {
+            container.values.push_back(word * 64 + __builtin_ctzll(bits));
+        }
+    }
+    return container;
+}
+
+const DocumentBitmap::Container *DocumentBitmap::findContainer(uint16_t key) const {
+    auto position = std::lower_bound(containers.begin(), containers.end(), key,
+                                     [](const Container &container, uint16_t key) { return container.key < key; });
+    return position != containers.end() && position->key == key ? &*position : nullptr;
+}
+
+void DocumentBitmap::updateRanks() {
+    uint32_t rank = 0;
+    for (Container &container : containers) {
+        container.rankBefore = rank;
+        rank += container.cardinality;
+    }
+}
+
+bool DocumentBitmap::add(uint32_t document) {
+    uint16_t key = document >> 16;
+
+    // documents mostly arrive in increasing order and land in the last container
+    auto position = containers.end();
+    if (containers.empty() || containers.back().key < key) {
+        Container container;
+        container.key = key;
+        container.rankBefore = containers.empty() ? 0 : containers.back().rankBefore + containers.back().cardinality;
+        position = containers.insert(containers.end(), std::move(container));
+    } else if (containers.back().key == key) {
+        position = containers.end() - 1;
+    } else {
+        position = std::lower_bound(containers.begin(), containers.end(), key,
+                                    [](const Container &container, uint16_t key) { return container.key < key; });
+        if (position->key != key) {
+            Container container;
+            container.key = key;
+            position = containers.insert(position, std::move(container));
+        }
+    }
+
+    if (!position->add(document & 0xFFFF)) {
+        return false;
+    }
+    if (position + 1 != containers.end()) {
+        updateRanks();
+    }
+    return true;
+}
+
+bool DocumentBitmap::contains(uint32_t document) const {
+    const Container *container = findContainer(document >> 16);
+    return container != nullptr && container->contains(document & 0xFFFF);
+}
+
+long DocumentBitmap::indexOf(uint32_t document) const {
+    const Container *container = findContainer(document >> 16);
+    if (container == nullptr || !container->contains(document & 0xFFFF)) {
+        return -1;
+    }
+    return container->rankBefore + container->rank(document & 0xFFFF);
+}
+
+uint32_t DocumentBitmap::nextAtLeast(uint32_t document) const {
+    uint16_t key = document >> 16;
+    auto position = std::lower_bound(containers.begin(), containers.end(), key,
+                                     [](const Container &container, uint16_t key) { return container.key < key; });
+
+    for (; position != containers.end(); ++position) {
+        uint32_t low = position->key == key ? document & 0xFFFF : 0;
+        int next = position->nextAtLeast(low);
+        if (next >= 0) {
+            return (static_cast<uint32_t>(position->key) << 16) | next;
+        }
+    }
+    return END;
+}
+
+size_t DocumentBitmap::cardinality() const {
+    return containers.empty() ? 0 : containers.back().rankBefore + containers.back().cardinality;
+}
+
+DocumentBitmap::RankCursor::RankCursor(const DocumentBitmap &bitmap) : bitmap(bitmap) {}
+
+long DocumentBitmap::RankCursor::indexOf(uint32_t document) {
+    const std::vector<Container> &containers = bitmap.containers;
+    uint16_t key = document >> 16;
+    uint16_t low = document & 0xFFFF;
+
+    while (container < containers.size() && containers[container].key < key) {
+        container++;
+        offset = 0;
+        offsetRank = 0;
+    }
+    if (container == containers.size() || containers[container].key != key) {
+        return -1;
+    }
+
+    const Container &current = containers[container];
+    if (!current.isBitmap()) {
+        offset = std::lower_bound(current.values.begin() + offset, current.values.end(), low) - current.values.begin();
+        if (offset == current.values.size() || current.values[offset] != low) {
+            return -1;
+        }
+        return current.rankBefore + offset;
+    }
+
+    size_t word = low / 64;
+    for (; offset < word; offset++) {
+        offsetRank += __builtin_popcountll(current.words[offset]);
+    }
+    uint64_t bit = 1ULL << (low % 64);
+    if (!(current.words[word] & bit)) {
+        return -1;
+    }
+    return current.rankBefore + offsetRank + __builtin_popcountll(current.words[word] & (bit - 1));
+}
+
+DocumentBitmap DocumentBitmap::fromSorted(const uint32_t *documents, size_t size) {
+    DocumentBitmap bitmap;
+    for (size_t i = 0; i < size; i++) {
+        bitmap.add(documents[i]);
+    }
+    return bitmap;
+}
+
+DocumentBitmap DocumentBitmap::intersect(const DocumentBitmap &a, const DocumentBitmap &b) {
+    DocumentBitmap result;
+    auto left = a.containers.begin();
+    auto right = b.containers.begin();
+
+    while (left != a.containers.end() && right != b.containers.end()) {
+        if (left->key < right->key) {
+            ++left;
+            continue;
+        }
+        if (right->key < left->key) {
+            ++right;
+            continue;
+        }
+
+        Container container;
+        if (left->isBitmap() && right->isBitmap()) {
+            std::vector<uint64_t> words(CONTAINER_WORDS);
+            for (size_t word = 0; word < CONTAINER_WORDS; word++) {
+                words[word] = left->words[word] & right->words[word];
+            }
+            container = Container::fromWords(left->key, std::move(words));
+        } else if (left->isBitmap() || right->isBitmap()) {
+            // the array side is at most ARRAY_LIMIT values, each probed in the bitmap
+            const Container &array = left->isBitmap() ? *right : *left;
+            const Container &bitmap = left->isBitmap() ? *left : *right;
+            container.key = left->key;
+            for (uint16_t low : array.values) {
+                if (bitmap.contains(low)) {
+                    container.values.push_back(low);
+                }
+            }
+            container.cardinality = container.values.size();
+        } else {
+            container.key = left->key;
+            std::set_intersection(left->values.begin(), left->values.end(), right->values.begin(), right->values.end(),
+                                  std::back_inserter(container.values));
+            container.cardinality = container.values.size();
+        }
+
+        if (container.cardinality > 0) {
+            result.containers.push_back(std::move(container));
+        }
+        ++left;
+        ++right;
+    }
+
+    result.updateRanks();
+    return result;
+}
+
+DocumentBitmap DocumentBitmap::unite(const DocumentBitmap &a, const DocumentBitmap &b) {
+    DocumentBitmap result;
+    auto left = a.containers.begin();
+    auto right = b.containers.begin();
+
+    while (left != a.containers.end() || right != b.containers.end()) {
+        if (right == b.containers.end() || (left != a.containers.end() && left->key < right->key)) {
+            result.containers.push_back(*left++);
+            continue;
+        }
+        if (left == a.containers.end() || right->key < left->key) {
+            result.containers.push_back(*right++);
+            continue;
+        }
+
+        Container container;
+        if (!left->isBitmap() && !right->isBitmap() && left->cardinality + right->cardinality <= ARRAY_LIMIT) {
+            container.key = left->key;
+            std::set_union(left->values.begin(), left->values.end(), right->values.begin(), right->values.end(),
+                           std::back_inserter(container.values));
+            container.cardinality = container.values.size();
+        } else {
+            std::vector<uint64_t> words = left->toWords();
+            std::vector<uint64_t> otherWords = right->toWords();
+            for (size_t word = 0; word < CONTAINER_WORDS; word++) {
+                words[word] |= otherWords[word];
+            }
+            container = Container::fromWords(left->key, std::move(words));
+        }
+        result.containers.push_back(std::move(container));
+        ++left;
+        ++right;
+    }
+
+    result.updateRanks();
+    return result;
+}
@@ -0,0 +1,148 @@
+#include "IndexManifest.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    const std::string MANIFEST_HEADER = "file-retrieval-manifest 1";
+
+    constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+
+    uint64_t rotateLeft(uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+}
+
+IndexManifest::IndexManifest(std::string manifestPath, std::string serverID) : manifestPath(std::move(manifestPath)), serverID(std::move(serverID)) {}
+
+uint64_t IndexManifest::hashContent(std::string_view content) {
+    uint64_t hash = content.size() * PRIME_1;
+    size_t position = 0;
+
+    // eight bytes per step, this runs over every changed file
+    for (; position + sizeof(uint64_t) <= content.size(); position += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, content.data() + position, sizeof(word));
+        hash = rotateLeft(hash ^ (word * PRIME_1), 31) * PRIME_2;
+    }
+    if (position < content.size()) {
+        uint64_t word = 0;
+        memcpy(&word, content.data() + position, content.size() - position);
+        hash = rotateLeft(hash ^ (word * PRIME_1), 31) * PRIME_2;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+std::string IndexManifest::pathFor(const std::string &folderPath, const std::string &serverAddress) {
+    std::error_code error;
+    std::filesystem::path folder = std::filesystem::absolute(folderPath, error).lexically_normal();
+    std::string key = serverAddress + "\n" + folder.string();
+
+    std::ostringstream fileName;
+    fileName << std::hex << hashContent(key) << ".manifest";
+
+    const char *home = std::getenv("HOME");
+    std::filesystem::path directory = home ? std::filesystem::path(home) : std::filesystem::path(".");
+    return (directory / ".file-retrieval-engine" / "manifests" / fileName.str()).string();
+}
+
+void IndexManifest::load() {
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    entries.clear();
+
+    std::ifstream file(manifestPath);
+    if (!file) {
+        return;
+    }
+
+    std::string line;
+    if (!std::getline(file, line) || line != MANIFEST_HEADER + " " + serverID) {
+        return;
+    }
+
+    // documentNumber size modifiedTime contentHash path, tab separated with the path last
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        ManifestEntry entry;
+        std::string documentPath;
+
+        fields >> entry.documentNumber >> entry.size >> entry.modifiedTime >> std::hex >> entry.contentHash;
+        if (!fields || fields.get() != '\t' || !std::getline(fields, documentPath) || documentPath.empty()) {
+            continue;
+        }
+        entries[documentPath] = {entry, false};
+    }
+}
+
+bool IndexManifest::save() {
+    std::lock_guard<std::mutex> lock(entriesMutex);
+
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(manifestPath).parent_path(), error);
+
+    // write a new file and rename it over the old one so a crash never leaves half a manifest
+    std::string temporaryPath = manifestPath + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::trunc);
+        if (!file) {
+            std::cerr << "Cannot write the index manifest: " << temporaryPath << std::endl;
+            return false;
+        }
+
+        file << MANIFEST_HEADER << " " << serverID << "\n";
+        for (const auto &[documentPath, tracked] : entries) {
+            if (documentPath.find('\n') != std::string::npos) {
+                continue;
+            }
+            const ManifestEntry &entry = tracked.entry;
+            file << entry.documentNumber << '\t' << entry.size << '\t' << entry.modifiedTime << '\t'
+                 << std::hex << entry.contentHash << std::dec << '\t' << documentPath << "\n";
+        }
+        if (!file.flush()) {
+            std::cerr << "Cannot write the index manifest: " << temporaryPath << std::endl;
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporaryPath, manifestPath, error);
+    return !error;
+}
+
+std::optional<ManifestEntry> IndexManifest::find(const std::string &documentPath) {
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    auto itr = entries.find(documentPath);
+    if (itr == entries.end()) {
+        return std::nullopt;
+    }
+    itr->second.seen = true;
+    return itr->second.entry;
+}
+
+void IndexManifest::update(const std::string &documentPath, const ManifestEntry &entry) {
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    entries[documentPath] = {entry, true};
+}
+
+std::vector<std::pair<std::string, ManifestEntry>> IndexManifest::takeMissing(const std::function<bool(const std::string &)> &inScope) {
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    std::vector<std::pair<std::string, ManifestEntry>> missing;
+
+    for (auto itr = entries.begin(); itr != entries.end();) {
+        if (itr->second.seen || !inScope(itr->first)) {
+            ++itr;
+            continue;
+        }
+        missing.emplace_back(itr->first, itr->second.entry);
+        itr = entries.erase(itr);
+    }
+    return missing;
+}
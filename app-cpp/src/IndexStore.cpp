@@ -4,29 +4,218 @@
 #include<iostream>
 #include<string>
 #include <mutex>
+#include <chrono>
+#include <charconv>
+#include <functional>
+#include <regex>
+#include <string_view>
 
-IndexStore::IndexStore() {
+#include "LevenshteinAutomaton.hpp"
+
+namespace {
+    // compact once a fifth of the postings belong to deleted documents
+    constexpr long MIN_DEAD_POSTINGS = 100000;
+    constexpr long DEAD_POSTINGS_RATIO = 5;
+    // buckets rewritten per exclusive lock, so indexing and searches get in between
+    constexpr size_t COMPACTION_BATCH_BUCKETS = 1024;
+    // a list holding one in BITMAP_DENSITY documents becomes a bitmap, and goes back to a
+    // list below one in LIST_DENSITY, so a term near the threshold does not keep switching
+    constexpr size_t MIN_BITMAP_POSTINGS = 4096;
+    constexpr size_t BITMAP_DENSITY = 16;
+    constexpr size_t LIST_DENSITY = 64;
+    // the lists of a pattern with at least one posting per this many documents are merged in a dense array
+    constexpr size_t MERGE_DENSITY = 4;
+    // a pattern with a shorter prefix than this asks the trigram index for its terms, when there is one
+    constexpr size_t MIN_DICTIONARY_PREFIX = 3;
+    // a pattern neither a prefix nor trigrams narrow down is refused on a larger dictionary
+    constexpr size_t MAX_UNFILTERED_TERMS = 1 << 20;
+    // terms a pattern tests between two looks at the query budget, a single regular
+    // expression match can backtrack for long so the budget is polled before each one
+    constexpr size_t PATTERN_BUDGET_INTERVAL = 256;
+    // longer regular expressions are refused
+    constexpr size_t MAX_REGEX_LENGTH = 256;
+
+    // '*' matches any characters and '?' one, backtracking to the last '*' on a mismatch
+    bool matchesPattern(std::string_view term, std::string_view pattern) {
+        size_t t = 0;
+        size_t p = 0;
+        size_t starPattern = std::string_view::npos;
+        size_t starTerm = 0;
+        while (t < term.size()) {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == term[t])) {
+                t++;
+                p++;
+            } else if (p < pattern.size() && pattern[p] == '*') {
+                starPattern = p++;
+                starTerm = t;
+            } else if (starPattern != std::string_view::npos) {
+                p = starPattern + 1;
+                t = ++starTerm;
+            } else {
+                return false;
+            }
+        }
+        while (p < pattern.size() && pattern[p] == '*') {
+            p++;
+        }
+        return p == pattern.size();
+    }
+}
+
+IndexStore::IndexStore(bool withTrigramIndex) {
     documentMap = {};
     reverseDocumentMap = {};
     termInvertedIndex = {};
+    if (withTrigramIndex) {
+        trigramIndex.emplace();
+    }
+    compactionThread = std::thread(&IndexStore::runCompaction, this);
+}
+
+IndexStore::~IndexStore() {
+    {
+        std::lock_guard<std::mutex> lock(compactionMutex);
+        stopCompaction = true;
+    }
+    compactionCv.notify_all();
+    compactionThread.join();
 }
 
 
 long IndexStore::putDocument(std::string documentPath, std::string clientName) {
 
     std::lock_guard<std::mutex> lock(documentMapMutex);
-    long documentNumber = documentMap.size() + 1;
+    long documentNumber = nextDocumentNumber++;
     DocumentInfo docInfo = { documentPath, clientName };
     documentMap[documentNumber] = docInfo;
+    liveDocuments++;
 
     return documentNumber;
 }
 
 DocumentInfo  IndexStore::getDocument(long documentNumber) {
 
-    std::string documentPath = "";
+    std::lock_guard<std::mutex> lock(documentMapMutex);
+    auto itr = documentMap.find(documentNumber);
+    if (itr == documentMap.end()) {
+        return {};
+    }
+    return itr->second;
+}
+
+void IndexStore::deleteDocument(long documentNumber) {
+    // The postings of the document stay in the TermInvertedIndex until the next compaction,
+    // marking the document in the deleted bitmap is enough for lookups to skip them
+
+    {
+        std::lock_guard<std::mutex> lock(documentMapMutex);
+        if (documentMap.erase(documentNumber) == 0) {
+            return;
+        }
+        liveDocuments--;
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(deletedDocumentsMutex);
+        size_t word = documentNumber / 64;
+        if (deletedDocuments.size() <= word) {
+            deletedDocuments.resize(word + 1, 0);
+        }
+        deletedDocuments[word] |= 1ULL << (documentNumber % 64);
+    }
+
+    {
+        std::shared_lock<std::shared_mutex> lock(termInvertedIndexMutex);
+        if (static_cast<size_t>(documentNumber) < documentTermCounts.size()) {
+            deadPostings += documentTermCounts[documentNumber];
+            totalDocumentLength -= documentLengths[documentNumber];
+        }
+    }
+    indexGeneration++;
+
+    if (needsCompaction()) {
+        compactionCv.notify_all();
+    }
+}
+
+// callers hold deletedDocumentsMutex
+bool IndexStore::isDeleted(long documentNumber) const {
+    size_t word = documentNumber / 64;
+    return word < deletedDocuments.size() && (deletedDocuments[word] >> (documentNumber % 64)) & 1;
+}
+
+bool IndexStore::needsCompaction() const {
+    return deadPostings >= MIN_DEAD_POSTINGS && deadPostings * DEAD_POSTINGS_RATIO >= totalPostings;
+}
+
+void IndexStore::runCompaction() {
+    std::unique_lock<std::mutex> lock(compactionMutex);
+    while (!stopCompaction) {
+        compactionCv.wait_for(lock, std::chrono::seconds(1), [this]() { return stopCompaction || needsCompaction(); });
+        if (stopCompaction || !needsCompaction()) {
+            continue;
+        }
+
+        lock.unlock();
+        compact();
+        lock.lock();
+    }
+}
+
+void IndexStore::compact() {
+    // Walks the TermInvertedIndex bucket by bucket, taking the lock for a batch of buckets at a
+    // time. A rehash in between can make the pass miss some terms, their dead postings are
+    // still skipped by lookups and get removed by a later pass.
+
+    long removedPostings = 0;
+    size_t bucket = 0;
+
+    while (true) {
+        std::unique_lock<std::shared_mutex> indexLock(termInvertedIndexMutex);
+        std::shared_lock<std::shared_mutex> deletedLock(deletedDocumentsMutex);
 
-    return documentMap[documentNumber];
+        size_t bucketCount = termInvertedIndex.bucket_count();
+        if (bucket >= bucketCount) {
+            break;
+        }
+
+        size_t batchEnd = std::min(bucket + COMPACTION_BATCH_BUCKETS, bucketCount);
+        for (; bucket < batchEnd; bucket++) {
+            for (auto itr = termInvertedIndex.begin(bucket); itr != termInvertedIndex.end(bucket); ++itr) {
+                PostingList &postings = itr->second;
+                removedPostings += postings.removeIf([this](uint32_t documentNumber) {
+                    return isDeleted(documentNumber);
+                }, documentLengths, averageDocumentLength());
+                if (postings.isBitmap() && postings.size() * LIST_DENSITY < static_cast<size_t>(nextDocumentNumber)) {
+                    postings.toList();
+                }
+            }
+        }
+    }
+
+    // terms left without postings are dropped in one final pass
+    {
+        std::unique_lock<std::shared_mutex> indexLock(termInvertedIndexMutex);
+        if (std::erase_if(termInvertedIndex, [](const auto &entry) { return entry.second.empty(); }) > 0) {
+            std::vector<std::string> terms;
+            terms.reserve(termInvertedIndex.size());
+            for (const auto &entry : termInvertedIndex) {
+                terms.push_back(entry.first);
+            }
+            if (trigramIndex) {
+                trigramIndex->assign(terms);
+            }
+            termDictionary.assign(std::move(terms));
+        }
+    }
+
+    totalPostings -= removedPostings;
+    deadPostings -= removedPostings;
+
+    // removed postings change the document frequencies BM25 scores with
+    if (removedPostings > 0) {
+        indexGeneration++;
+    }
 }
 
 
@@ -35,28 +224,253 @@ void IndexStore::updateIndex(long documentNumber, const std::unordered_map<std::
     // TO-DO update the TermInvertedIndex with the word frequencies of the specified document ✅
     // IMPORTANT! you need to make sure that only one thread at a time can access this method ✅
 
-    std::lock_guard<std::mutex> lock(termInvertedIndexMutex);
+    std::unique_lock<std::shared_mutex> lock(termInvertedIndexMutex);
 
+    if (documentTermCounts.size() <= static_cast<size_t>(documentNumber)) {
+        documentTermCounts.resize(documentNumber + 1, 0);
+        documentLengths.resize(documentNumber + 1, 0);
+    }
+    long length = 0;
     for (const auto &wordFrequency : wordFrequencies) {
-        std::string word = wordFrequency.first;
-        long frequency = wordFrequency.second;
+        length += wordFrequency.second;
+    }
+    documentTermCounts[documentNumber] = wordFrequencies.size();
+    documentLengths[documentNumber] = length;
+    totalPostings += wordFrequencies.size();
+    totalDocumentLength += length;
 
-        auto itr = termInvertedIndex.find(word);
-        if (itr != termInvertedIndex.end()) {
-            itr->second.push_back({documentNumber, frequency});
+    size_t bitmapSize = std::max(MIN_BITMAP_POSTINGS, static_cast<size_t>(nextDocumentNumber) / BITMAP_DENSITY);
+    double averageLength = averageDocumentLength();
+    for (const auto &wordFrequency : wordFrequencies) {
+        auto [entry, added] = termInvertedIndex.try_emplace(wordFrequency.first);
+        if (added) {
+            termDictionary.add(wordFrequency.first);
+            if (trigramIndex) {
+                trigramIndex->add(wordFrequency.first);
+            }
         }
-        else{
-            termInvertedIndex[word] = {{documentNumber, frequency}};
+        PostingList &postings = entry->second;
+        postings.add(documentNumber, wordFrequency.second, documentLengths, averageLength);
+        if (!postings.isBitmap() && postings.size() >= bitmapSize) {
+            postings.toBitmap();
         }
     }
+    indexGeneration++;
 }
 
 std::vector<DocFreqPair> IndexStore::lookupIndex(std::string term) {
 
+    std::shared_lock<std::shared_mutex> indexLock(termInvertedIndexMutex);
+    std::shared_lock<std::shared_mutex> deletedLock(deletedDocumentsMutex);
+
     std::vector<DocFreqPair> results = {};
-    if (termInvertedIndex.contains(term)) {
-        results = termInvertedIndex[term];
+    auto itr = termInvertedIndex.find(term);
+    if (itr != termInvertedIndex.end()) {
+        const PostingList &postings = itr->second;
+        results.reserve(postings.size());
+        postings.forEach([&](uint32_t documentNumber, uint32_t frequency) {
+            if (!isDeleted(documentNumber)) {
+                results.push_back({documentNumber, frequency});
+            }
+        });
+    }
+
+    return results;
+}
+
+
+IndexReader::IndexReader(IndexStore &store, QueryBudget *budget)
+    : store(store), budget(budget), indexLock(store.termInvertedIndexMutex), deletedLock(store.deletedDocumentsMutex) {}
+
+const PostingList *IndexReader::findPostings(const std::string &term) const {
+    if (isPattern(term)) {
+        return expandPattern(term);
+    }
+    auto itr = store.termInvertedIndex.find(term);
+    if (itr == store.termInvertedIndex.end()) {
+        return nullptr;
+    }
+    return &itr->second;
+}
+
+bool IndexReader::forEachPatternTerm(const std::string &pattern, const std::function<void(const std::string &)> &function) const {
+    // a fuzzy term is found by walking the dictionary with its automaton
+    if (isFuzzy(pattern)) {
+        size_t tilde = pattern.rfind('~');
+        size_t distance = LevenshteinAutomaton::MAX_DISTANCE;
+        std::from_chars(pattern.data() + tilde + 1, pattern.data() + pattern.size(), distance);
+        store.termDictionary.forEachAccepted(LevenshteinAutomaton(pattern.substr(0, tilde), distance), function);
+        return true;
+    }
+
+    // The terms to test come from the trigram index when it can narrow them down better
+    // than the dictionary can from the prefix, a regular expression has no prefix to use.
+    std::function<bool(const std::string &)> matches;
+    std::string_view prefix;
+    std::regex regex;
+    TrigramQuery filter;
+    size_t budgetInterval = PATTERN_BUDGET_INTERVAL;
+    if (isRegex(pattern)) {
+        std::string_view body = std::string_view(pattern).substr(1, pattern.size() - 2);
+        if (body.size() > MAX_REGEX_LENGTH) {
+            std::cerr << "The regular expression " << pattern.substr(0, 32) << "... is longer than "
+                      << MAX_REGEX_LENGTH << " characters" << std::endl;
+            return false;
+        }
+        try {
+            regex = std::regex(body.begin(), body.end(), std::regex::ECMAScript | std::regex::optimize);
+        } catch (const std::regex_error &error) {
+            std::cerr << "Invalid regular expression " << pattern << ": " << error.what() << std::endl;
+            return false;
+        }
+        matches = [&regex](const std::string &term) { return std::regex_match(term, regex); };
+        budgetInterval = 1;
+        if (store.trigramIndex) {
+            filter = TrigramIndex::fromRegex(body);
+        }
+    } else {
+        matches = [&pattern](const std::string &term) { return matchesPattern(term, pattern); };
+        prefix = std::string_view(pattern).substr(0, pattern.find_first_of("*?"));
+        if (store.trigramIndex && prefix.size() < MIN_DICTIONARY_PREFIX) {
+            filter = TrigramIndex::fromPattern(pattern);
+        }
+    }
+
+    if (filter.matchesAll() && prefix.empty() && store.termDictionary.size() > MAX_UNFILTERED_TERMS) {
+        std::cerr << "The pattern " << pattern << " would test every one of the " << store.termDictionary.size()
+                  << " terms, it needs a prefix or trigrams" << std::endl;
+        return false;
+    }
+
+    // false once the budget ran out, the terms found so far are kept
+    size_t tested = 0;
+    auto offer = [this, &matches, &function, &tested, budgetInterval](const std::string &term) {
+        if (budget != nullptr && ++tested % budgetInterval == 0 && budget->expired()) {
+            return false;
+        }
+        if (matches(term)) {
+            function(term);
+        }
+        return true;
+    };
+    if (!filter.matchesAll()) {
+        for (uint32_t termId : store.trigramIndex->candidates(filter)) {
+            if (!offer(store.trigramIndex->term(termId))) {
+                break;
+            }
+        }
+    } else {
+        TermDictionary::Cursor cursor(store.termDictionary);
+        for (cursor.seek(prefix); cursor.valid() && cursor.term().starts_with(prefix); cursor.next()) {
+            if (!offer(cursor.term())) {
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+const PostingList *IndexReader::expandPattern(const std::string &pattern) const {
+    // the ranges of a parallel query look the same pattern up at the same time
+    std::lock_guard<std::mutex> lock(patternMutex);
+    auto known = patternPostings.find(pattern);
+    if (known != patternPostings.end()) {
+        return known->second;
+    }
+
+    std::vector<const PostingList *> lists;
+    bool valid = forEachPatternTerm(pattern, [&](const std::string &term) {
+        // a list compaction emptied stays in the index until its last pass
+        auto itr = store.termInvertedIndex.find(term);
+        if (itr != store.termInvertedIndex.end() && !itr->second.empty()) {
+            lists.push_back(&itr->second);
+        }
+    });
+    if (!valid) {
+        patternPostings.emplace(pattern, nullptr);
+        return nullptr;
+    }
+    if (lists.size() > MAX_PATTERN_TERMS) {
+        std::nth_element(lists.begin(), lists.begin() + MAX_PATTERN_TERMS, lists.end(),
+                         [](const PostingList *a, const PostingList *b) { return a->size() > b->size(); });
+        lists.resize(MAX_PATTERN_TERMS);
+    }
+
+    const PostingList *postings = nullptr;
+    if (lists.size() == 1) {
+        postings = lists.front();
+    } else if (!lists.empty()) {
+        postings = mergedPostings.emplace_back(std::make_unique<PostingList>(mergePostings(lists))).get();
+    }
+    patternPostings.emplace(pattern, postings);
+    return postings;
+}
+
+// A union of many lists is added up in an array over all the documents, a sparse one is
+// sorted. Either way the merged list is appended in document order.
+PostingList IndexReader::mergePostings(const std::vector<const PostingList *> &lists) const {
+    uint32_t documentNumberBound = store.nextDocumentNumber;
+    double averageLength = store.averageDocumentLength();
+    size_t postingCount = 0;
+    for (const PostingList *postings : lists) {
+        postingCount += postings->size();
+    }
+
+    PostingList merged;
+    if (postingCount * MERGE_DENSITY >= documentNumberBound) {
+        std::vector<uint32_t> frequencies(documentNumberBound, 0);
+        for (const PostingList *postings : lists) {
+            if (budget != nullptr && budget->expired()) {
+                break;
+            }
+            postings->forEach([&frequencies](uint32_t document, uint32_t frequency) { frequencies[document] += frequency; });
+        }
+        for (uint32_t document = 0; document < documentNumberBound; document++) {
+            if (frequencies[document] > 0) {
+                merged.add(document, frequencies[document], store.documentLengths, averageLength);
+            }
+        }
+    } else {
+        std::vector<Impact> postings;
+        postings.reserve(postingCount);
+        for (const PostingList *list : lists) {
+            if (budget != nullptr && budget->expired()) {
+                break;
+            }
+            list->forEach([&postings](uint32_t document, uint32_t frequency) { postings.push_back({document, frequency}); });
+        }
+        std::sort(postings.begin(), postings.end(),
+                  [](const Impact &a, const Impact &b) { return a.documentNumber < b.documentNumber; });
+        for (size_t i = 0; i < postings.size();) {
+            uint32_t document = postings[i].documentNumber;
+            uint32_t frequency = 0;
+            for (; i < postings.size() && postings[i].documentNumber == document; i++) {
+                frequency += postings[i].frequency;
+            }
+            merged.add(document, frequency, store.documentLengths, averageLength);
+        }
     }
 
-    return std::move(results);
+    if (merged.size() >= std::max(MIN_BITMAP_POSTINGS, static_cast<size_t>(documentNumberBound) / BITMAP_DENSITY)) {
+        merged.toBitmap();
+    }
+    return merged;
+}
+
+size_t IndexReader::documentFrequency(const std::string &term) const {
+    const PostingList *postings = findPostings(term);
+    return postings == nullptr ? 0 : postings->size();
+}
+
+uint32_t IndexReader::documentLength(uint32_t documentNumber) const {
+    return documentNumber < store.documentLengths.size() ? store.documentLengths[documentNumber] : 0;
+}
+
+double IndexStore::averageDocumentLength() const {
+    long documents = liveDocuments;
+    return documents > 0 ? std::max(1.0, static_cast<double>(totalDocumentLength) / documents) : 1.0;
+}
+
+double IndexReader::averageDocumentLength() const {
+    return store.averageDocumentLength();
 }
@@ -0,0 +1,227 @@
+#include "Intersection.hpp"
+
+#include <algorithm>
+
+#include "PostingList.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+    // what is left after the vector loop, or everything on CPUs without one
+    size_t mergeScalar(const uint32_t *a, size_t i, size_t sizeA, const uint32_t *b, size_t j, size_t sizeB,
+                       uint32_t *positionsA, uint32_t *positionsB, size_t count) {
+        while (i < sizeA && j < sizeB) {
+            if (a[i] < b[j]) {
+                i++;
+            } else if (a[i] > b[j]) {
+                j++;
+            } else {
+                positionsA[count] = i++;
+                positionsB[count] = j++;
+                count++;
+            }
+        }
+        return count;
+    }
+
+    size_t intersectMergeScalar(const uint32_t *a, size_t sizeA, const uint32_t *b, size_t sizeB,
+                                uint32_t *positionsA, uint32_t *positionsB) {
+        return mergeScalar(a, 0, sizeA, b, 0, sizeB, positionsA, positionsB, 0);
+    }
+
+    size_t intersectGallopScalar(const uint32_t *a, size_t sizeA, const uint32_t *b, size_t sizeB,
+                                 uint32_t *positionsA, uint32_t *positionsB) {
+        size_t count = 0;
+        size_t j = 0;
+        for (size_t i = 0; i < sizeA; i++) {
+            j = gallopTo(b, j, sizeB, a[i]);
+            if (j == sizeB) {
+                break;
+            }
+            if (b[j] == a[i]) {
+                positionsA[count] = i;
+                positionsB[count] = j;
+                count++;
+            }
+        }
+        return count;
+    }
+
+    // Gallops over the blocks of WIDTH values of b by their last value, then lets
+    // findInBlock compare the value with the whole block, instead of finishing with a
+    // binary search. The values past the last whole block are galloped one by one.
+    template <size_t WIDTH, typename FindInBlock>
+    size_t gallopBlocks(const uint32_t *a, size_t sizeA, const uint32_t *b, size_t sizeB,
+                        uint32_t *positionsA, uint32_t *positionsB, FindInBlock findInBlock) {
+        size_t count = 0;
+        size_t j = 0;
+
+        for (size_t i = 0; i < sizeA && j < sizeB; i++) {
+            uint32_t value = a[i];
+            size_t blocks = (sizeB - j) / WIDTH;
+            auto blockLast = [&](size_t block) { return b[j + block * WIDTH + WIDTH - 1]; };
+
+            if (blocks == 0 || blockLast(blocks - 1) < value) {
+                j = gallopTo(b, j + blocks * WIDTH, sizeB, value);
+                if (j < sizeB && b[j] == value) {
+                    positionsA[count] = i;
+                    positionsB[count] = j;
+                    count++;
+                }
+                continue;
+            }
+
+            // first block whose last value is >= value, probing blocks 0, 1, 3, 7, ...
+            size_t low = 0;
+            size_t high = 0;
+            size_t step = 1;
+            while (blockLast(high) < value) {
+                low = high + 1;
+                high = std::min(high + step, blocks - 1);
+                step *= 2;
+            }
+            while (low < high) {
+                size_t middle = (low + high) / 2;
+                if (blockLast(middle) < value) {
+                    low = middle + 1;
+                } else {
+                    high = middle;
+                }
+            }
+
+            // the next values of a are larger, so nothing before this block is needed again
+            j += high * WIDTH;
+            int lane = findInBlock(b + j, value);
+            if (lane >= 0) {
+                positionsA[count] = i;
+                positionsB[count] = j + lane;
+                count++;
+            }
+        }
+        return count;
+    }
+
+#if defined(__x86_64__)
+    // SSE2 is part of x86-64, so this version needs no check
+    size_t intersectMergeSse(const uint32_t *a, size_t sizeA, const uint32_t *b, size_t sizeB,
+                             uint32_t *positionsA, uint32_t *positionsB) {
+        size_t count = 0;
+        size_t i = 0;
+        size_t j = 0;
+
+        while (i + 4 <= sizeA && j + 4 <= sizeB) {
+            __m128i blockA = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+            __m128i blockB = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + j));
+
+            // every value of blockA against every value of blockB, rotating blockB
+            __m128i matches = _mm_cmpeq_epi32(blockA, blockB);
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, _MM_SHUFFLE(0, 3, 2, 1))));
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, _MM_SHUFFLE(1, 0, 3, 2))));
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, _MM_SHUFFLE(2, 1, 0, 3))));
+
+            int matchedLanes = _mm_movemask_ps(_mm_castsi128_ps(matches));
+            while (matchedLanes != 0) {
+                int lane = __builtin_ctz(matchedLanes);
+                __m128i value = _mm_set1_epi32(static_cast<int>(a[i + lane]));
+                positionsA[count] = i + lane;
+                positionsB[count] = j + __builtin_ctz(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(value, blockB))));
+                count++;
+                matchedLanes &= matchedLanes - 1;
+            }
+
+            uint32_t lastA = a[i + 3];
+            uint32_t lastB = b[j + 3];
+            i += lastA <= lastB ? 4 : 0;
+            j += lastB <= lastA ? 4 : 0;
+        }
+        return mergeScalar(a, i, sizeA, b, j, sizeB, positionsA, positionsB, count);
+    }
+
+    size_t intersectGallopSse(const uint32_t *a, size_t sizeA, const uint32_t *b, size_t sizeB,
+                              uint32_t *positionsA, uint32_t *positionsB) {
+        return gallopBlocks<4>(a, sizeA, b, sizeB, positionsA, positionsB, [](const uint32_t *block, uint32_t value) {
+            __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, _mm_set1_epi32(static_cast<int>(value)))));
+            return mask == 0 ? -1 : __builtin_ctz(mask);
+        });
+    }
+
+    __attribute__((target("avx2")))
+    int findInBlockAvx2(const uint32_t *block, uint32_t value) {
+        __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(values, _mm256_set1_epi32(static_cast<int>(value)))));
+        return mask == 0 ? -1 : __builtin_ctz(mask);
+    }
+
+    __attribute__((target("avx2")))
+    size_t intersectMergeAvx2(const uint32_t *a, size_t sizeA, const uint32_t *b, size_t sizeB,
+                              uint32_t *positionsA, uint32_t *positionsB) {
+        size_t count = 0;
+        size_t i = 0;
+        size_t j = 0;
+        const __m256i rotateByOne = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+
+        while (i + 8 <= sizeA && j + 8 <= sizeB) {
+            __m256i blockA = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            __m256i blockB = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + j));
+
+            __m256i rotated = blockB;
+            __m256i matches = _mm256_cmpeq_epi32(blockA, rotated);
+            for (int rotation = 1; rotation < 8; rotation++) {
+                rotated = _mm256_permutevar8x32_epi32(rotated, rotateByOne);
+                matches = _mm256_or_si256(matches, _mm256_cmpeq_epi32(blockA, rotated));
+            }
+
+            int matchedLanes = _mm256_movemask_ps(_mm256_castsi256_ps(matches));
+            while (matchedLanes != 0) {
+                int lane = __builtin_ctz(matchedLanes);
+                __m256i value = _mm256_set1_epi32(static_cast<int>(a[i + lane]));
+                positionsA[count] = i + lane;
+                positionsB[count] = j + __builtin_ctz(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(value, blockB))));
+                count++;
+                matchedLanes &= matchedLanes - 1;
+            }
+
+            uint32_t lastA = a[i + 7];
+            uint32_t lastB = b[j + 7];
+            i += lastA <= lastB ? 8 : 0;
+            j += lastB <= lastA ? 8 : 0;
+        }
+        return mergeScalar(a, i, sizeA, b, j, sizeB, positionsA, positionsB, count);
+    }
+
+    __attribute__((target("avx2")))
+    size_t intersectGallopAvx2(const uint32_t *a, size_t sizeA, const uint32_t *b, size_t sizeB,
+                               uint32_t *positionsA, uint32_t *positionsB) {
+        return gallopBlocks<8>(a, sizeA, b, sizeB, positionsA, positionsB, findInBlockAvx2);
+    }
+#endif
+
+    const IntersectionKernels &kernels() {
+        static const IntersectionKernels selected = availableIntersectionKernels().back();
+        return selected;
+    }
+}
+
+std::vector<IntersectionKernels> availableIntersectionKernels() {
+    std::vector<IntersectionKernels> available{{"scalar", intersectMergeScalar, intersectGallopScalar}};
+#if defined(__x86_64__)
+    available.push_back({"sse", intersectMergeSse, intersectGallopSse});
+    if (__builtin_cpu_supports("avx2")) {
+        available.push_back({"avx2", intersectMergeAvx2, intersectGallopAvx2});
+    }
+#endif
+    return available;
+}
+
+size_t intersectMerge(const uint32_t *a, size_t sizeA, const uint32_t *b, size_t sizeB,
+                      uint32_t *positionsA, uint32_t *positionsB) {
+    return kernels().merge(a, sizeA, b, sizeB, positionsA, positionsB);
+}
+
+size_t intersectGallop(const uint32_t *a, size_t sizeA, const uint32_t *b, size_t sizeB,
+                       uint32_t *positionsA, uint32_t *positionsB) {
+    return kernels().gallop(a, sizeA, b, sizeB, positionsA, positionsB);
+}
@@ -0,0 +1,122 @@
+#include "LevenshteinAutomaton.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+LevenshteinAutomaton::LevenshteinAutomaton(const std::string &word, size_t maxDistance) {
+    wordBytes = word;
+    std::sort(wordBytes.begin(), wordBytes.end(),
+              [](char a, char b) { return static_cast<unsigned char>(a) < static_cast<unsigned char>(b); });
+    wordBytes.erase(std::unique(wordBytes.begin(), wordBytes.end()), wordBytes.end());
+    byteClasses.fill(0);
+    for (size_t i = 0; i < wordBytes.size(); i++) {
+        byteClasses[static_cast<unsigned char>(wordBytes[i])] = static_cast<uint8_t>(i + 1);
+    }
+    classCount = wordBytes.size() + 1;
+
+    // the rows get their states as they are first reached, every row that cannot match is DEAD
+    int distance = static_cast<int>(std::min(maxDistance, MAX_DISTANCE));
+    int cap = distance + 1;
+    size_t rowSize = word.size() + 1;
+    std::vector<std::string> rows{std::string(rowSize, static_cast<char>(cap))};
+    std::unordered_map<std::string, uint32_t> states;
+    auto stateOf = [&rows, &states, cap](std::string &row) {
+        if (*std::min_element(row.begin(), row.end()) >= cap) {
+            return DEAD;
+        }
+        auto [itr, added] = states.try_emplace(row, static_cast<uint32_t>(rows.size()));
+        if (added) {
+            rows.push_back(row);
+        }
+        return itr->second;
+    };
+
+    std::string row(rowSize, 0);
+    for (size_t i = 0; i < rowSize; i++) {
+        row[i] = static_cast<char>(std::min<size_t>(i, cap));
+    }
+    stateOf(row);
+
+    for (uint32_t state = 0; state < rows.size(); state++) {
+        for (size_t byteClass = 0; byteClass < classCount; byteClass++) {
+            const std::string &previous = rows[state];
+            row[0] = static_cast<char>(std::min(previous[0] + 1, cap));
+            for (size_t i = 1; i < rowSize; i++) {
+                int substitution = previous[i - 1] + (byteClass > 0 && word[i - 1] == wordBytes[byteClass - 1] ? 0 : 1);
+                row[i] = static_cast<char>(std::min({substitution, previous[i] + 1, row[i - 1] + 1, cap}));
+            }
+            transitions.push_back(stateOf(row));
+        }
+        accepting.push_back(rows[state].back() <= distance);
+    }
+}
+
+int LevenshteinAutomaton::nextLiveByte(uint32_t state, int from) const {
+    if (from > 0xFF) {
+        return -1;
+    }
+    // a byte of the word never does worse than one outside it
+    const uint32_t *next = transitions.data() + state * classCount;
+    if (next[0] != DEAD) {
+        return from;
+    }
+    for (size_t i = 0; i < wordBytes.size(); i++) {
+        int byte = static_cast<unsigned char>(wordBytes[i]);
+        if (byte >= from && next[i + 1] != DEAD) {
+            return byte;
+        }
+    }
+    return -1;
+}
+
+bool LevenshteinAutomaton::matches(std::string_view text) const {
+    uint32_t state = START;
+    for (char c : text) {
+        state = step(state, static_cast<unsigned char>(c));
+        if (state == DEAD) {
+            return false;
+        }
+    }
+    return accepting[state];
+}
+
+bool LevenshteinAutomaton::nextMatch(std::string_view from, std::string &target) const {
+    // Follows from as far as a match stays possible, keeping the state at every position.
+    // The answer is from itself, or from a position on the way, the latest first, the
+    // smallest larger byte that keeps a match possible followed by the smallest bytes that
+    // reach one. At the end of from any byte is larger.
+    std::vector<uint32_t> states{START};
+    while (states.size() <= from.size()) {
+        uint32_t state = step(states.back(), static_cast<unsigned char>(from[states.size() - 1]));
+        if (state == DEAD) {
+            break;
+        }
+        states.push_back(state);
+    }
+    if (states.size() > from.size() && accepting[states.back()]) {
+        target = from;
+        return true;
+    }
+
+    for (size_t position = states.size(); position-- > 0;) {
+        int minimum = position < from.size() ? static_cast<unsigned char>(from[position]) + 1 : 0;
+        int byte = nextLiveByte(states[position], minimum);
+        if (byte < 0) {
+            continue;
+        }
+
+        // from a state that can still match, the smallest such bytes always lead to a match
+        target.assign(from.substr(0, position));
+        uint32_t state = states[position];
+        while (true) {
+            target.push_back(static_cast<char>(byte));
+            state = step(state, static_cast<unsigned char>(byte));
+            if (accepting[state]) {
+                return true;
+            }
+            byte = nextLiveByte(state, 0);
+        }
+    }
+    return false;
+}
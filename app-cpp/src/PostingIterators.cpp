@@ -0,0 +1,374 @@
+#include "PostingIterators.hpp"
+
+#include <algorithm>
+
+TermIterator::TermIterator(const PostingList &postings, double idf)
+    : postings(postings), documents(postings.documentData()), size(postings.size()), idf(idf) {}
+
+uint32_t TermIterator::next() {
+    if (position < size) {
+        position++;
+    }
+    return document();
+}
+
+uint32_t TermIterator::advance(uint32_t target) {
+    if (position >= size || documents[position] >= target) {
+        return document();
+    }
+
+    // the target is past the current block: gallop over the skip pointers to the block holding it
+    const std::vector<uint32_t> &skips = postings.skips();
+    size_t block = position / PostingList::BLOCK_SIZE;
+    if (skips[block] < target) {
+        block = gallopTo(skips.data(), block + 1, skips.size(), target);
+        if (block == skips.size()) {
+            position = size;
+            return END;
+        }
+        position = block * PostingList::BLOCK_SIZE;
+    }
+
+    size_t blockEnd = std::min((block + 1) * PostingList::BLOCK_SIZE, size);
+    position = gallopTo(documents, position, blockEnd, target);
+    return document();
+}
+
+double TermIterator::maxBm25Score(double averageLength) const {
+    if (scoreBound < 0) {
+        scoreBound = idf * postings.scoreBound(averageLength);
+    }
+    return scoreBound;
+}
+
+BitmapTermIterator::BitmapTermIterator(const PostingList &postings, double idf)
+    : postings(postings), ranks(postings.bitmap()), current(postings.bitmap().nextAtLeast(0)), idf(idf) {}
+
+uint32_t BitmapTermIterator::next() {
+    if (current != END) {
+        current = postings.bitmap().nextAtLeast(current + 1);
+        position++;
+    }
+    return current;
+}
+
+uint32_t BitmapTermIterator::advance(uint32_t target) {
+    if (current >= target) {
+        return current;
+    }
+    current = postings.bitmap().nextAtLeast(target);
+    position = current == END ? postings.size() : ranks.indexOf(current);
+    return current;
+}
+
+double BitmapTermIterator::maxBm25Score(double averageLength) const {
+    if (scoreBound < 0) {
+        scoreBound = idf * postings.scoreBound(averageLength);
+    }
+    return scoreBound;
+}
+
+std::unique_ptr<PostingIterator> makeTermIterator(const PostingList &postings, double idf) {
+    if (postings.isBitmap()) {
+        return std::make_unique<BitmapTermIterator>(postings, idf);
+    }
+    return std::make_unique<TermIterator>(postings, idf);
+}
+
+
+AndIterator::AndIterator(std::vector<std::unique_ptr<PostingIterator>> children) : children(std::move(children)) {
+    std::sort(this->children.begin(), this->children.end(),
+              [](const auto &a, const auto &b) { return a->cost() < b->cost(); });
+    current = this->children.empty() ? END : align(this->children.front()->document());
+}
+
+// Leapfrog until every child sits on the same document: a child that overshoots the
+// candidate moves the lead to where it landed.
+uint32_t AndIterator::align(uint32_t candidate) {
+    while (candidate != END) {
+        size_t i = 1;
+        for (; i < children.size(); i++) {
+            uint32_t document = children[i]->advance(candidate);
+            if (document != candidate) {
+                candidate = children.front()->advance(document);
+                break;
+            }
+        }
+        if (i == children.size()) {
+            break;
+        }
+    }
+    return current = candidate;
+}
+
+uint32_t AndIterator::next() {
+    if (current == END) {
+        return END;
+    }
+    return align(children.front()->next());
+}
+
+uint32_t AndIterator::advance(uint32_t target) {
+    if (current >= target) {
+        return current;
+    }
+    return align(children.front()->advance(target));
+}
+
+long AndIterator::score() const {
+    long total = 0;
+    for (const auto &child : children) {
+        total += child->score();
+    }
+    return total;
+}
+
+double AndIterator::bm25Score(uint32_t documentLength, double averageLength) const {
+    double total = 0;
+    for (const auto &child : children) {
+        total += child->bm25Score(documentLength, averageLength);
+    }
+    return total;
+}
+
+double AndIterator::maxBm25Score(double averageLength) const {
+    double total = 0;
+    for (const auto &child : children) {
+        total += child->maxBm25Score(averageLength);
+    }
+    return total;
+}
+
+void AndIterator::setMinCompetitiveScore(double minScore, double averageLength) {
+    double total = maxBm25Score(averageLength);
+    for (const auto &child : children) {
+        child->setMinCompetitiveScore(minScore - (total - child->maxBm25Score(averageLength)), averageLength);
+    }
+}
+
+bool AndIterator::skippedMatches() const {
+    return std::any_of(children.begin(), children.end(), [](const auto &child) { return child->skippedMatches(); });
+}
+
+
+namespace {
+    // std heap functions keep the largest element on top, this puts the lowest document there
+    bool laterDocument(const PostingIterator *a, const PostingIterator *b) {
+        return a->document() > b->document();
+    }
+}
+
+OrIterator::OrIterator(std::vector<std::unique_ptr<PostingIterator>> children) : children(std::move(children)) {
+    for (const auto &child : this->children) {
+        if (child->document() != END) {
+            heap.push_back(child.get());
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), laterDocument);
+    current = heap.empty() ? END : heap.front()->document();
+}
+
+// Children below the target are popped, advanced and pushed back, or dropped once
+// exhausted. The children out of the heap then catch up with the document found.
+uint32_t OrIterator::moveChildrenTo(uint32_t target) {
+    while (!heap.empty() && heap.front()->document() < target) {
+        std::pop_heap(heap.begin(), heap.end(), laterDocument);
+        if (heap.back()->advance(target) == END) {
+            heap.pop_back();
+        } else {
+            std::push_heap(heap.begin(), heap.end(), laterDocument);
+        }
+    }
+    current = heap.empty() ? END : heap.front()->document();
+    if (current != END) {
+        for (size_t i = 0; i < nonEssential; i++) {
+            byBound[i]->advance(current);
+        }
+    }
+    return current;
+}
+
+uint32_t OrIterator::next() {
+    if (current == END) {
+        return END;
+    }
+    return moveChildrenTo(current + 1);
+}
+
+uint32_t OrIterator::advance(uint32_t target) {
+    if (current >= target) {
+        return current;
+    }
+    return moveChildrenTo(target);
+}
+
+long OrIterator::score() const {
+    long total = 0;
+    for (const PostingIterator *child : heap) {
+        if (child->document() == current) {
+            total += child->score();
+        }
+    }
+    for (size_t i = 0; i < nonEssential; i++) {
+        if (byBound[i]->document() == current) {
+            total += byBound[i]->score();
+        }
+    }
+    return total;
+}
+
+double OrIterator::bm25Score(uint32_t documentLength, double averageLength) const {
+    double total = 0;
+    for (const PostingIterator *child : heap) {
+        if (child->document() == current) {
+            total += child->bm25Score(documentLength, averageLength);
+        }
+    }
+    for (size_t i = 0; i < nonEssential; i++) {
+        if (byBound[i]->document() == current) {
+            total += byBound[i]->bm25Score(documentLength, averageLength);
+        }
+    }
+    return total;
+}
+
+size_t OrIterator::cost() const {
+    size_t total = 0;
+    for (const PostingIterator *child : heap) {
+        total += child->cost();
+    }
+    return total;
+}
+
+double OrIterator::maxBm25Score(double averageLength) const {
+    double total = 0;
+    for (const auto &child : children) {
+        total += child->maxBm25Score(averageLength);
+    }
+    return total;
+}
+
+// takes effect from the next move, the current document stays as it is
+void OrIterator::setMinCompetitiveScore(double minScore, double averageLength) {
+    if (byBound.empty()) {
+        for (const auto &child : children) {
+            byBound.push_back(child.get());
+        }
+        std::sort(byBound.begin(), byBound.end(), [averageLength](const PostingIterator *a, const PostingIterator *b) {
+            return a->maxBm25Score(averageLength) < b->maxBm25Score(averageLength);
+        });
+    }
+
+    size_t before = nonEssential;
+    while (nonEssential < byBound.size() && nonEssentialBound + byBound[nonEssential]->maxBm25Score(averageLength) <= minScore) {
+        nonEssentialBound += byBound[nonEssential]->maxBm25Score(averageLength);
+        nonEssential++;
+    }
+    if (nonEssential == before) {
+        return;
+    }
+    std::erase_if(heap, [this, before](const PostingIterator *child) {
+        return std::find(byBound.begin() + before, byBound.begin() + nonEssential, child) != byBound.begin() + nonEssential;
+    });
+    std::make_heap(heap.begin(), heap.end(), laterDocument);
+}
+
+bool OrIterator::skippedMatches() const {
+    return nonEssential > 0 || std::any_of(children.begin(), children.end(), [](const auto &child) { return child->skippedMatches(); });
+}
+
+
+MinShouldMatchIterator::MinShouldMatchIterator(std::vector<std::unique_ptr<PostingIterator>> children, size_t minimum)
+    : children(std::move(children)), minimum(minimum) {
+    for (const auto &child : this->children) {
+        if (child->document() != END) {
+            heap.push_back(child.get());
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), laterDocument);
+    moveTo(0);
+}
+
+uint32_t MinShouldMatchIterator::moveTo(uint32_t target) {
+    while (true) {
+        while (!heap.empty() && heap.front()->document() < target) {
+            std::pop_heap(heap.begin(), heap.end(), laterDocument);
+            if (heap.back()->advance(target) == END) {
+                heap.pop_back();
+            } else {
+                std::push_heap(heap.begin(), heap.end(), laterDocument);
+            }
+        }
+        if (heap.size() < minimum) {
+            return current = END;
+        }
+
+        behind.clear();
+        for (size_t i = 1; i < minimum; i++) {
+            std::pop_heap(heap.begin(), heap.end(), laterDocument);
+            behind.push_back(heap.back());
+            heap.pop_back();
+        }
+        uint32_t candidate = heap.front()->document();
+        bool allOnCandidate = true;
+        for (PostingIterator *child : behind) {
+            allOnCandidate = allOnCandidate && child->document() == candidate;
+            heap.push_back(child);
+            std::push_heap(heap.begin(), heap.end(), laterDocument);
+        }
+
+        if (allOnCandidate) {
+            return current = candidate;
+        }
+        target = candidate;
+    }
+}
+
+long MinShouldMatchIterator::score() const {
+    long total = 0;
+    for (const PostingIterator *child : heap) {
+        if (child->document() == current) {
+            total += child->score();
+        }
+    }
+    return total;
+}
+
+double MinShouldMatchIterator::bm25Score(uint32_t documentLength, double averageLength) const {
+    double total = 0;
+    for (const PostingIterator *child : heap) {
+        if (child->document() == current) {
+            total += child->bm25Score(documentLength, averageLength);
+        }
+    }
+    return total;
+}
+
+size_t MinShouldMatchIterator::cost() const {
+    size_t total = 0;
+    for (const PostingIterator *child : heap) {
+        total += child->cost();
+    }
+    return total;
+}
+
+double MinShouldMatchIterator::maxBm25Score(double averageLength) const {
+    double total = 0;
+    for (const auto &child : children) {
+        total += child->maxBm25Score(averageLength);
+    }
+    return total;
+}
+
+
+AndNotIterator::AndNotIterator(std::unique_ptr<PostingIterator> included, std::unique_ptr<PostingIterator> excluded)
+    : included(std::move(included)), excluded(std::move(excluded)) {
+    current = skipExcluded(this->included->document());
+}
+
+uint32_t AndNotIterator::skipExcluded(uint32_t candidate) {
+    while (candidate != END && excluded->advance(candidate) == candidate) {
+        candidate = included->next();
+    }
+    return current = candidate;
+}
@@ -0,0 +1,184 @@
+#include "PostingList.hpp"
+
+#include <algorithm>
+
+namespace {
+    // margin for rounding, so a bound stays above the scores it covers
+    constexpr double BOUND_MARGIN = 1 + 1e-6;
+}
+
+void PostingList::addToBlocks(size_t position, uint32_t documentNumber, uint32_t frequency, uint32_t length, double averageLength) {
+    // a new block starts every BLOCK_SIZE postings and keeps the average length of that moment
+    if (position % BLOCK_SIZE == 0) {
+        float referenceLength = static_cast<float>(averageLength);
+        blockLastDocuments.push_back(documentNumber);
+        blockMaxFrequencies.push_back(frequency);
+        blockMinLengthRatios.push_back(lengthRatio(length, frequency));
+        blockReferenceLengths.push_back(referenceLength);
+        blockMinNormalizations.push_back(normalization(length, frequency, referenceLength));
+        return;
+    }
+    blockLastDocuments.back() = documentNumber;
+    blockMaxFrequencies.back() = std::max(blockMaxFrequencies.back(), frequency);
+    blockMinLengthRatios.back() = std::min(blockMinLengthRatios.back(), lengthRatio(length, frequency));
+    blockMinNormalizations.back() = std::min(blockMinNormalizations.back(), normalization(length, frequency, blockReferenceLengths.back()));
+}
+
+void PostingList::rebuildSkips(size_t fromPosition, const std::vector<uint32_t> &documentLengths, double averageLength) {
+    size_t fromBlock = fromPosition / BLOCK_SIZE;
+    blockLastDocuments.resize(fromBlock);
+    blockMaxFrequencies.resize(fromBlock);
+    blockMinLengthRatios.resize(fromBlock);
+    blockReferenceLengths.resize(fromBlock);
+    blockMinNormalizations.resize(fromBlock);
+
+    // a bitmap is walked from the first document after the blocks that stay
+    if (denseDocuments) {
+        uint32_t documentNumber = denseDocuments->nextAtLeast(fromBlock == 0 ? 0 : blockLastDocuments.back() + 1);
+        for (size_t position = fromBlock * BLOCK_SIZE; documentNumber != DocumentBitmap::END; position++) {
+            addToBlocks(position, documentNumber, frequencies[position], lengthOf(documentNumber, documentLengths), averageLength);
+            documentNumber = denseDocuments->nextAtLeast(documentNumber + 1);
+        }
+        return;
+    }
+    for (size_t position = fromBlock * BLOCK_SIZE; position < documents.size(); position++) {
+        addToBlocks(position, documents[position], frequencies[position], lengthOf(documents[position], documentLengths), averageLength);
+    }
+}
+
+void PostingList::add(uint32_t documentNumber, uint32_t frequency, const std::vector<uint32_t> &documentLengths, double averageLength) {
+    uint32_t length = lengthOf(documentNumber, documentLengths);
+    size_t position;
+    bool inserted;
+
+    if (denseDocuments) {
+        inserted = denseDocuments->add(documentNumber);
+        position = denseDocuments->indexOf(documentNumber);
+    } else if (documents.empty() || documents.back() < documentNumber) {
+        inserted = true;
+        position = documents.size();
+    } else {
+        position = std::lower_bound(documents.begin(), documents.end(), documentNumber) - documents.begin();
+        inserted = documents[position] != documentNumber;
+    }
+
+    if (!inserted) {
+        frequencies[position] += frequency;
+        // frequencies only grow, so the document moves up in the head or enters it
+        if (!impactHead.empty()) {
+            std::erase_if(impactHead, [documentNumber](const Impact &impact) { return impact.documentNumber == documentNumber; });
+            offerToHead(documentNumber, frequencies[position]);
+        }
+        size_t block = position / BLOCK_SIZE;
+        blockMaxFrequencies[block] = std::max(blockMaxFrequencies[block], frequencies[position]);
+        blockMinLengthRatios[block] = std::min(blockMinLengthRatios[block], lengthRatio(length, frequencies[position]));
+        blockMinNormalizations[block] = std::min(blockMinNormalizations[block],
+                                                 normalization(length, frequencies[position], blockReferenceLengths[block]));
+        return;
+    }
+
+    if (!denseDocuments) {
+        documents.insert(documents.begin() + position, documentNumber);
+    }
+    frequencies.insert(frequencies.begin() + position, frequency);
+
+    // documents usually arrive in increasing order and only the last block changes
+    if (position + 1 == frequencies.size()) {
+        addToBlocks(position, documentNumber, frequency, length, averageLength);
+    } else {
+        rebuildSkips(position, documentLengths, averageLength);
+    }
+
+    if (!impactHead.empty()) {
+        offerToHead(documentNumber, frequency);
+    } else if (size() > IMPACT_HEAD_SIZE) {
+        rebuildHead();
+    }
+}
+
+void PostingList::offerToHead(uint32_t documentNumber, uint32_t frequency) {
+    Impact impact{documentNumber, frequency};
+    if (impactHead.size() >= IMPACT_HEAD_SIZE && !ranksBefore(impact, impactHead.back())) {
+        return;
+    }
+    impactHead.insert(std::upper_bound(impactHead.begin(), impactHead.end(), impact, ranksBefore), impact);
+    if (impactHead.size() > IMPACT_HEAD_SIZE) {
+        impactHead.pop_back();
+    }
+}
+
+void PostingList::rebuildHead() {
+    impactHead.clear();
+    if (size() <= IMPACT_HEAD_SIZE) {
+        impactHead.shrink_to_fit();
+        return;
+    }
+
+    std::vector<Impact> impacts;
+    impacts.reserve(size());
+    forEach([&impacts](uint32_t documentNumber, uint32_t frequency) { impacts.push_back({documentNumber, frequency}); });
+    std::partial_sort(impacts.begin(), impacts.begin() + IMPACT_HEAD_SIZE, impacts.end(), ranksBefore);
+    impactHead.assign(impacts.begin(), impacts.begin() + IMPACT_HEAD_SIZE);
+}
+
+// A posting scores (k1 + 1) / (1 + n) before the idf, with n = c / frequency + e * length / frequency,
+// c = k1 * (1 - b) and e = k1 * b / averageLength, so the smallest n of the block gives the bound.
+// The largest frequency and smallest length ratio give one lower limit of n for any e, and the
+// smallest n under the reference length, moved along its slope to the current e, another one
+// that is close to exact while the average has not drifted far.
+double PostingList::blockScoreBound(size_t block, double averageLength) const {
+    double c = BM25_K1 * (1 - BM25_B);
+    double e = BM25_K1 * BM25_B / averageLength;
+    double referenceE = BM25_K1 * BM25_B / blockReferenceLengths[block];
+    double smallestFrequencyTerm = c / blockMaxFrequencies[block];
+    double smallestRatio = blockMinLengthRatios[block];
+
+    double smallestNormalization = smallestFrequencyTerm + e * smallestRatio;
+    double shifted = e >= referenceE
+                     ? blockMinNormalizations[block] + (e - referenceE) * smallestRatio
+                     : e / referenceE * blockMinNormalizations[block] + (1 - e / referenceE) * smallestFrequencyTerm;
+    smallestNormalization = std::max(smallestNormalization, shifted);
+
+    return (BM25_K1 + 1) / (1 + smallestNormalization) * BOUND_MARGIN;
+}
+
+double PostingList::scoreBound(double averageLength) const {
+    double bound = 0;
+    for (size_t block = 0; block < blockLastDocuments.size(); block++) {
+        bound = std::max(bound, blockScoreBound(block, averageLength));
+    }
+    return bound;
+}
+
+void PostingList::toBitmap() {
+    if (denseDocuments) {
+        return;
+    }
+    denseDocuments = DocumentBitmap::fromSorted(documents.data(), documents.size());
+    documents.clear();
+    documents.shrink_to_fit();
+}
+
+void PostingList::toList() {
+    if (!denseDocuments) {
+        return;
+    }
+    documents.reserve(frequencies.size());
+    denseDocuments->forEach([this](uint32_t documentNumber) { documents.push_back(documentNumber); });
+    denseDocuments.reset();
+}
+
+size_t gallopTo(const uint32_t *values, size_t begin, size_t end, uint32_t target) {
+    size_t step = 1;
+    size_t low = begin;
+    size_t high = begin;
+
+    while (high < end && values[high] < target) {
+        low = high + 1;
+        high = begin + step;
+        step *= 2;
+    }
+    high = std::min(high, end);
+
+    return std::lower_bound(values + low, values + high, target) - values;
+}
@@ -0,0 +1,31 @@
+#include "QueryBudget.hpp"
+
+#include <utility>
+
+namespace {
+    constexpr std::chrono::milliseconds CANCEL_CHECK_INTERVAL(10);
+}
+
+QueryBudget::QueryBudget(std::chrono::steady_clock::time_point deadline, std::function<bool()> cancelled)
+    : deadline(deadline), cancelled(std::move(cancelled)), nextCancelCheck(std::chrono::steady_clock::now().time_since_epoch().count()) {}
+
+bool QueryBudget::expired() {
+    if (stop) {
+        return true;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+        stop = true;
+        return true;
+    }
+
+    // one thread wins the exchange and asks, the others carry on until the next interval
+    auto checkAt = nextCancelCheck.load();
+    if (cancelled && now.time_since_epoch().count() >= checkAt
+        && nextCancelCheck.compare_exchange_strong(checkAt, (now + CANCEL_CHECK_INTERVAL).time_since_epoch().count())
+        && cancelled()) {
+        stop = true;
+    }
+    return stop;
+}
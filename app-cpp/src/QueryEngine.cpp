@@ -0,0 +1,790 @@
+#include "QueryEngine.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <optional>
+
+#include "Intersection.hpp"
+
+namespace {
+    // a list this many times larger than the candidates is galloped instead of merged
+    constexpr size_t GALLOP_RATIO = 8;
+    // candidates and list both covering at least this share of the documents are intersected with a bitmap
+    constexpr size_t BITMAP_DENSITY = 16;
+    // a disjunction of terms with at least one posting per this many documents is added up term at a time
+    constexpr size_t ACCUMULATOR_DENSITY = 4;
+    // postings a query is expected to walk before its document numbers are split into ranges
+    // evaluated in parallel, below that the threads cost more than they save
+    constexpr size_t PARALLEL_MIN_COST = 1 << 17;
+    // ranges per thread, so a range with more matches than the others does not hold the query up
+    constexpr size_t RANGES_PER_THREAD = 4;
+    // documents evaluated between two looks at the query's budget
+    constexpr uint32_t BUDGET_CHECK_INTERVAL = 1024;
+
+    // polls a budget, which may be missing, every BUDGET_CHECK_INTERVAL calls
+    class BudgetCheck {
+        QueryBudget *budget;
+        uint32_t calls = 0;
+
+        public:
+            BudgetCheck(QueryBudget *budget) : budget(budget) {}
+
+            bool exhausted() { return budget != nullptr && ++calls % BUDGET_CHECK_INTERVAL == 0 && budget->expired(); }
+    };
+
+    // documents that matched every list intersected so far, in increasing order
+    struct Candidates {
+        std::vector<uint32_t> documents;
+        std::vector<long> scores;
+
+        void add(uint32_t document, long score) {
+            documents.push_back(document);
+            scores.push_back(score);
+        }
+        size_t size() const { return documents.size(); }
+    };
+
+    // Every step hands the documents left to emit(document, score): the candidates of the
+    // next step, or the TopKCollector after the last one. A step only reads the postings
+    // between the first and the last candidate, which is all of a range ranked on its own.
+
+    // positions of the postings of a list that is not a bitmap within the candidates' span
+    std::pair<size_t, size_t> candidateSpan(const Candidates &candidates, const PostingList &postings) {
+        const uint32_t *documents = postings.documentData();
+        size_t first = std::lower_bound(documents, documents + postings.size(), candidates.documents.front()) - documents;
+        size_t last = std::upper_bound(documents + first, documents + postings.size(), candidates.documents.back()) - documents;
+        return {first, last};
+    }
+
+    // intersect with one of the kernels, which report the positions of the common documents
+    template <typename Kernel, typename Emit>
+    void kernelStep(const Candidates &candidates, const PostingList &postings, Kernel intersect, Emit &&emit) {
+        auto [first, last] = candidateSpan(candidates, postings);
+        std::vector<uint32_t> candidatePositions(std::min(candidates.size(), last - first));
+        std::vector<uint32_t> listPositions(candidatePositions.size());
+
+        size_t count = intersect(candidates.documents.data(), candidates.size(), postings.documentData() + first, last - first,
+                                 candidatePositions.data(), listPositions.data());
+
+        for (size_t i = 0; i < count; i++) {
+            emit(candidates.documents[candidatePositions[i]],
+                 candidates.scores[candidatePositions[i]] + postings.frequencyData()[first + listPositions[i]]);
+        }
+    }
+
+    template <typename Emit>
+    void bitmapStep(const Candidates &candidates, const PostingList &postings, uint32_t documentNumberBound, QueryScratch &scratch,
+                    Emit &&emit) {
+        std::vector<uint64_t> &bitmap = scratch.documentBits(documentNumberBound);
+        for (uint32_t document : candidates.documents) {
+            bitmap[document / 64] |= 1ULL << (document % 64);
+        }
+
+        // hits come in increasing order, so the candidate cursor only moves forward
+        const uint32_t *documents = postings.documentData();
+        auto [first, last] = candidateSpan(candidates, postings);
+        size_t candidatePosition = 0;
+        for (size_t i = first; i < last; i++) {
+            uint32_t document = documents[i];
+            if (document >= documentNumberBound || !((bitmap[document / 64] >> (document % 64)) & 1)) {
+                continue;
+            }
+            candidatePosition = gallopTo(candidates.documents.data(), candidatePosition, candidates.size(), document);
+            emit(document, candidates.scores[candidatePosition] + postings.frequencyData()[i]);
+        }
+
+        // the bits go back to zero for the next query
+        for (uint32_t document : candidates.documents) {
+            bitmap[document / 64] = 0;
+        }
+    }
+
+    template <typename Emit>
+    void probeStep(const Candidates &candidates, const PostingList &postings, Emit &&emit) {
+        DocumentBitmap::RankCursor cursor(postings.bitmap());
+        for (size_t i = 0; i < candidates.size(); i++) {
+            long position = cursor.indexOf(candidates.documents[i]);
+            if (position >= 0) {
+                emit(candidates.documents[i], candidates.scores[i] + postings.frequencyData()[position]);
+            }
+        }
+    }
+
+    // when every list is a bitmap they are intersected container by container up front,
+    // nothing when the budget ran out first
+    std::optional<DocumentBitmap> intersectBitmaps(const std::vector<const PostingList *> &lists, QueryBudget *budget) {
+        DocumentBitmap matching = lists.front()->bitmap();
+        for (size_t i = 1; i < lists.size() && !matching.empty(); i++) {
+            if (budget != nullptr && budget->expired()) {
+                return std::nullopt;
+            }
+            matching = DocumentBitmap::intersect(matching, lists[i]->bitmap());
+        }
+        return matching;
+    }
+
+    // Frequency ranking of a conjunction, rarest list first, over the documents in
+    // [begin, end): the postings of a single list, the documents of matching when every
+    // list is a bitmap, or else the rarest list's postings intersected with each list in
+    // turn. The walks cannot stop, past the budget the rest is only passed over. False
+    // when the budget ran out, a query stopped between steps keeps no candidates since
+    // they have not been checked against the lists left.
+    bool rankFrequency(const IndexReader &reader, const std::vector<const PostingList *> &lists, const DocumentBitmap *matching,
+                       uint32_t begin, uint32_t end, TopKCollector &collector, QueryScratch &scratch, QueryBudget *budget) {
+        BudgetCheck budgetCheck(budget);
+        bool exhausted = false;
+
+        if (lists.size() == 1) {
+            lists.front()->forEachInRange(begin, end, [&](uint32_t document, uint32_t frequency) {
+                if (!exhausted && !(exhausted = budgetCheck.exhausted()) && !reader.isDeleted(document)) {
+                    collector.collect(document, frequency);
+                }
+            });
+            return !exhausted;
+        }
+
+        if (matching != nullptr) {
+            std::vector<DocumentBitmap::RankCursor> cursors;
+            for (const PostingList *postings : lists) {
+                cursors.emplace_back(postings->bitmap());
+            }
+            matching->forEachInRange(begin, end, [&](uint32_t document) {
+                if (exhausted || (exhausted = budgetCheck.exhausted()) || reader.isDeleted(document)) {
+                    return;
+                }
+                long score = 0;
+                for (size_t i = 0; i < lists.size(); i++) {
+                    score += lists[i]->frequencyData()[cursors[i].indexOf(document)];
+                }
+                collector.collect(document, score);
+            });
+            return !exhausted;
+        }
+
+        // deleted documents are dropped from the candidates right away
+        Candidates candidates;
+        lists.front()->forEachInRange(begin, end, [&](uint32_t document, uint32_t frequency) {
+            if (!exhausted && !(exhausted = budgetCheck.exhausted()) && !reader.isDeleted(document)) {
+                candidates.add(document, frequency);
+            }
+        });
+
+        uint32_t documentNumberBound = reader.documentNumberBound();
+        auto collect = [&collector](uint32_t document, long score) { collector.collect(document, score); };
+        for (size_t step = 1; step < lists.size() && candidates.size() > 0; step++) {
+            if (exhausted || (budget != nullptr && budget->expired())) {
+                return false;
+            }
+            const PostingList &postings = *lists[step];
+            Candidates next;
+            auto addCandidate = [&next](uint32_t document, long score) { next.add(document, score); };
+
+            bool lastStep = step + 1 == lists.size();
+            auto runStep = [&](auto &&emit) {
+                switch (QueryEngine::chooseAlgorithm(candidates.size(), postings, documentNumberBound)) {
+                    case IntersectionAlgorithm::GALLOP:
+                        kernelStep(candidates, postings, intersectGallop, emit);
+                        break;
+                    case IntersectionAlgorithm::BITMAP:
+                        bitmapStep(candidates, postings, documentNumberBound, scratch, emit);
+                        break;
+                    case IntersectionAlgorithm::MERGE:
+                        kernelStep(candidates, postings, intersectMerge, emit);
+                        break;
+                    case IntersectionAlgorithm::PROBE:
+                        probeStep(candidates, postings, emit);
+                        break;
+                }
+            };
+
+            if (lastStep) {
+                runStep(collect);
+            } else {
+                runStep(addCandidate);
+            }
+            candidates = std::move(next);
+        }
+        return !exhausted;
+    }
+
+    double bm25Idf(double documentCount, double documentFrequency) {
+        return std::max(0.0, std::log(1 + (documentCount - documentFrequency + 0.5) / (documentFrequency + 0.5)));
+    }
+
+
+    // one term of a BM25 query, and the block of its posting list the query has reached
+    struct Bm25Cursor {
+        const PostingList *postings;
+        std::unique_ptr<PostingIterator> iterator;
+        double idf;
+        size_t block = 0;
+
+        // Last document of the block holding the first posting >= target, and in bound the
+        // best score a document of that block can get from this term. END once the list has
+        // nothing >= target.
+        uint32_t shallowAdvance(uint32_t target, double averageLength, double &bound) {
+            const std::vector<uint32_t> &skips = postings->skips();
+            if (skips[block] < target) {
+                block = gallopTo(skips.data(), block + 1, skips.size(), target);
+                if (block == skips.size()) {
+                    block--;
+                    return PostingIterator::END;
+                }
+            }
+            bound = idf * postings->blockScoreBound(block, averageLength);
+            return skips[block];
+        }
+    };
+
+    // Document at a time conjunction with block-max pruning: before lining the lists up on
+    // a candidate, the bounds of the blocks holding it are added up, and when they cannot
+    // beat the k-th best score so far the whole stretch up to the end of the shortest of
+    // those blocks is skipped. A single term is the same loop with one list. Only the
+    // documents in [begin, end) are ranked. False when a skipped stretch or the end of the
+    // budget left matches uncounted.
+    bool rankBm25(const IndexReader &reader, const std::vector<const PostingList *> &lists, uint32_t begin, uint32_t end,
+                  TopKCollector &collector, QueryBudget *budget) {
+        double documentCount = std::max(1L, reader.documentCount());
+        double averageLength = reader.averageDocumentLength();
+
+        std::vector<Bm25Cursor> cursors;
+        for (const PostingList *postings : lists) {
+            double idf = bm25Idf(documentCount, postings->size());
+            cursors.push_back({postings, makeTermIterator(*postings), idf});
+        }
+
+        // the bound holds up to stretchEnd, where the first of the current blocks ends
+        PostingIterator &lead = *cursors.front().iterator;
+        uint32_t candidate = lead.advance(begin);
+        uint32_t stretchEnd = 0;
+        double stretchBound = 0;
+        bool stretchKnown = false;
+        bool skipped = false;
+        BudgetCheck budgetCheck(budget);
+        while (candidate < end) {
+            if (budgetCheck.exhausted()) {
+                skipped = true;
+                break;
+            }
+            if (collector.full()) {
+                if (!stretchKnown || candidate > stretchEnd) {
+                    stretchBound = 0;
+                    stretchEnd = PostingIterator::END;
+                    for (Bm25Cursor &cursor : cursors) {
+                        double blockBound = 0;
+                        stretchEnd = std::min(stretchEnd, cursor.shallowAdvance(candidate, averageLength, blockBound));
+                        if (stretchEnd == PostingIterator::END) {
+                            break;
+                        }
+                        stretchBound += blockBound;
+                    }
+                    if (stretchEnd == PostingIterator::END) {
+                        break;
+                    }
+                    stretchKnown = true;
+                }
+                if (stretchBound <= collector.threshold()) {
+                    candidate = lead.advance(stretchEnd + 1);
+                    skipped = true;
+                    continue;
+                }
+            }
+
+            uint32_t aligned = candidate;
+            for (size_t i = 1; i < cursors.size() && aligned == candidate; i++) {
+                aligned = cursors[i].iterator->advance(candidate);
+            }
+            if (aligned != candidate) {
+                candidate = lead.advance(aligned);
+                continue;
+            }
+
+            if (!reader.isDeleted(candidate)) {
+                uint32_t length = reader.documentLength(candidate);
+                double score = 0;
+                for (Bm25Cursor &cursor : cursors) {
+                    score += PostingList::bm25Score(cursor.idf, cursor.iterator->score(), length, averageLength);
+                }
+                collector.collect(candidate, score);
+            }
+            candidate = lead.next();
+        }
+        return !skipped;
+    }
+
+    // the matches kept by the collector, and how many it saw when the caller counts them
+    std::vector<ScoredDocument> takeResults(TopKCollector &collector, HitCount *hits, bool exact = true) {
+        if (hits != nullptr) {
+            *hits = {collector.totalMatches(), exact};
+        }
+        return collector.takeSorted();
+    }
+
+    // Ranks the documents in [begin, end) into the collector, false when it skipped
+    // matches that could not make the top k without counting them.
+    using RangeRanker = std::function<bool(uint32_t begin, uint32_t end, TopKCollector &collector)>;
+
+    // A query expected to walk at least PARALLEL_MIN_COST postings has its document numbers
+    // split into ranges ranked on the pool and the calling thread, each into a collector of
+    // its own, and the k best of those are merged. Ties break on the document number, so the
+    // result is the one a single range would give. Cheaper queries run as a single range.
+    std::vector<ScoredDocument> rankInRanges(ThreadPool &pool, uint32_t documentNumberBound, size_t cost, size_t k,
+                                             const RangeRanker &rankRange, HitCount *hits) {
+        TopKCollector collector(k);
+        if (pool.size() == 0 || cost < PARALLEL_MIN_COST) {
+            bool exact = rankRange(0, PostingIterator::END, collector);
+            return takeResults(collector, hits, exact);
+        }
+
+        size_t rangeCount = (pool.size() + 1) * RANGES_PER_THREAD;
+        uint32_t rangeSize = documentNumberBound / rangeCount + 1;
+        std::vector<TopKCollector> partials(rangeCount, TopKCollector(k));
+        std::vector<char> exactRanges(rangeCount);
+        pool.parallelFor(rangeCount, [&](size_t range) {
+            uint32_t begin = range * rangeSize;
+            // the last range also takes what was added past the bound
+            uint32_t end = range + 1 == rangeCount ? PostingIterator::END : begin + rangeSize;
+            exactRanges[range] = rankRange(begin, end, partials[range]);
+        });
+
+        for (const TopKCollector &partial : partials) {
+            collector.merge(partial);
+        }
+        return takeResults(collector, hits, std::all_of(exactRanges.begin(), exactRanges.end(), [](char exact) { return exact; }));
+    }
+
+    // terms of a query made of ANDs and TERMs only
+    bool collectConjunction(const BooleanQuery &query, std::vector<std::string> &terms) {
+        if (query.op == BooleanQuery::Operator::TERM) {
+            terms.push_back(query.term);
+            return true;
+        }
+        if (query.op != BooleanQuery::Operator::AND) {
+            return false;
+        }
+        for (const BooleanQuery &child : query.children) {
+            if (!collectConjunction(child, terms)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // terms of an OR whose children are all TERMs
+    bool collectDisjunction(const BooleanQuery &query, std::vector<std::string> &terms) {
+        if (query.op != BooleanQuery::Operator::OR) {
+            return false;
+        }
+        for (const BooleanQuery &child : query.children) {
+            if (child.op != BooleanQuery::Operator::TERM) {
+                return false;
+            }
+            terms.push_back(child.term);
+        }
+        return true;
+    }
+
+    // Term at a time disjunction: every list is added into the dense accumulator in turn,
+    // then the documents touched that enough lists matched are ranked.
+    std::vector<ScoredDocument> accumulateDisjunction(const IndexReader &reader, const std::vector<const PostingList *> &lists,
+                                                      size_t minimum, size_t k, Ranking ranking, QueryScratch &scratch,
+                                                      HitCount *hits, QueryBudget *budget) {
+        TopKCollector collector(k);
+        double documentCount = std::max(1L, reader.documentCount());
+        double averageLength = reader.averageDocumentLength();
+
+        // the budget is looked at between lists, the documents of the lists added so far are ranked
+        scratch.resetAccumulator(reader.documentNumberBound());
+        bool complete = true;
+        for (const PostingList *postings : lists) {
+            if (budget != nullptr && budget->expired()) {
+                complete = false;
+                break;
+            }
+            if (ranking == Ranking::BM25) {
+                double idf = bm25Idf(documentCount, postings->size());
+                postings->forEach([&](uint32_t document, uint32_t frequency) {
+                    scratch.accumulate(document, PostingList::bm25Score(idf, frequency, reader.documentLength(document), averageLength));
+                });
+            } else {
+                postings->forEach([&scratch](uint32_t document, uint32_t frequency) { scratch.accumulate(document, frequency); });
+            }
+        }
+
+        for (uint32_t document : scratch.touchedDocuments()) {
+            if (scratch.matchCount(document) >= minimum && !reader.isDeleted(document)) {
+                collector.collect(document, scratch.score(document));
+            }
+        }
+        return takeResults(collector, hits, complete);
+    }
+
+    // Iterators for a boolean query, nullptr for a part that matches nothing.
+    class IteratorBuilder {
+        const IndexReader &reader;
+        double documentCount;
+
+        std::unique_ptr<PostingIterator> everything() const {
+            return std::make_unique<AllDocumentsIterator>(reader.documentNumberBound());
+        }
+
+        // an AND lines up its positive children and excludes the union of its negated ones
+        std::unique_ptr<PostingIterator> buildAnd(const std::vector<BooleanQuery> &children) const {
+            std::vector<std::unique_ptr<PostingIterator>> included;
+            std::vector<std::unique_ptr<PostingIterator>> excluded;
+            for (const BooleanQuery &child : children) {
+                if (child.op == BooleanQuery::Operator::NOT) {
+                    if (auto negated = buildNegated(child)) {
+                        excluded.push_back(std::move(negated));
+                    }
+                    continue;
+                }
+                auto iterator = build(child);
+                if (!iterator) {
+                    return nullptr;
+                }
+                included.push_back(std::move(iterator));
+            }
+
+            std::unique_ptr<PostingIterator> result;
+            if (included.empty()) {
+                result = everything();
+            } else if (included.size() == 1) {
+                result = std::move(included.front());
+            } else {
+                result = std::make_unique<AndIterator>(std::move(included));
+            }
+            if (excluded.empty()) {
+                return result;
+            }
+            std::unique_ptr<PostingIterator> exclusion = excluded.size() == 1
+                                                         ? std::move(excluded.front())
+                                                         : std::make_unique<OrIterator>(std::move(excluded));
+            return std::make_unique<AndNotIterator>(std::move(result), std::move(exclusion));
+        }
+
+        // what a NOT node removes, nullptr when that is nothing
+        std::unique_ptr<PostingIterator> buildNegated(const BooleanQuery &query) const {
+            return query.children.empty() ? nullptr : build(query.children.front());
+        }
+
+        public:
+            IteratorBuilder(const IndexReader &reader) : reader(reader), documentCount(std::max(1L, reader.documentCount())) {}
+
+            std::unique_ptr<PostingIterator> build(const BooleanQuery &query) const {
+                switch (query.op) {
+                    case BooleanQuery::Operator::TERM: {
+                        const PostingList *postings = reader.findPostings(query.term);
+                        if (postings == nullptr || postings->empty()) {
+                            return nullptr;
+                        }
+                        return makeTermIterator(*postings, bm25Idf(documentCount, postings->size()));
+                    }
+                    case BooleanQuery::Operator::AND:
+                        return buildAnd(query.children);
+                    case BooleanQuery::Operator::OR: {
+                        std::vector<std::unique_ptr<PostingIterator>> alternatives;
+                        for (const BooleanQuery &child : query.children) {
+                            if (auto iterator = build(child)) {
+                                alternatives.push_back(std::move(iterator));
+                            }
+                        }
+                        // children matching nothing count against the minimum, asking for all
+                        // the children left is a conjunction
+                        size_t minimum = std::max<size_t>(query.minimumShouldMatch, 1);
+                        if (alternatives.size() < minimum) {
+                            return nullptr;
+                        }
+                        if (alternatives.size() == 1) {
+                            return std::move(alternatives.front());
+                        }
+                        if (minimum == alternatives.size()) {
+                            return std::make_unique<AndIterator>(std::move(alternatives));
+                        }
+                        if (minimum > 1) {
+                            return std::make_unique<MinShouldMatchIterator>(std::move(alternatives), minimum);
+                        }
+                        return std::make_unique<OrIterator>(std::move(alternatives));
+                    }
+                    case BooleanQuery::Operator::NOT:
+                        return buildAnd({query});
+                }
+                return nullptr;
+            }
+    };
+
+    // Iterator over the documents matching a query, for callers that do not rank them. A
+    // conjunction is lined up rarest list first and, as in searchAll, one without terms
+    // matches nothing.
+    std::unique_ptr<PostingIterator> buildMatcher(const IndexReader &reader, const BooleanQuery &query) {
+        std::vector<std::string> terms;
+        if (!collectConjunction(query, terms)) {
+            return IteratorBuilder(reader).build(query);
+        }
+
+        ConjunctionPlan plan = QueryEngine::planConjunction(reader, terms);
+        if (plan.matchesNothing) {
+            return nullptr;
+        }
+        std::vector<std::unique_ptr<PostingIterator>> iterators;
+        for (const PostingList *postings : plan.lists) {
+            iterators.push_back(makeTermIterator(*postings));
+        }
+        if (iterators.size() == 1) {
+            return std::move(iterators.front());
+        }
+        return std::make_unique<AndIterator>(std::move(iterators));
+    }
+}
+
+QueryEngine::QueryEngine(std::shared_ptr<IndexStore> store)
+    : store(store), pool(std::max(1u, std::thread::hardware_concurrency()) - 1) {}
+
+ConjunctionPlan QueryEngine::planConjunction(const IndexReader &reader, const std::vector<std::string> &terms) {
+    ConjunctionPlan plan;
+
+    for (const auto &term : terms) {
+        if (term.empty()) {
+            continue;
+        }
+        const PostingList *postings = reader.findPostings(term);
+        if (postings == nullptr || postings->empty()) {
+            plan.matchesNothing = true;
+            plan.lists.clear();
+            return plan;
+        }
+        plan.lists.push_back(postings);
+    }
+
+    std::sort(plan.lists.begin(), plan.lists.end(),
+              [](const PostingList *a, const PostingList *b) { return a->size() < b->size(); });
+    plan.matchesNothing = plan.lists.empty();
+    return plan;
+}
+
+IntersectionAlgorithm QueryEngine::chooseAlgorithm(size_t candidateCount, const PostingList &postings, uint32_t documentNumberBound) {
+    if (postings.isBitmap()) {
+        return IntersectionAlgorithm::PROBE;
+    }
+    size_t listSize = postings.size();
+    if (listSize >= candidateCount * GALLOP_RATIO) {
+        return IntersectionAlgorithm::GALLOP;
+    }
+    size_t denseSize = documentNumberBound / BITMAP_DENSITY;
+    if (candidateCount >= denseSize && listSize >= denseSize) {
+        return IntersectionAlgorithm::BITMAP;
+    }
+    return IntersectionAlgorithm::MERGE;
+}
+
+std::vector<ScoredDocument> QueryEngine::searchAll(const std::vector<std::string> &terms, size_t k, Ranking ranking,
+                                                   QueryScratch *scratch, HitCount *hits, QueryBudget *budget) {
+    QueryScratch localScratch;
+    QueryScratch &work = scratch != nullptr ? *scratch : localScratch;
+    IndexReader reader(*store, budget);
+    ConjunctionPlan plan = planConjunction(reader, terms);
+
+    TopKCollector collector(k);
+    if (plan.matchesNothing) {
+        return takeResults(collector, hits);
+    }
+    if (ranking == Ranking::BM25) {
+        size_t cost = plan.lists.front()->size() * plan.lists.size();
+        return rankInRanges(pool, reader.documentNumberBound(), cost, k, [&](uint32_t begin, uint32_t end, TopKCollector &range) {
+            return rankBm25(reader, plan.lists, begin, end, range, budget);
+        }, hits);
+    }
+
+    const std::vector<const PostingList *> &lists = plan.lists;
+    if (lists.size() == 1) {
+        // the head of a long list answers unless deleted documents leave fewer than k in it
+        std::vector<ScoredDocument> fromHead;
+        for (const Impact &impact : lists.front()->head()) {
+            if (fromHead.size() == k) {
+                break;
+            }
+            if (!reader.isDeleted(impact.documentNumber)) {
+                fromHead.push_back({impact.documentNumber, static_cast<double>(impact.frequency)});
+            }
+        }
+        // the list also counts the deleted documents compaction has not removed yet
+        if (fromHead.size() == k) {
+            if (hits != nullptr) {
+                *hits = {lists.front()->size(), false};
+            }
+            return fromHead;
+        }
+    }
+
+    std::optional<DocumentBitmap> matching;
+    size_t cost = lists.front()->size() * lists.size();
+    if (lists.size() > 1 && std::all_of(lists.begin(), lists.end(), [](const PostingList *postings) { return postings->isBitmap(); })) {
+        matching = intersectBitmaps(lists, budget);
+        if (!matching) {
+            return takeResults(collector, hits, false);
+        }
+        cost = matching->cardinality() * lists.size();
+    }
+
+    // a range ranked next to others has a scratch of its own for the bitmap steps
+    return rankInRanges(pool, reader.documentNumberBound(), cost, k, [&](uint32_t begin, uint32_t end, TopKCollector &range) {
+        QueryScratch rangeScratch;
+        bool wholeRange = begin == 0 && end == PostingIterator::END;
+        return rankFrequency(reader, lists, matching ? &*matching : nullptr, begin, end, range, wholeRange ? work : rangeScratch, budget);
+    }, hits);
+}
+
+std::vector<ScoredDocument> QueryEngine::search(const BooleanQuery &query, size_t k, Ranking ranking, QueryScratch *scratch,
+                                                HitCount *hits, QueryBudget *budget) {
+    std::vector<std::string> terms;
+    if (collectConjunction(query, terms)) {
+        return searchAll(terms, k, ranking, scratch, hits, budget);
+    }
+
+    IndexReader reader(*store, budget);
+
+    // a broad disjunction of terms touches most documents, adding it up in a dense array
+    // beats merging the lists through a heap
+    terms.clear();
+    if (collectDisjunction(query, terms)) {
+        std::vector<const PostingList *> lists;
+        size_t postingCount = 0;
+        for (const std::string &term : terms) {
+            const PostingList *postings = reader.findPostings(term);
+            if (postings != nullptr && !postings->empty()) {
+                lists.push_back(postings);
+                postingCount += postings->size();
+            }
+        }
+        if (postingCount * ACCUMULATOR_DENSITY >= reader.documentNumberBound()) {
+            QueryScratch localScratch;
+            size_t minimum = std::max<size_t>(query.minimumShouldMatch, 1);
+            return accumulateDisjunction(reader, lists, minimum, k, ranking, scratch != nullptr ? *scratch : localScratch, hits,
+                                         budget);
+        }
+    }
+
+    // every range walks an iterator tree of its own, the first one also tells the cost
+    IteratorBuilder builder(reader);
+    std::unique_ptr<PostingIterator> root = builder.build(query);
+    if (!root) {
+        if (hits != nullptr) {
+            *hits = {};
+        }
+        return {};
+    }
+
+    // Once the range holds k documents under BM25 its lowest score is passed down the tree,
+    // so disjunctions stop merging the terms that cannot lift a document past it on their
+    // own. The count of matches is then only an estimate.
+    double averageLength = reader.averageDocumentLength();
+    auto rankRange = [&](uint32_t begin, uint32_t end, TopKCollector &range) {
+        std::unique_ptr<PostingIterator> iterator = begin == 0 ? std::move(root) : builder.build(query);
+        BudgetCheck budgetCheck(budget);
+        double minScore = 0;
+        for (uint32_t document = iterator->advance(begin); document < end; document = iterator->next()) {
+            if (budgetCheck.exhausted()) {
+                return false;
+            }
+            if (reader.isDeleted(document)) {
+                continue;
+            }
+            if (ranking == Ranking::BM25) {
+                range.collect(document, iterator->bm25Score(reader.documentLength(document), averageLength));
+                if (range.full() && range.threshold() > minScore) {
+                    minScore = range.threshold();
+                    iterator->setMinCompetitiveScore(minScore, averageLength);
+                }
+            } else {
+                range.collect(document, iterator->score());
+            }
+        }
+        return !iterator->skippedMatches();
+    };
+    return rankInRanges(pool, reader.documentNumberBound(), root->cost(), k, rankRange, hits);
+}
+
+size_t QueryEngine::count(const BooleanQuery &query, QueryBudget *budget) {
+    IndexReader reader(*store, budget);
+
+    // Until a document is deleted every posting is a match, so a term or a conjunction of
+    // bitmap lists is counted from the list size or the intersection's cardinality, and a
+    // disjunction of bitmap lists from the cardinality of their union. Past the budget, as
+    // in the walk below, only what was found so far counts: the union of the lists merged,
+    // and nothing from an unfinished intersection.
+    std::vector<std::string> terms;
+    if (!reader.hasDeletedDocuments() && collectDisjunction(query, terms) && query.minimumShouldMatch <= 1) {
+        std::vector<const PostingList *> lists;
+        for (const std::string &term : terms) {
+            const PostingList *postings = reader.findPostings(term);
+            if (postings != nullptr && !postings->empty()) {
+                lists.push_back(postings);
+            }
+        }
+        if (lists.empty()) {
+            return 0;
+        }
+        if (std::all_of(lists.begin(), lists.end(), [](const PostingList *postings) { return postings->isBitmap(); })) {
+            DocumentBitmap matching = lists.front()->bitmap();
+            for (size_t i = 1; i < lists.size() && !(budget != nullptr && budget->expired()); i++) {
+                matching = DocumentBitmap::unite(matching, lists[i]->bitmap());
+            }
+            return matching.cardinality();
+        }
+    }
+    terms.clear();
+    if (collectConjunction(query, terms) && !reader.hasDeletedDocuments()) {
+        ConjunctionPlan plan = planConjunction(reader, terms);
+        if (plan.matchesNothing) {
+            return 0;
+        }
+        if (plan.lists.size() == 1) {
+            return plan.lists.front()->size();
+        }
+        if (std::all_of(plan.lists.begin(), plan.lists.end(), [](const PostingList *postings) { return postings->isBitmap(); })) {
+            DocumentBitmap matching = plan.lists.front()->bitmap();
+            for (size_t i = 1; i < plan.lists.size() && !matching.empty(); i++) {
+                if (budget != nullptr && budget->expired()) {
+                    return 0;
+                }
+                matching = DocumentBitmap::intersect(matching, plan.lists[i]->bitmap());
+            }
+            return matching.cardinality();
+        }
+    }
+
+    std::unique_ptr<PostingIterator> matcher = buildMatcher(reader, query);
+    size_t matches = 0;
+    if (!matcher) {
+        return matches;
+    }
+    BudgetCheck budgetCheck(budget);
+    for (uint32_t document = matcher->document(); document != PostingIterator::END; document = matcher->next()) {
+        if (budgetCheck.exhausted()) {
+            break;
+        }
+        if (!reader.isDeleted(document)) {
+            matches++;
+        }
+    }
+    return matches;
+}
+
+bool QueryEngine::exists(const BooleanQuery &query, QueryBudget *budget) {
+    IndexReader reader(*store, budget);
+    std::unique_ptr<PostingIterator> matcher = buildMatcher(reader, query);
+    if (!matcher) {
+        return false;
+    }
+    BudgetCheck budgetCheck(budget);
+    for (uint32_t document = matcher->document(); document != PostingIterator::END; document = matcher->next()) {
+        if (!reader.isDeleted(document)) {
+            return true;
+        }
+        if (budgetCheck.exhausted()) {
+            break;
+        }
+    }
+    return false;
+}
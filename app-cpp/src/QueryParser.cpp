@@ -0,0 +1,211 @@
+#include "QueryParser.hpp"
+
+#include <cctype>
+#include <charconv>
+#include <regex>
+
+namespace {
+    // the server refuses longer regular expressions
+    constexpr size_t MAX_REGEX_LENGTH = 256;
+}
+
+QueryParser::QueryParser(const std::string &text) {
+    std::string word;
+    auto endWord = [this, &word]() {
+        if (!word.empty()) {
+            tokens.push_back(std::move(word));
+            word.clear();
+        }
+    };
+
+    for (size_t i = 0; i < text.size(); i++) {
+        char c = text[i];
+        if (c == '/' && word.empty()) {
+            // a regular expression runs to the next unescaped slash, spaces and parentheses
+            // included, one without it stops at the next space for the error message
+            size_t end = i + 1;
+            while (end < text.size() && text[end] != '/') {
+                end += text[end] == '\\' ? 2 : 1;
+            }
+            if (end >= text.size()) {
+                end = std::min(text.find_first_of(" \t\r\n", i), text.size()) - 1;
+            }
+            word = text.substr(i, end + 1 - i);
+            endWord();
+            i = end;
+        } else if (std::isspace(static_cast<unsigned char>(c))) {
+            endWord();
+        } else if (c == '(' || c == ')') {
+            endWord();
+            tokens.push_back(std::string(1, c));
+        } else {
+            word += c;
+        }
+    }
+    endWord();
+}
+
+bool QueryParser::parse(QueryNode &query) {
+    position = 0;
+    error.clear();
+    if (tokens.empty()) {
+        error = "The query is empty.";
+        return false;
+    }
+    if (!parseOr(query)) {
+        return false;
+    }
+    if (position < tokens.size()) {
+        error = "Unexpected '" + tokens[position] + "' in the query.";
+        return false;
+    }
+    return true;
+}
+
+bool QueryParser::startsOperand() const {
+    return position < tokens.size() && !atToken("OR") && !atToken("AND") && !atToken(")");
+}
+
+// a single operand is returned as is instead of wrapped in an OR or AND node
+bool QueryParser::parseOr(QueryNode &node) {
+    QueryNode first;
+    if (!parseAnd(first)) {
+        return false;
+    }
+    if (!atToken("OR")) {
+        node = std::move(first);
+        return true;
+    }
+
+    node.Clear();
+    node.set_type(QueryNode::OR);
+    *node.add_children() = std::move(first);
+    while (atToken("OR")) {
+        position++;
+        if (!parseAnd(*node.add_children())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool QueryParser::parseAnd(QueryNode &node) {
+    QueryNode first;
+    if (!parseUnary(first)) {
+        return false;
+    }
+    if (!atToken("AND") && !startsOperand()) {
+        node = std::move(first);
+        return true;
+    }
+
+    node.Clear();
+    node.set_type(QueryNode::AND);
+    *node.add_children() = std::move(first);
+    while (atToken("AND") || startsOperand()) {
+        if (atToken("AND")) {
+            position++;
+        }
+        if (!parseUnary(*node.add_children())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool QueryParser::parseUnary(QueryNode &node) {
+    if (position >= tokens.size()) {
+        error = "The query ends where a term was expected.";
+        return false;
+    }
+
+    if (atToken("NOT")) {
+        position++;
+        node.set_type(QueryNode::NOT);
+        return parseUnary(*node.add_children());
+    }
+
+    if (atToken("(")) {
+        position++;
+        if (!parseOr(node)) {
+            return false;
+        }
+        if (!atToken(")")) {
+            error = "Missing ')' in the query.";
+            return false;
+        }
+        position++;
+        if (position < tokens.size() && tokens[position].starts_with("~")) {
+            return parseMinimumShouldMatch(node);
+        }
+        return true;
+    }
+
+    if (atToken(")") || atToken("AND") || atToken("OR")) {
+        error = "Unexpected '" + tokens[position] + "' where a term was expected.";
+        return false;
+    }
+
+    // checked here so a mistake is reported instead of matching nothing on the server
+    const std::string &term = tokens[position];
+    if (term.starts_with("/")) {
+        if (term.size() < 2 || !term.ends_with("/")) {
+            error = "Missing '/' at the end of the regular expression " + term + ".";
+            return false;
+        }
+        if (term.size() - 2 > MAX_REGEX_LENGTH) {
+            error = "The regular expression " + term.substr(0, 32) + "... is longer than " + std::to_string(MAX_REGEX_LENGTH) + " characters.";
+            return false;
+        }
+        try {
+            std::regex(term.begin() + 1, term.end() - 1);
+        } catch (const std::regex_error &regexError) {
+            error = "Invalid regular expression " + term + ": " + regexError.what();
+            return false;
+        }
+    } else if (size_t tilde = term.rfind('~'); tilde != std::string::npos) {
+        // the distance can be left out for the default of 2
+        size_t distance = 2;
+        const char *last = term.data() + term.size();
+        auto [end, status] = std::from_chars(term.data() + tilde + 1, last, distance);
+        bool validDistance = tilde + 1 == term.size() || (status == std::errc() && end == last);
+        if (tilde == 0 || !validDistance || distance < 1 || distance > 2) {
+            error = "'" + term + "' needs a word followed by '~' and an edit distance of 1 or 2.";
+            return false;
+        }
+        if (term.find_first_of("*?") < tilde) {
+            error = "The fuzzy word " + term + " cannot hold wildcards.";
+            return false;
+        }
+    }
+
+    node.set_type(QueryNode::TERM);
+    node.set_term(tokens[position++]);
+    return true;
+}
+
+// turns the group just parsed into an OR of its operands that needs the given number of them
+bool QueryParser::parseMinimumShouldMatch(QueryNode &node) {
+    const std::string &token = tokens[position++];
+    int minimum = 0;
+    auto [end, status] = std::from_chars(token.data() + 1, token.data() + token.size(), minimum);
+    if (status != std::errc() || end != token.data() + token.size()) {
+        minimum = 0;
+    }
+
+    QueryNode group = std::move(node);
+    node.Clear();
+    node.set_type(QueryNode::OR);
+    if (group.type() == QueryNode::AND || (group.type() == QueryNode::OR && group.minimum_should_match() <= 1)) {
+        node.mutable_children()->Swap(group.mutable_children());
+    } else {
+        *node.add_children() = std::move(group);
+    }
+
+    if (minimum < 1 || minimum > node.children_size()) {
+        error = "'" + token + "' needs a number between 1 and the " + std::to_string(node.children_size()) + " operands of the group.";
+        return false;
+    }
+    node.set_minimum_should_match(minimum);
+    return true;
+}
@@ -0,0 +1,18 @@
+#include "QueryScratch.hpp"
+
+#include <algorithm>
+
+void QueryScratch::resetAccumulator(uint32_t documentNumberBound) {
+    if (scores.size() < documentNumberBound) {
+        scores.resize(documentNumberBound);
+        matchCounts.resize(documentNumberBound);
+        generations.resize(documentNumberBound, 0);
+    }
+    touched.clear();
+
+    // generation 0 marks entries never used, after a wrap every tag is stale again
+    if (++generation == 0) {
+        std::fill(generations.begin(), generations.end(), 0);
+        generation = 1;
+    }
+}
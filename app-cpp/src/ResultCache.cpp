@@ -0,0 +1,62 @@
+#include "ResultCache.hpp"
+
+ResultCache::ResultCache(size_t capacityBytes) : capacityBytes(capacityBytes) {}
+
+void ResultCache::erase(std::list<Entry>::iterator entry) {
+    usedBytes -= entry->bytes;
+    entryByKey.erase(entry->key);
+    entries.erase(entry);
+}
+
+bool ResultCache::find(const std::string &key, uint64_t generation, ReplyMessages &reply) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto itr = entryByKey.find(key);
+    if (itr == entryByKey.end()) {
+        misses++;
+        return false;
+    }
+
+    // a stale entry will never be served again
+    if (itr->second->generation != generation) {
+        erase(itr->second);
+        misses++;
+        return false;
+    }
+
+    entries.splice(entries.begin(), entries, itr->second);
+    reply = itr->second->reply;
+    hits++;
+    return true;
+}
+
+void ResultCache::insert(const std::string &key, uint64_t generation, ReplyMessages reply) {
+    size_t size = key.size();
+    for (const std::string &message : *reply) {
+        size += message.size();
+    }
+    if (size > capacityBytes) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto itr = entryByKey.find(key);
+    if (itr != entryByKey.end()) {
+        // computed at an older generation than the entry there, keep the newer one
+        if (itr->second->generation > generation) {
+            return;
+        }
+        erase(itr->second);
+    }
+
+    while (usedBytes + size > capacityBytes) {
+        erase(std::prev(entries.end()));
+    }
+    entries.push_front({key, generation, std::move(reply), size});
+    entryByKey[key] = entries.begin();
+    usedBytes += size;
+}
+
+ResultCacheStats ResultCache::stats() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return {hits, misses, entries.size(), usedBytes};
+}
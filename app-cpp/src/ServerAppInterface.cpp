@@ -11,7 +11,7 @@ void ServerAppInterface::readCommands() {
     std::string command;
     
     while (true) {
-        std::cout << "> <list | quit>  ";
+        std::cout << "> <list | cache | quit>  ";
         
         // read from command line
         std::getline(std::cin, command);
@@ -34,6 +34,16 @@ void ServerAppInterface::readCommands() {
                     std::cout << clientInfo << std::endl;
                 }
             }
+        }
+
+        // cache prints how often searches were answered from the result cache or by a search already running
+        else if (command == "cache") {
+            ResultCacheStats stats = engine->getCacheStats();
+            uint64_t lookups = stats.hits + stats.misses;
+            double hitRate = lookups > 0 ? 100.0 * stats.hits / lookups : 0.0;
+            std::cout << "hits: " << stats.hits << ", misses: " << stats.misses << ", hit rate: " << hitRate << "%"
+                      << ", entries: " << stats.entries << ", bytes: " << stats.bytes
+                      << ", coalesced: " << engine->getCoalescedSearches() << std::endl;
         } else {
         std::cout << "unrecognized command!" << std::endl;
 
@@ -11,9 +11,160 @@
 #include <fcntl.h>
 #include <cstddef> 
 #include <algorithm> 
+#include <random>
+#include <sstream>
+#include <iomanip>
+#include <charconv>
+#include <cerrno>
+#include <chrono>
+
+namespace {
+    constexpr size_t DEFAULT_SEARCH_RESULTS = 10;
+    // a client asking for more still gets only this many per page
+    constexpr size_t MAX_SEARCH_RESULTS = 100000;
+    // pages end at this many documents, deeper ones would keep too large a top k
+    constexpr size_t MAX_RESULT_WINDOW = 1000000;
+    // bytes of keys and replies the result cache holds
+    constexpr size_t RESULT_CACHE_BYTES = 64 << 20;
+
+    BooleanQuery makeQuery(BooleanQuery::Operator op, const std::string &term = "") {
+        BooleanQuery query;
+        query.op = op;
+        query.term = term;
+        return query;
+    }
+
+    BooleanQuery fromQueryNode(const QueryNode &node) {
+        BooleanQuery query;
+        switch (node.type()) {
+            case QueryNode::AND: query.op = BooleanQuery::Operator::AND; break;
+            case QueryNode::OR: query.op = BooleanQuery::Operator::OR; break;
+            case QueryNode::NOT: query.op = BooleanQuery::Operator::NOT; break;
+            default: query.op = BooleanQuery::Operator::TERM; break;
+        }
+        query.term = node.term();
+        query.minimumShouldMatch = std::max(node.minimum_should_match(), 1);
+        for (const QueryNode &child : node.children()) {
+            query.children.push_back(fromQueryNode(child));
+        }
+        return query;
+    }
+
+    // Flat form: logical_operators[i] joins terms[i] and terms[i + 1]. NOT stands for
+    // AND NOT, and AND and NOT bind tighter than OR.
+    BooleanQuery fromLogicalOperators(const SearchRequest &request) {
+        BooleanQuery query = makeQuery(BooleanQuery::Operator::OR);
+        query.children.push_back(makeQuery(BooleanQuery::Operator::AND));
+
+        for (int i = 0; i < request.terms_size(); i++) {
+            const std::string &joiner = i > 0 && i - 1 < request.logical_operators_size() ? request.logical_operators(i - 1) : "AND";
+            if (joiner == "OR") {
+                query.children.push_back(makeQuery(BooleanQuery::Operator::AND));
+            }
+            BooleanQuery term = makeQuery(BooleanQuery::Operator::TERM, request.terms(i));
+            if (joiner == "NOT") {
+                BooleanQuery notTerm = makeQuery(BooleanQuery::Operator::NOT);
+                notTerm.children.push_back(std::move(term));
+                query.children.back().children.push_back(std::move(notTerm));
+            } else {
+                query.children.back().children.push_back(term);
+            }
+        }
+        return query;
+    }
+
+    // true once the client closed its end of the connection or it broke, a request it
+    // already sent next does not count
+    bool clientGone(int clientSocket) {
+        char byte;
+        ssize_t result = recv(clientSocket, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+        return result == 0 || (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+    }
+
+    // plain terms, all of which must match
+    BooleanQuery fromTerms(const SearchRequest &request) {
+        BooleanQuery query = makeQuery(BooleanQuery::Operator::AND);
+        for (const std::string &term : request.terms()) {
+            query.children.push_back(makeQuery(BooleanQuery::Operator::TERM, term));
+        }
+        return query;
+    }
+
+    // The same string for queries that only differ in the order of the children of their
+    // ANDs and ORs. Repeated terms are kept since every occurrence adds to the score, and
+    // terms carry their length so that no term can pass for the syntax around it.
+    std::string normalizeQuery(const BooleanQuery &query) {
+        if (query.op == BooleanQuery::Operator::TERM) {
+            return std::to_string(query.term.size()) + ":" + query.term;
+        }
+
+        std::vector<std::string> children;
+        for (const BooleanQuery &child : query.children) {
+            children.push_back(normalizeQuery(child));
+        }
+        std::sort(children.begin(), children.end());
+
+        std::string normalized;
+        switch (query.op) {
+            case BooleanQuery::Operator::AND: normalized = "AND"; break;
+            case BooleanQuery::Operator::OR: normalized = "OR~" + std::to_string(query.minimumShouldMatch); break;
+            default: normalized = "NOT"; break;
+        }
+        normalized += "(";
+        for (size_t i = 0; i < children.size(); i++) {
+            normalized += (i > 0 ? "," : "") + children[i];
+        }
+        return normalized + ")";
+    }
+
+    // the reply is cached as the messages it is split into, so the chunk size is part of the key
+    std::string resultCacheKey(const BooleanQuery &query, size_t offset, size_t k, Ranking ranking, size_t chunkSize) {
+        return (ranking == Ranking::BM25 ? "bm25 " : "frequency ") + std::to_string(offset) + "+" + std::to_string(k) + "/"
+               + std::to_string(chunkSize) + " " + normalizeQuery(query);
+    }
+
+    // count and exists replies do not depend on the ranking or the page
+    std::string resultCacheKey(const BooleanQuery &query, SearchRequest::Mode mode) {
+        return (mode == SearchRequest::COUNT ? "count " : "exists ") + normalizeQuery(query);
+    }
 
+    // The continuation token is the offset of the next page. Clients treat it as opaque,
+    // so it can carry more later on.
+    std::string continuationToken(size_t offset) {
+        return std::to_string(offset);
+    }
 
-ServerProcessingEngine::ServerProcessingEngine(std::shared_ptr<IndexStore> store) : store(store), running(true) {}
+    bool parseContinuationToken(const std::string &token, size_t &offset) {
+        auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), offset);
+        return error == std::errc() && end == token.data() + token.size();
+    }
+}
+
+ServerProcessingEngine::ServerProcessingEngine(std::shared_ptr<IndexStore> store) : store(store), queryEngine(store), resultCache(RESULT_CACHE_BYTES), running(true) {
+    std::random_device randomDevice;
+    std::ostringstream idStream;
+    idStream << std::hex << std::setfill('0') << std::setw(8) << randomDevice() << std::setw(8) << randomDevice();
+    serverID = idStream.str();
+}
+
+
+// Sends a reply prefixed with its size in network byte order, handling partial sends
+bool ServerProcessingEngine::sendMessage(int clientSocket, const std::string &message) {
+    uint32_t sizeToSend = htonl(static_cast<uint32_t>(message.size()));
+    std::string frame(reinterpret_cast<const char *>(&sizeToSend), sizeof(sizeToSend));
+    frame += message;
+
+    size_t bytesSent = 0;
+    while (bytesSent < frame.size()) {
+        ssize_t result = send(clientSocket, frame.data() + bytesSent, frame.size() - bytesSent, 0);
+        if (result < 0) {
+            std::cerr << "Error sending reply: " << strerror(errno) << std::endl;
+            return false;
+        }
+        bytesSent += result;
+    }
+    return true;
+}
 
 void ServerProcessingEngine::initialize(int serverPort) {
     dispatcherThread = std::thread(&ServerProcessingEngine::runDispatcher, this, serverPort);
@@ -115,6 +266,9 @@ void ServerProcessingEngine::runDispatcher(int serverPort) {
 
 std::vector<DocPathFreqPair> ServerProcessingEngine::runWorker(int clientSocket, const std::string &clientName)
 {
+    // reused by every query of this client
+    QueryScratch scratch;
+
     while (true)
     {
         uint32_t dataSize;
@@ -144,6 +298,12 @@ std::vector<DocPathFreqPair> ServerProcessingEngine::runWorker(int clientSocket,
             if (indexRequest.ParseFromString(actualMessage))
             {
 
+                // a replaced document is deleted and comes back under a new number
+                if (indexRequest.replace_document_number() != 0)
+                {
+                    store->deleteDocument(indexRequest.replace_document_number());
+                }
+
                 long documentNumber = store->putDocument(indexRequest.document_path(), clientName);
                 std::unordered_map<std::string, long> wordFrequenciesMap;
 
@@ -154,111 +314,80 @@ std::vector<DocPathFreqPair> ServerProcessingEngine::runWorker(int clientSocket,
 
                 store->updateIndex(documentNumber, wordFrequenciesMap);
 
-                std::string reply = "Index updated successfully";
-                send(clientSocket, reply.c_str(), reply.size(), 0);
+                IndexReply indexReply;
+                indexReply.set_status("Index updated successfully");
+                indexReply.set_document_number(documentNumber);
+                sendMessage(clientSocket, indexReply.SerializeAsString());
 
             } else {
                 std::cerr << "Failed to parse IndexRequest." << std::endl;
             }
 
-        } else if (receivedMessage.starts_with("SEARCH:")) {
-            std::string actualMessage = receivedMessage.substr(strlen("SEARCH:"));
-            SearchRequest searchRequest;
+        } else if (receivedMessage.starts_with("DELETE:")) {
+            std::string actualMessage = receivedMessage.substr(strlen("DELETE:"));
+            DeleteRequest deleteRequest;
 
-            if (searchRequest.ParseFromString(actualMessage))
+            IndexReply indexReply;
+            if (deleteRequest.ParseFromString(actualMessage))
             {
-
-                std::unordered_map<long, long> combinedResults;  
-
-                for (const auto &term : searchRequest.terms())
+                for (long documentNumber : deleteRequest.document_numbers())
                 {
-                    if (term.empty())
-                        continue;
-
-                    auto termResults = store->lookupIndex(term); 
-
-                    if (termResults.empty())
-                    {
-                        continue;
-                    }
-
-                    if (combinedResults.empty())
-                    {
-                        for (const auto &result : termResults)
-                        {
-                            combinedResults[result.documentNumber] = result.wordFrequency;
-                        }
-                    }
-                    else
-                    {
-                        
-                        std::unordered_map<long, long> currentResults;
-                        for (const auto &result : termResults)
-                        {
-                            if (combinedResults.count(result.documentNumber))
-                            {
-                                currentResults[result.documentNumber] = combinedResults[result.documentNumber] + result.wordFrequency;
-                            }
-                        }
-                        combinedResults = std::move(currentResults); 
-                    }
+                    store->deleteDocument(documentNumber);
                 }
+                indexReply.set_status("Documents deleted successfully");
+            } else {
+                std::cerr << "Failed to parse DeleteRequest." << std::endl;
+                indexReply.set_status("Failed to parse DeleteRequest");
+            }
+            sendMessage(clientSocket, indexReply.SerializeAsString());
 
+        } else if (receivedMessage == "HELLO") {
+            HelloReply helloReply;
+            helloReply.set_server_id(serverID);
+            helloReply.set_client_name(clientName);
+            sendMessage(clientSocket, helloReply.SerializeAsString());
 
-                SearchReply searchReply;
-                searchReply.set_execution_time(0.0); 
-
-                if (combinedResults.empty())
-                {
-                    std::cout << "No documents match all search terms." << std::endl;
-
-                    searchReply.set_total_results(0);
-                    
-                }
-                else
-                {
-                    // Prepare sorted results
-                    std::vector<std::pair<long, long>> sortedResults(combinedResults.begin(), combinedResults.end());
-                    std::sort(sortedResults.begin(), sortedResults.end(),
-                              [](const auto &a, const auto &b)
-                              { return a.second > b.second; });
-                    if (sortedResults.size() > 10)
-                    {
-                        sortedResults.resize(10); 
-                    }
-
-                    for (const auto &result : sortedResults)
-                    {
-                        long docNumber = result.first;
-                        long frequency = result.second;
-
-                        SearchReply::Document *doc = searchReply.add_documents();
-                        DocumentInfo docInfo = store->getDocument(docNumber);
-                        doc->set_document_path(docInfo.docPath); 
-                        doc->set_frequency(frequency);
-                        doc->set_client_id(docInfo.origin);
-                    }
-
-                    searchReply.set_total_results(sortedResults.size());
-                }
-
-
-                std::string searchReplyData;
-                searchReply.SerializeToString(&searchReplyData);
-
-
-                uint32_t sizeToSend = htonl(static_cast<uint32_t>(searchReplyData.size()));
-                char replyBuffer[sizeof(sizeToSend) + searchReplyData.size()];
-                memcpy(replyBuffer, &sizeToSend, sizeof(sizeToSend));
-                memcpy(replyBuffer + sizeof(sizeToSend), searchReplyData.data(), searchReplyData.size());
+        } else if (receivedMessage.starts_with("SEARCH:")) {
+            std::string actualMessage = receivedMessage.substr(strlen("SEARCH:"));
+            SearchRequest searchRequest;
 
-                send(clientSocket, replyBuffer, sizeof(sizeToSend) + searchReplyData.size(), 0);
+            if (searchRequest.ParseFromString(actualMessage))
+            {
+                sendSearchReply(clientSocket, evaluateSearch(searchRequest, std::max(searchRequest.chunk_size(), 0), scratch, clientSocket));
                 continue;
             }
             else
             {
                 std::cerr << "Failed to parse SearchRequest." << std::endl;
             }
+        } else if (receivedMessage.starts_with("BATCH:")) {
+            std::string actualMessage = receivedMessage.substr(strlen("BATCH:"));
+            BatchSearchRequest batchRequest;
+
+            if (batchRequest.ParseFromString(actualMessage)) {
+                // the searches are dealt out over the query pool, every part with its own scratch
+                size_t searchCount = batchRequest.searches_size();
+                std::vector<ReplyMessages> replies(searchCount);
+                ThreadPool &pool = queryEngine.threadPool();
+                size_t parts = std::min(searchCount, pool.size() + 1);
+                pool.parallelFor(parts, [&](size_t part) {
+                    QueryScratch partScratch;
+                    QueryScratch &partOwnScratch = part == 0 ? scratch : partScratch;
+                    for (size_t i = part; i < searchCount; i += parts) {
+                        const SearchRequest &searchRequest = batchRequest.searches(i);
+                        replies[i] = evaluateSearch(searchRequest, std::max(searchRequest.chunk_size(), 0), partOwnScratch, clientSocket);
+                    }
+                });
+
+                // every search is sent as it would be on its own, in the order asked
+                for (const ReplyMessages &reply : replies) {
+                    if (!sendSearchReply(clientSocket, reply)) {
+                        break;
+                    }
+                }
+            } else {
+                std::cerr << "Failed to parse BatchSearchRequest." << std::endl;
+            }
         } else if(receivedMessage.contains("QUIT")) {
             std::cout << "Client sent QUIT message." << std::endl;
 
@@ -290,6 +419,135 @@ std::vector<DocPathFreqPair> ServerProcessingEngine::runWorker(int clientSocket,
 }
 
 
+// The reply to a search as the messages it is sent in, at most chunkSize documents each
+// unless chunkSize is 0: from the result cache, from the same search running for another
+// client, or evaluated here.
+ReplyMessages ServerProcessingEngine::evaluateSearch(const SearchRequest &searchRequest, size_t chunkSize, QueryScratch &scratch, int clientSocket)
+{
+    size_t k = searchRequest.k() > 0 ? std::min<size_t>(searchRequest.k(), MAX_SEARCH_RESULTS) : DEFAULT_SEARCH_RESULTS;
+    Ranking ranking = searchRequest.ranking() == SearchRequest::BM25 ? Ranking::BM25 : Ranking::FREQUENCY;
+    BooleanQuery query;
+    if (searchRequest.has_query()) {
+        query = fromQueryNode(searchRequest.query());
+    } else if (searchRequest.logical_operators_size() > 0) {
+        query = fromLogicalOperators(searchRequest);
+    } else {
+        query = fromTerms(searchRequest);
+    }
+
+    size_t offset = std::max(searchRequest.offset(), 0);
+    if (!searchRequest.continuation_token().empty() && !parseContinuationToken(searchRequest.continuation_token(), offset)) {
+        std::cerr << "Invalid continuation token, starting from the first page." << std::endl;
+        offset = 0;
+    }
+    offset = std::min(offset, MAX_RESULT_WINDOW);
+    k = std::min(k, MAX_RESULT_WINDOW - offset);
+
+    // count and exists skip the ranking and the document table, their reply is just the number
+    SearchRequest::Mode mode = searchRequest.mode();
+    bool countOnly = mode == SearchRequest::COUNT || mode == SearchRequest::EXISTS;
+
+    // read before evaluating, a change made meanwhile leaves the cached reply stale
+    uint64_t generation = store->generation();
+    std::string cacheKey = countOnly ? resultCacheKey(query, mode) : resultCacheKey(query, offset, k, ranking, chunkSize);
+    ReplyMessages cachedReply;
+    if (resultCache.find(cacheKey, generation, cachedReply)) {
+        return cachedReply;
+    }
+
+    // the search stops at its deadline or once its client hangs up, whichever comes first
+    auto deadline = searchRequest.time_budget_ms() > 0
+                    ? std::chrono::steady_clock::now() + std::chrono::milliseconds(searchRequest.time_budget_ms())
+                    : std::chrono::steady_clock::time_point::max();
+    QueryBudget budget(deadline, [clientSocket] { return clientGone(clientSocket); });
+
+    // The same search already running for another client with the same budget answers this
+    // one too. A partial reply is neither shared nor cached, it only holds for its own client.
+    std::string flightKey = cacheKey + " @" + std::to_string(generation) + " " + std::to_string(searchRequest.time_budget_ms()) + "ms";
+    return searchFlights.run(flightKey, [&](ReplyMessages &replyData) {
+        if (countOnly) {
+            SearchReply countReply;
+            countReply.set_total_results(mode == SearchRequest::COUNT ? queryEngine.count(query, &budget) : queryEngine.exists(query, &budget));
+            countReply.set_total_is_estimate(budget.stopped());
+            countReply.set_partial(budget.stopped());
+            replyData = std::make_shared<const std::vector<std::string>>(1, countReply.SerializeAsString());
+            if (budget.stopped()) {
+                return false;
+            }
+            resultCache.insert(cacheKey, generation, replyData);
+            return true;
+        }
+
+        // the page is the tail of the best offset + k documents
+        HitCount hits;
+        std::vector<ScoredDocument> topResults = queryEngine.search(query, offset + k, ranking, &scratch, &hits, &budget);
+
+        SearchReply header;
+        header.set_execution_time(0.0); 
+        header.set_total_results(hits.total);
+        header.set_total_is_estimate(!hits.exact);
+        header.set_partial(budget.stopped());
+
+        if (topResults.empty())
+        {
+            std::cout << "No documents match all search terms." << std::endl;
+        }
+
+        // a full page may have more behind it, unless the total says otherwise
+        size_t pageEnd = offset + k;
+        if (k > 0 && topResults.size() == pageEnd && pageEnd < MAX_RESULT_WINDOW && (!hits.exact || hits.total > pageEnd)) {
+            header.set_continuation_token(continuationToken(pageEnd));
+        }
+
+        // The documents go straight into the messages they are sent in. Every message carries
+        // all the other fields of the reply and is flagged when another one follows, so a
+        // client can handle a large page as it arrives.
+        size_t pageSize = topResults.size() > offset ? topResults.size() - offset : 0;
+        size_t perMessage = chunkSize > 0 ? chunkSize : std::max<size_t>(pageSize, 1);
+        auto messages = std::make_shared<std::vector<std::string>>();
+        for (size_t begin = 0; begin == 0 || begin < pageSize; begin += perMessage)
+        {
+            SearchReply chunk = header;
+            for (size_t i = offset + begin; i < offset + std::min(begin + perMessage, pageSize); i++)
+            {
+                long docNumber = topResults[i].documentNumber;
+
+                SearchReply::Document *doc = chunk.add_documents();
+                DocumentInfo docInfo = store->getDocument(docNumber);
+                doc->set_document_path(docInfo.docPath); 
+                if (ranking == Ranking::BM25) {
+                    doc->set_score(topResults[i].score);
+                } else {
+                    doc->set_frequency(static_cast<long>(topResults[i].score));
+                }
+                doc->set_client_id(docInfo.origin);
+            }
+            chunk.set_more_chunks(begin + perMessage < pageSize);
+            messages->push_back(chunk.SerializeAsString());
+        }
+        replyData = std::move(messages);
+
+        if (budget.stopped()) {
+            return false;
+        }
+        resultCache.insert(cacheKey, generation, replyData);
+        return true;
+    });
+}
+
+
+// writes the messages of a search reply in order, stopping at the first that fails
+bool ServerProcessingEngine::sendSearchReply(int clientSocket, const ReplyMessages &reply)
+{
+    for (const std::string &message : *reply) {
+        if (!sendMessage(clientSocket, message)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
 void ServerProcessingEngine::shutdown() {
     running = false; 
 
@@ -317,4 +575,16 @@ std::vector<std::string> ServerProcessingEngine::getConnectedClients()
         clientList.push_back(clientInfo);
     }
     return clientList;
+}
+
+
+ResultCacheStats ServerProcessingEngine::getCacheStats()
+{
+    return resultCache.stats();
+}
+
+
+uint64_t ServerProcessingEngine::getCoalescedSearches()
+{
+    return searchFlights.joinedCount();
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "SingleFlight.hpp"
+
+ReplyMessages SingleFlight::run(const std::string &key, const std::function<bool(ReplyMessages &result)> &evaluate) {
+    std::shared_ptr<Flight> flight;
+    {
+        std::unique_lock<std::mutex> lock(flightsMutex);
+        auto itr = flights.find(key);
+        if (itr != flights.end()) {
+            // the flight stays alive through the shared_ptr after its leader removed it
+            flight = itr->second;
+            flight->doneCv.wait(lock, [&flight] { return flight->done; });
+            if (flight->shared) {
+                joined++;
+                return flight->result;
+            }
+            lock.unlock();
+
+            ReplyMessages result;
+            evaluate(result);
+            return result;
+        }
+        flight = std::make_shared<Flight>();
+        flights.emplace(key, flight);
+    }
+
+    ReplyMessages result;
+    bool shared = evaluate(result);
+
+    {
+        std::lock_guard<std::mutex> lock(flightsMutex);
+        if (shared) {
+            flight->result = result;
+        }
+        flight->shared = shared;
+        flight->done = true;
+        flights.erase(key);
+    }
+    flight->doneCv.notify_all();
+    return result;
+}
@@ -0,0 +1,153 @@
+#include "TermDictionary.hpp"
+
+#include <algorithm>
+
+void TermDictionary::putVarint(std::string &out, size_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+size_t TermDictionary::getVarint(const std::string &in, size_t &offset) {
+    size_t value = 0;
+    for (int shift = 0;; shift += 7) {
+        uint8_t byte = static_cast<uint8_t>(in[offset++]);
+        value |= static_cast<size_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+}
+
+size_t TermDictionary::decodeNext(size_t offset, std::string &term) const {
+    size_t shared = getVarint(codedTerms, offset);
+    size_t suffixLength = getVarint(codedTerms, offset);
+    term.resize(shared);
+    term.append(codedTerms, offset, suffixLength);
+    return offset + suffixLength;
+}
+
+// the first term of a block has nothing shared with the one before
+std::string_view TermDictionary::firstTerm(size_t block) const {
+    size_t offset = blockOffsets[block];
+    getVarint(codedTerms, offset);
+    size_t length = getVarint(codedTerms, offset);
+    return std::string_view(codedTerms).substr(offset, length);
+}
+
+size_t TermDictionary::firstBlockFor(std::string_view target, size_t fromBlock) const {
+    size_t low = fromBlock;
+    size_t high = blockOffsets.size();
+    if (fromBlock > 0) {
+        // the blocks after fromBlock are probed 1, 2, 4, ... ahead until one is past the target
+        for (size_t step = 1; low + step < high; step *= 2) {
+            if (firstTerm(low + step) >= target) {
+                high = low + step;
+                break;
+            }
+            low += step;
+        }
+    }
+
+    while (high - low > 1) {
+        size_t middle = low + (high - low) / 2;
+        if (firstTerm(middle) < target) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+void TermDictionary::add(const std::string &term) {
+    recentTerms.insert(term);
+    if (recentTerms.size() >= std::max(MIN_MERGE_TERMS, codedCount / MERGE_RATIO)) {
+        merge();
+    }
+}
+
+void TermDictionary::assign(std::vector<std::string> terms) {
+    std::sort(terms.begin(), terms.end());
+
+    codedTerms.clear();
+    blockOffsets.clear();
+    recentTerms.clear();
+    codedCount = terms.size();
+
+    std::string_view previous;
+    for (size_t i = 0; i < terms.size(); i++) {
+        size_t shared = 0;
+        if (i % BLOCK_SIZE == 0) {
+            blockOffsets.push_back(codedTerms.size());
+        } else {
+            size_t limit = std::min(previous.size(), terms[i].size());
+            while (shared < limit && previous[shared] == terms[i][shared]) {
+                shared++;
+            }
+        }
+        putVarint(codedTerms, shared);
+        putVarint(codedTerms, terms[i].size() - shared);
+        codedTerms.append(terms[i], shared);
+        previous = terms[i];
+    }
+    codedTerms.shrink_to_fit();
+}
+
+void TermDictionary::merge() {
+    std::vector<std::string> terms;
+    terms.reserve(size());
+    forEachWithPrefix("", [&terms](const std::string &term) { terms.push_back(term); });
+    assign(std::move(terms));
+}
+
+TermDictionary::Cursor::Cursor(const TermDictionary &dictionary) : dictionary(dictionary) {
+    seek("");
+}
+
+void TermDictionary::Cursor::nextCoded() {
+    onCodedTerm = nextOffset < dictionary.codedTerms.size();
+    if (!onCodedTerm) {
+        return;
+    }
+    if (block + 1 < dictionary.blockOffsets.size() && nextOffset == dictionary.blockOffsets[block + 1]) {
+        block++;
+    }
+    nextOffset = dictionary.decodeNext(nextOffset, codedTerm);
+}
+
+void TermDictionary::Cursor::seek(std::string_view target) {
+    recentTerm = dictionary.recentTerms.lower_bound(target);
+    if (dictionary.codedCount == 0) {
+        onCodedTerm = false;
+        return;
+    }
+
+    // Moving forward the search starts from the current block, and within it decoding goes
+    // on from the current term. Otherwise it starts at the first term of the block, which is
+    // written out in full.
+    bool forward = onCodedTerm && codedTerm < target;
+    size_t targetBlock = dictionary.firstBlockFor(target, forward ? block : 0);
+    if (!forward || targetBlock != block) {
+        block = targetBlock;
+        codedTerm.clear();
+        nextOffset = dictionary.blockOffsets[block];
+        onCodedTerm = nextOffset < dictionary.codedTerms.size();
+        if (onCodedTerm) {
+            nextOffset = dictionary.decodeNext(nextOffset, codedTerm);
+        }
+    }
+    while (onCodedTerm && codedTerm < target) {
+        nextCoded();
+    }
+}
+
+void TermDictionary::Cursor::next() {
+    if (atCoded()) {
+        nextCoded();
+    } else {
+        ++recentTerm;
+    }
+}
@@ -0,0 +1,82 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    for (size_t i = 0; i < threadCount; i++) {
+        threads.emplace_back(&ThreadPool::runThread, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(tasksMutex);
+        stopping = true;
+    }
+    tasksCv.notify_all();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::runThread() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(tasksMutex);
+            tasksCv.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)> &function) {
+    // A helper can start after the caller already finished every index, so the state it
+    // touches is shared instead of living on the caller's stack. function is only called
+    // for a claimed index, and the caller waits for all of those.
+    struct Progress {
+        std::atomic<size_t> nextIndex = 0;
+        size_t finished = 0;
+        std::mutex finishedMutex;
+        std::condition_variable finishedCv;
+    };
+    auto progress = std::make_shared<Progress>();
+
+    auto work = [progress, count, &function] {
+        size_t done = 0;
+        for (size_t index = progress->nextIndex++; index < count; index = progress->nextIndex++) {
+            function(index);
+            done++;
+        }
+        if (done > 0) {
+            std::lock_guard<std::mutex> lock(progress->finishedMutex);
+            progress->finished += done;
+            if (progress->finished == count) {
+                progress->finishedCv.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(threads.size(), count > 0 ? count - 1 : 0);
+    if (helpers > 0) {
+        {
+            std::lock_guard<std::mutex> lock(tasksMutex);
+            for (size_t i = 0; i < helpers; i++) {
+                tasks.push_back(work);
+            }
+        }
+        tasksCv.notify_all();
+    }
+
+    work();
+
+    std::unique_lock<std::mutex> lock(progress->finishedMutex);
+    progress->finishedCv.wait(lock, [&progress, count] { return progress->finished == count; });
+}
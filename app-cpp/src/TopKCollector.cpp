@@ -0,0 +1,34 @@
+#include "TopKCollector.hpp"
+
+#include <algorithm>
+
+TopKCollector::TopKCollector(size_t k) : k(k) {}
+
+void TopKCollector::collect(long documentNumber, double score) {
+    matches++;
+    ScoredDocument match = {documentNumber, score};
+
+    if (heap.size() < k) {
+        heap.push_back(match);
+        std::push_heap(heap.begin(), heap.end(), ranksBefore);
+        return;
+    }
+    if (k == 0 || !ranksBefore(match, heap.front())) {
+        return;
+    }
+    std::pop_heap(heap.begin(), heap.end(), ranksBefore);
+    heap.back() = match;
+    std::push_heap(heap.begin(), heap.end(), ranksBefore);
+}
+
+void TopKCollector::merge(const TopKCollector &other) {
+    for (const ScoredDocument &match : other.heap) {
+        collect(match.documentNumber, match.score);
+    }
+    matches += other.matches - other.heap.size();
+}
+
+std::vector<ScoredDocument> TopKCollector::takeSorted() {
+    std::sort_heap(heap.begin(), heap.end(), ranksBefore);
+    return std::move(heap);
+}
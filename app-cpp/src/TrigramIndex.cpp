@@ -0,0 +1,316 @@
+#include "TrigramIndex.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <iterator>
+
+namespace {
+    // larger classes are not worth expanding into the strings they can stand for
+    constexpr size_t MAX_CLASS_CHARACTERS = 8;
+    constexpr size_t MAX_ALTERNATIVES = 64;
+
+    uint32_t trigramAt(std::string_view text, size_t position) {
+        return static_cast<uint32_t>(static_cast<uint8_t>(text[position])) << 16
+               | static_cast<uint32_t>(static_cast<uint8_t>(text[position + 1])) << 8
+               | static_cast<uint8_t>(text[position + 2]);
+    }
+
+    void addTrigrams(std::string_view literal, std::vector<uint32_t> &trigrams) {
+        for (size_t i = 0; i + 3 <= literal.size(); i++) {
+            trigrams.push_back(trigramAt(literal, i));
+        }
+    }
+
+    void sortUnique(std::vector<uint32_t> &values) {
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+    }
+
+    // Walks a regular expression keeping only what any match must contain: the runs of
+    // characters and small classes no quantifier makes optional, and the groups that are
+    // not optional themselves. Larger classes, wildcards and escapes like \d end a run.
+    // The analysis stops at a ')' without its '(', dropping a requirement is always safe.
+    class RegexAnalyzer {
+        std::string_view regex;
+        size_t position = 0;
+
+        bool at(char c) const { return position < regex.size() && regex[position] == c; }
+
+        // The characters of a class with no more than MAX_CLASS_CHARACTERS of them, empty for
+        // a larger or negated one or one holding escapes. The class is skipped either way.
+        std::string readClass() {
+            std::string characters;
+            bool expandable = !at('^');
+            if (at('^')) {
+                position++;
+            }
+            if (at(']')) {
+                characters += ']';
+                position++;
+            }
+            while (position < regex.size() && regex[position] != ']') {
+                char c = regex[position];
+                if (c == '\\') {
+                    expandable = false;
+                    position += 2;
+                } else if (position + 2 < regex.size() && regex[position + 1] == '-' && regex[position + 2] != ']') {
+                    for (int range = static_cast<unsigned char>(c); range <= static_cast<unsigned char>(regex[position + 2]); range++) {
+                        characters += static_cast<char>(range);
+                    }
+                    position += 3;
+                } else {
+                    characters += c;
+                    position++;
+                }
+            }
+            position++;
+            if (!expandable || characters.size() > MAX_CLASS_CHARACTERS) {
+                characters.clear();
+            }
+            return characters;
+        }
+
+        // the hex digits of \x and \u and the letter of \c are part of the escape
+        void skipEscape(char escaped) {
+            size_t extra = escaped == 'x' ? 2 : escaped == 'u' ? 4 : escaped == 'c' ? 1 : 0;
+            position = std::min(position + extra, regex.size());
+        }
+
+        // whether the atom just read may be absent, or may repeat, from the quantifier after it
+        void readQuantifier(bool &optional, bool &repeated) {
+            if (at('*') || at('?')) {
+                optional = true;
+                position++;
+            } else if (at('+')) {
+                repeated = true;
+                position++;
+            } else if (at('{')) {
+                size_t close = regex.find('}', position);
+                if (close == std::string_view::npos) {
+                    return;
+                }
+                size_t minimum = 0;
+                std::from_chars(regex.data() + position + 1, regex.data() + close, minimum);
+                optional = minimum == 0;
+                repeated = !optional;
+                position = close + 1;
+            }
+            // a lazy quantifier needs the same characters
+            if ((optional || repeated) && at('?')) {
+                position++;
+            }
+        }
+
+        // A run of characters every match contains in a row. A class makes it one of several
+        // strings, until there would be more than MAX_ALTERNATIVES of them.
+        TrigramQuery concatenation() {
+            TrigramQuery query;
+            std::vector<std::string> run{""};
+            auto endRun = [&query, &run]() {
+                if (run.size() == 1) {
+                    addTrigrams(run.front(), query.trigrams);
+                } else {
+                    // one of the strings too short for a trigram leaves nothing to require
+                    TrigramQuery anyOf;
+                    anyOf.op = TrigramQuery::Operator::OR;
+                    for (const std::string &alternative : run) {
+                        TrigramQuery branch;
+                        addTrigrams(alternative, branch.trigrams);
+                        if (branch.trigrams.empty()) {
+                            anyOf.children.clear();
+                            break;
+                        }
+                        sortUnique(branch.trigrams);
+                        anyOf.children.push_back(std::move(branch));
+                    }
+                    if (!anyOf.children.empty()) {
+                        query.children.push_back(std::move(anyOf));
+                    }
+                }
+                run = {""};
+            };
+            auto extendRun = [&run, &endRun](const std::string &characters) {
+                if (run.size() * characters.size() > MAX_ALTERNATIVES) {
+                    endRun();
+                }
+                std::vector<std::string> extended;
+                for (const std::string &alternative : run) {
+                    for (char c : characters) {
+                        extended.push_back(alternative + c);
+                    }
+                }
+                run = std::move(extended);
+            };
+
+            while (position < regex.size() && !at('|') && !at(')')) {
+                enum class Atom { CHARACTERS, GROUP, OTHER } atom = Atom::CHARACTERS;
+                std::string characters;
+                TrigramQuery group;
+                char c = regex[position++];
+
+                if (c == '(') {
+                    // a lookaround does not consume what it looks at, only a plain group counts
+                    bool lookaround = at('?') && position + 1 < regex.size() && regex[position + 1] != ':';
+                    if (at('?')) {
+                        position += 2;
+                    }
+                    group = alternation();
+                    if (at(')')) {
+                        position++;
+                    }
+                    atom = lookaround ? Atom::OTHER : Atom::GROUP;
+                } else if (c == '\\') {
+                    if (position >= regex.size()) {
+                        break;
+                    }
+                    char escaped = regex[position++];
+                    if (std::isalnum(static_cast<unsigned char>(escaped))) {
+                        skipEscape(escaped);
+                        atom = Atom::OTHER;
+                    } else {
+                        characters = escaped;
+                    }
+                } else if (c == '[') {
+                    characters = readClass();
+                    if (characters.empty()) {
+                        atom = Atom::OTHER;
+                    }
+                } else if (c == '.' || c == '^' || c == '$') {
+                    atom = Atom::OTHER;
+                } else {
+                    characters = c;
+                }
+
+                bool optional = false;
+                bool repeated = false;
+                readQuantifier(optional, repeated);
+
+                if (atom == Atom::CHARACTERS && !optional) {
+                    // a repeated atom ends one run and starts the next
+                    extendRun(characters);
+                    if (repeated) {
+                        endRun();
+                        extendRun(characters);
+                    }
+                    continue;
+                }
+                endRun();
+                if (atom == Atom::GROUP && !optional && !group.matchesAll()) {
+                    query.children.push_back(std::move(group));
+                }
+            }
+            endRun();
+            sortUnique(query.trigrams);
+            return query;
+        }
+
+        public:
+            RegexAnalyzer(std::string_view regex) : regex(regex) {}
+
+            TrigramQuery alternation() {
+                std::vector<TrigramQuery> branches;
+                branches.push_back(concatenation());
+                while (at('|')) {
+                    position++;
+                    branches.push_back(concatenation());
+                }
+                if (branches.size() == 1) {
+                    return std::move(branches.front());
+                }
+
+                // one branch matching any term makes the whole alternation match any term
+                TrigramQuery query;
+                query.op = TrigramQuery::Operator::OR;
+                for (TrigramQuery &branch : branches) {
+                    if (branch.matchesAll()) {
+                        return {};
+                    }
+                    query.children.push_back(std::move(branch));
+                }
+                return query;
+            }
+    };
+}
+
+void TrigramIndex::add(const std::string &term) {
+    uint32_t termId = terms.size();
+    terms.push_back(term);
+
+    std::vector<uint32_t> trigrams;
+    addTrigrams(term, trigrams);
+    sortUnique(trigrams);
+    for (uint32_t trigram : trigrams) {
+        termsByTrigram[trigram].push_back(termId);
+    }
+}
+
+void TrigramIndex::assign(std::vector<std::string> newTerms) {
+    terms.clear();
+    termsByTrigram.clear();
+    for (const std::string &term : newTerms) {
+        add(term);
+    }
+}
+
+std::vector<uint32_t> TrigramIndex::candidates(const TrigramQuery &query) const {
+    if (query.op == TrigramQuery::Operator::OR) {
+        std::vector<uint32_t> result;
+        for (const TrigramQuery &child : query.children) {
+            std::vector<uint32_t> childIds = candidates(child);
+            std::vector<uint32_t> merged;
+            merged.reserve(result.size() + childIds.size());
+            std::set_union(result.begin(), result.end(), childIds.begin(), childIds.end(), std::back_inserter(merged));
+            result = std::move(merged);
+        }
+        return result;
+    }
+
+    // the rarest trigram seeds the result, a trigram no term has leaves nothing
+    std::vector<std::vector<uint32_t>> childIds;
+    for (const TrigramQuery &child : query.children) {
+        childIds.push_back(candidates(child));
+    }
+    std::vector<const std::vector<uint32_t> *> lists;
+    for (uint32_t trigram : query.trigrams) {
+        auto itr = termsByTrigram.find(trigram);
+        if (itr == termsByTrigram.end()) {
+            return {};
+        }
+        lists.push_back(&itr->second);
+    }
+    for (const std::vector<uint32_t> &ids : childIds) {
+        lists.push_back(&ids);
+    }
+    if (lists.empty()) {
+        return {};
+    }
+    std::sort(lists.begin(), lists.end(), [](const auto *a, const auto *b) { return a->size() < b->size(); });
+
+    std::vector<uint32_t> result = *lists.front();
+    for (size_t i = 1; i < lists.size() && !result.empty(); i++) {
+        std::vector<uint32_t> common;
+        std::set_intersection(result.begin(), result.end(), lists[i]->begin(), lists[i]->end(), std::back_inserter(common));
+        result = std::move(common);
+    }
+    return result;
+}
+
+TrigramQuery TrigramIndex::fromPattern(std::string_view pattern) {
+    TrigramQuery query;
+    size_t start = 0;
+    while (start < pattern.size()) {
+        size_t end = pattern.find_first_of("*?", start);
+        if (end == std::string_view::npos) {
+            end = pattern.size();
+        }
+        addTrigrams(pattern.substr(start, end - start), query.trigrams);
+        start = end + 1;
+    }
+    sortUnique(query.trigrams);
+    return query;
+}
+
+TrigramQuery TrigramIndex::fromRegex(std::string_view regex) {
+    return RegexAnalyzer(regex).alternation();
+}
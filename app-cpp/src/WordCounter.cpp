@@ -0,0 +1,127 @@
+#include "WordCounter.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace {
+    constexpr uint64_t FNV_OFFSET = 1469598103934665603ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+    constexpr size_t INITIAL_CAPACITY = 1024;
+    constexpr size_t KEY_BLOCK_SIZE = 64 * 1024;
+}
+
+WordCounter::WordCounter() : keyBlockUsed(KEY_BLOCK_SIZE) {
+    slots.resize(INITIAL_CAPACITY, Slot{0, nullptr, 0, 0});
+    usedSlots.reserve(INITIAL_CAPACITY);
+}
+
+uint64_t WordCounter::hashWord(std::string_view word) {
+    uint64_t hash = FNV_OFFSET;
+    for (char character : word) {
+        hash = (hash ^ static_cast<unsigned char>(character)) * FNV_PRIME;
+    }
+    return hash;
+}
+
+void WordCounter::clear() {
+    for (uint32_t index : usedSlots) {
+        slots[index].data = nullptr;
+    }
+    usedSlots.clear();
+    keyBlocks.clear();
+    keyBlockUsed = KEY_BLOCK_SIZE;
+}
+
+const char *WordCounter::storeKey(std::string_view word) {
+    // words longer than a block get a block of their own, kept in front of the block being filled
+    if (word.size() > KEY_BLOCK_SIZE) {
+        auto position = keyBlocks.empty() ? keyBlocks.end() : keyBlocks.end() - 1;
+        auto block = keyBlocks.insert(position, std::make_unique<char[]>(word.size()));
+        std::copy(word.begin(), word.end(), block->get());
+        return block->get();
+    }
+
+    if (keyBlockUsed + word.size() > KEY_BLOCK_SIZE) {
+        keyBlocks.push_back(std::make_unique<char[]>(KEY_BLOCK_SIZE));
+        keyBlockUsed = 0;
+    }
+    char *key = keyBlocks.back().get() + keyBlockUsed;
+    std::copy(word.begin(), word.end(), key);
+    keyBlockUsed += word.size();
+    return key;
+}
+
+void WordCounter::grow() {
+    std::vector<Slot> oldSlots(slots.size() * 2, Slot{0, nullptr, 0, 0});
+    oldSlots.swap(slots);
+
+    size_t mask = slots.size() - 1;
+    for (uint32_t &index : usedSlots) {
+        const Slot &slot = oldSlots[index];
+        size_t position = slot.hash & mask;
+        while (slots[position].data != nullptr) {
+            position = (position + 1) & mask;
+        }
+        slots[position] = slot;
+        index = static_cast<uint32_t>(position);
+    }
+}
+
+void WordCounter::add(std::string_view word, uint64_t hash, int32_t count) {
+    insert(word, hash, count, false);
+}
+
+void WordCounter::merge(const WordCounter &other) {
+    for (uint32_t index : other.usedSlots) {
+        const Slot &slot = other.slots[index];
+        insert(std::string_view(slot.data, slot.length), slot.hash, slot.count, true);
+    }
+}
+
+void WordCounter::insert(std::string_view word, uint64_t hash, int32_t count, bool copyKey) {
+    // keep the load factor under 3/4 so probe sequences stay short
+    if ((usedSlots.size() + 1) * 4 > slots.size() * 3) {
+        grow();
+    }
+
+    size_t mask = slots.size() - 1;
+    size_t position = hash & mask;
+    while (true) {
+        Slot &slot = slots[position];
+        if (slot.data == nullptr) {
+            const char *key = copyKey ? storeKey(word) : word.data();
+            slot = {hash, key, static_cast<uint32_t>(word.size()), count};
+            usedSlots.push_back(static_cast<uint32_t>(position));
+            return;
+        }
+        if (slot.hash == hash && slot.length == word.size() &&
+            std::string_view(slot.data, slot.length) == word) {
+            slot.count += count;
+            return;
+        }
+        position = (position + 1) & mask;
+    }
+}
+
+void WordCounter::countWords(std::string_view content) {
+    size_t wordStart = 0;
+    uint64_t hash = FNV_OFFSET;
+
+    // the hash is built while scanning so every word is only read once
+    for (size_t i = 0; i < content.size(); i++) {
+        unsigned char character = static_cast<unsigned char>(content[i]);
+        if (std::isalnum(character)) {
+            hash = (hash ^ character) * FNV_PRIME;
+            continue;
+        }
+        if (i - wordStart > 2) {
+            add(content.substr(wordStart, i - wordStart), hash);
+        }
+        wordStart = i + 1;
+        hash = FNV_OFFSET;
+    }
+
+    if (content.size() - wordStart > 2) {
+        add(content.substr(wordStart), hash);
+    }
+}
@@ -7,6 +7,7 @@
 #include <fstream>
 #include <sys/stat.h>
 #include "ClientProcessingEngine.hpp"
+#include "QueryParser.hpp"
 
 void runWorker(ClientProcessingEngine &client, const std::string &datasetPath, long &totalBytesIndexed)
 {
@@ -16,38 +17,11 @@ void runWorker(ClientProcessingEngine &client, const std::string &datasetPath, l
     totalBytesIndexed = result.totalBytesRead;
 }
 
-void performSearch(ClientProcessingEngine &client, const std::string &query)
+// Displays the top 10 results of one search
+void printResults(const std::string &query, const SearchResult &searchResult)
 {
     std::cout << "\nSearching " << query << std::endl;
-    auto start = std::chrono::high_resolution_clock::now();
-    
-    // Split the query if it contains "AND" logic
-    std::vector<std::string> searchTerms;
-    if (query.find("AND") != std::string::npos) {
-        size_t pos = 0;
-        std::string token;
-        std::string delimiter = " AND ";
-        std::string modifiedQuery = query;
-        
-        while ((pos = modifiedQuery.find(delimiter)) != std::string::npos) {
-            token = modifiedQuery.substr(0, pos);
-            searchTerms.push_back(token);
-            modifiedQuery.erase(0, pos + delimiter.length());
-        }
-        searchTerms.push_back(modifiedQuery);  
-    } else {
-        searchTerms.push_back(query);  
-    }
-
-    // Perform the search
-    auto searchResult = client.search(searchTerms);
-
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> searchDuration = end - start;
 
-    std::cout << "Search completed in " << searchDuration.count() << " seconds" << std::endl;
-
-    // Display top 10 search results
     auto &results = searchResult.documentFrequencies;
     size_t resultCount = std::min(results.size(), static_cast<size_t>(10));
     std::cout << "Search results (top " << resultCount << " out of " << results.size() << "):" << std::endl;
@@ -116,10 +90,34 @@ int main(int argc, char **argv)
     std::cout << "Completed indexing in " << totalTime << " seconds";
 
 
-    std::vector<std::string> searchQueries = {"at", "Worms", "distortion AND adaptation"};
+    std::vector<std::string> searchQueries = {"at", "Worms", "distortion AND adaptation", "distortion OR (adaptation NOT Worms)"};
 
+    // Parse the AND/OR/NOT queries into the trees sent to the server
+    std::vector<QueryNode> queryTrees;
     for (const auto &query : searchQueries) {
-        performSearch(clients[0], query);
+        QueryParser parser(query);
+        QueryNode queryTree;
+        if (!parser.parse(queryTree)) {
+            std::cerr << parser.errorMessage() << std::endl;
+            return 1;
+        }
+        queryTrees.push_back(queryTree);
+    }
+
+    // All the searches go to the server in one batch
+    auto searchStart = std::chrono::high_resolution_clock::now();
+    std::vector<SearchResult> searchResults = clients[0].searchBatch(queryTrees);
+    auto searchEnd = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> searchDuration = searchEnd - searchStart;
+
+    if (searchResults.size() != searchQueries.size()) {
+        std::cerr << "Error: The batch search failed." << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nCompleted " << searchQueries.size() << " searches in " << searchDuration.count() << " seconds" << std::endl;
+    for (size_t i = 0; i < searchQueries.size(); ++i) {
+        printResults(searchQueries[i], searchResults[i]);
     }
 
     return 0;
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <memory>
+#include <string>
 
 #include "IndexStore.hpp"
 #include "ServerProcessingEngine.hpp"
@@ -9,8 +10,10 @@ int main(int argc, char** argv)
 {
     // TO-DO change server port to a non-privileged port from argv[1]
     int serverPort = std::stoi(argv[1]);
+    // --trigrams also indexes the terms by trigram, for substring and regular expression searches
+    bool withTrigramIndex = argc > 2 && std::string(argv[2]) == "--trigrams";
 
-    std::shared_ptr<IndexStore> store = std::make_shared<IndexStore>();
+    std::shared_ptr<IndexStore> store = std::make_shared<IndexStore>(withTrigramIndex);
     std::shared_ptr<ServerProcessingEngine> engine = std::make_shared<ServerProcessingEngine>(store);
     std::shared_ptr<ServerAppInterface> interface = std::make_shared<ServerAppInterface>(engine);
 
@@ -0,0 +1,21 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <iostream>
+
+// The tests need no framework: every failed CHECK prints where it is and is counted, and
+// a test's main returns checkFailures() so CTest sees it fail.
+inline int &checkFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                        \
+    do {                                                                                        \
+        if (!(condition)) {                                                                     \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+            checkFailures()++;                                                                  \
+        }                                                                                       \
+    } while (false)
+
+#endif
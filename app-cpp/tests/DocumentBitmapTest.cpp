@@ -0,0 +1,107 @@
+#include "Check.hpp"
+#include "DocumentBitmap.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+    // Documents in four containers: a sparse one, a dense one turned into a bitmap, one
+    // right at the array limit and a small one under lastKey.
+    std::set<uint32_t> randomDocuments(std::mt19937 &random, uint32_t lastKey = 200) {
+        std::set<uint32_t> documents;
+        for (int i = 0; i < 300; i++) {
+            documents.insert(random() % 65536);
+        }
+        for (int i = 0; i < 30000; i++) {
+            documents.insert(65536 + random() % 65536);
+        }
+        for (uint32_t i = 0; i < DocumentBitmap::ARRAY_LIMIT; i++) {
+            documents.insert(3 * 65536 + i * 7);
+        }
+        for (int i = 0; i < 100; i++) {
+            documents.insert(lastKey * 65536 + random() % 200);
+        }
+        return documents;
+    }
+
+    DocumentBitmap bitmapOf(const std::set<uint32_t> &documents) {
+        std::vector<uint32_t> sorted(documents.begin(), documents.end());
+        return DocumentBitmap::fromSorted(sorted.data(), sorted.size());
+    }
+
+    bool sameDocuments(const DocumentBitmap &bitmap, const std::set<uint32_t> &documents) {
+        std::vector<uint32_t> listed;
+        bitmap.forEach([&listed](uint32_t document) { listed.push_back(document); });
+        return bitmap.cardinality() == documents.size() && listed == std::vector<uint32_t>(documents.begin(), documents.end());
+    }
+
+    void testAddAndLookups(std::mt19937 &random) {
+        std::set<uint32_t> documents = randomDocuments(random);
+        DocumentBitmap added;
+        for (auto itr = documents.rbegin(); itr != documents.rend(); ++itr) {
+            CHECK(added.add(*itr));
+        }
+        CHECK(!added.add(*documents.begin()));
+
+        DocumentBitmap bitmap = bitmapOf(documents);
+        CHECK(sameDocuments(added, documents));
+        CHECK(sameDocuments(bitmap, documents));
+
+        // positions and successors against the set, for members and for the gaps between them
+        std::vector<uint32_t> sorted(documents.begin(), documents.end());
+        DocumentBitmap::RankCursor cursor(bitmap);
+        for (uint32_t document = 0; document < 201 * 65536; document += 1 + random() % 50) {
+            auto itr = documents.lower_bound(document);
+            bool member = itr != documents.end() && *itr == document;
+            long expectedIndex = member ? std::distance(sorted.begin(), std::lower_bound(sorted.begin(), sorted.end(), document)) : -1;
+            CHECK(bitmap.contains(document) == member);
+            CHECK(added.contains(document) == member);
+            CHECK(bitmap.indexOf(document) == expectedIndex);
+            CHECK(cursor.indexOf(document) == expectedIndex);
+            CHECK(bitmap.nextAtLeast(document) == (itr == documents.end() ? DocumentBitmap::END : *itr));
+        }
+        CHECK(bitmap.nextAtLeast(201 * 65536) == DocumentBitmap::END);
+
+        // ranges starting and ending inside containers, across them and past the last one
+        for (int i = 0; i < 200; i++) {
+            uint32_t begin = random() % (202 * 65536);
+            uint32_t end = i % 10 == 0 ? DocumentBitmap::END : begin + random() % (3 * 65536);
+            std::vector<uint32_t> listed;
+            bitmap.forEachInRange(begin, end, [&listed](uint32_t document) { listed.push_back(document); });
+            CHECK(listed == std::vector<uint32_t>(documents.lower_bound(begin), documents.lower_bound(end)));
+        }
+    }
+
+    void testSetOperations(std::mt19937 &random) {
+        std::set<uint32_t> a = randomDocuments(random);
+        std::set<uint32_t> b = randomDocuments(random, 150);
+        std::set<uint32_t> both;
+        std::set<uint32_t> either = a;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::inserter(both, both.end()));
+        either.insert(b.begin(), b.end());
+
+        CHECK(sameDocuments(DocumentBitmap::intersect(bitmapOf(a), bitmapOf(b)), both));
+        CHECK(sameDocuments(DocumentBitmap::unite(bitmapOf(a), bitmapOf(b)), either));
+
+        // the results keep their positions right for the lookups after them
+        DocumentBitmap united = DocumentBitmap::unite(bitmapOf(a), bitmapOf(b));
+        long index = 0;
+        for (uint32_t document : either) {
+            CHECK(united.indexOf(document) == index++);
+        }
+
+        DocumentBitmap empty;
+        CHECK(DocumentBitmap::intersect(bitmapOf(a), empty).empty());
+        CHECK(sameDocuments(DocumentBitmap::unite(empty, bitmapOf(b)), b));
+    }
+}
+
+int main() {
+    std::mt19937 random(7);
+    testAddAndLookups(random);
+    testSetOperations(random);
+    return checkFailures();
+}
@@ -0,0 +1,91 @@
+#include "Check.hpp"
+#include "IndexManifest.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <unistd.h>
+
+namespace {
+    ManifestEntry entryFor(long documentNumber) {
+        return {static_cast<uint64_t>(documentNumber * 100), documentNumber * 1000, IndexManifest::hashContent(std::to_string(documentNumber)),
+                documentNumber};
+    }
+
+    bool sameEntry(const ManifestEntry &a, const ManifestEntry &b) {
+        return a.size == b.size && a.modifiedTime == b.modifiedTime && a.contentHash == b.contentHash && a.documentNumber == b.documentNumber;
+    }
+
+    std::vector<std::string> pathsOf(const std::vector<std::pair<std::string, ManifestEntry>> &entries) {
+        std::vector<std::string> paths;
+        for (const auto &[path, entry] : entries) {
+            paths.push_back(path);
+        }
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
+
+    void testSaveAndLoad(const std::string &manifestPath) {
+        IndexManifest written(manifestPath, "server-1");
+        written.load();
+        CHECK(!written.find("/folder/a.txt"));
+
+        written.update("/folder/a.txt", entryFor(1));
+        written.update("/folder/with space\tand tab.txt", entryFor(2));
+        CHECK(written.save());
+
+        IndexManifest read(manifestPath, "server-1");
+        read.load();
+        auto a = read.find("/folder/a.txt");
+        auto b = read.find("/folder/with space\tand tab.txt");
+        CHECK(a && sameEntry(*a, entryFor(1)));
+        CHECK(b && sameEntry(*b, entryFor(2)));
+
+        // a restarted server no longer has the documents
+        IndexManifest restarted(manifestPath, "server-2");
+        restarted.load();
+        CHECK(!restarted.find("/folder/a.txt"));
+    }
+
+    void testTakeMissing(const std::string &manifestPath) {
+        IndexManifest manifest(manifestPath, "server-1");
+        for (long i = 1; i <= 4; i++) {
+            manifest.update("/folder/" + std::to_string(i) + (i % 2 ? ".txt" : ".log"), entryFor(i));
+        }
+        CHECK(manifest.save());
+        manifest.load();
+
+        manifest.find("/folder/1.txt");
+        auto isText = [](const std::string &path) { return path.ends_with(".txt"); };
+        CHECK(pathsOf(manifest.takeMissing(isText)) == std::vector<std::string>{"/folder/3.txt"});
+
+        // the files out of scope are kept, and taken once the scope covers them
+        CHECK(manifest.takeMissing(isText).empty());
+        CHECK(manifest.find("/folder/2.log"));
+        CHECK(pathsOf(manifest.takeMissing([](const std::string &) { return true; })) == std::vector<std::string>{"/folder/4.log"});
+        CHECK(manifest.find("/folder/1.txt"));
+        CHECK(!manifest.find("/folder/3.txt"));
+    }
+
+    void testHashAndPath() {
+        std::string content(100000, 'x');
+        std::string changed = content;
+        changed[77777] = 'y';
+        CHECK(IndexManifest::hashContent(content) == IndexManifest::hashContent(std::string(100000, 'x')));
+        CHECK(IndexManifest::hashContent(content) != IndexManifest::hashContent(changed));
+        CHECK(IndexManifest::hashContent("abc") != IndexManifest::hashContent(std::string("abc\0", 4)));
+
+        CHECK(IndexManifest::pathFor("/folder", "localhost:12345") == IndexManifest::pathFor("/other/../folder", "localhost:12345"));
+        CHECK(IndexManifest::pathFor("/folder", "localhost:12345") != IndexManifest::pathFor("/folder", "localhost:12346"));
+        CHECK(IndexManifest::pathFor("/folder", "localhost:12345") != IndexManifest::pathFor("/other", "localhost:12345"));
+    }
+}
+
+int main() {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / ("index-manifest-test-" + std::to_string(getpid()));
+    testSaveAndLoad((directory / "saved.manifest").string());
+    testTakeMissing((directory / "missing.manifest").string());
+    testHashAndPath();
+    std::filesystem::remove_all(directory);
+    return checkFailures();
+}
@@ -0,0 +1,110 @@
+#include "Check.hpp"
+#include "Intersection.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr uint32_t GUARD = 0xDEADBEEF;
+
+    // sizes around the 4 and 8 lanes of the vector loops and the 128 postings of a block
+    const std::vector<size_t> SIZES = {0, 1, 2, 3, 4, 5, 7, 8, 9, 12, 15, 16, 17, 31, 32, 33,
+                                       127, 128, 129, 255, 256, 257, 1000, 4099};
+
+    // size distinct values from [base, base + range), in increasing order
+    std::vector<uint32_t> randomSorted(std::mt19937 &random, size_t size, uint32_t base, uint32_t range) {
+        std::set<uint32_t> values;
+        while (values.size() < size) {
+            values.insert(base + random() % range);
+        }
+        return {values.begin(), values.end()};
+    }
+
+    // the kernel finds what std::set_intersection finds, at the right positions, and writes
+    // nothing past min(sizeA, sizeB) positions
+    void checkKernel(const IntersectionKernels &kernels, bool gallop, const std::vector<uint32_t> &a, const std::vector<uint32_t> &b) {
+        std::vector<uint32_t> expected;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+
+        size_t room = std::min(a.size(), b.size());
+        std::vector<uint32_t> positionsA(room + 1, GUARD);
+        std::vector<uint32_t> positionsB(room + 1, GUARD);
+        IntersectionKernel kernel = gallop ? kernels.gallop : kernels.merge;
+        size_t count = kernel(a.data(), a.size(), b.data(), b.size(), positionsA.data(), positionsB.data());
+
+        bool found = count == expected.size();
+        for (size_t i = 0; found && i < count; i++) {
+            found = positionsA[i] < a.size() && positionsB[i] < b.size() && a[positionsA[i]] == expected[i] && b[positionsB[i]] == expected[i];
+        }
+        if (!found) {
+            std::cerr << kernels.name << (gallop ? " gallop" : " merge") << " sizes " << a.size() << " and " << b.size() << std::endl;
+        }
+        CHECK(found);
+        CHECK(positionsA[room] == GUARD && positionsB[room] == GUARD);
+    }
+
+    void checkAll(const std::vector<IntersectionKernels> &available, const std::vector<uint32_t> &a, const std::vector<uint32_t> &b) {
+        for (const IntersectionKernels &kernels : available) {
+            checkKernel(kernels, false, a, b);
+            checkKernel(kernels, true, a, b);
+            checkKernel(kernels, false, b, a);
+            checkKernel(kernels, true, b, a);
+        }
+    }
+
+    void testRandomSizes(const std::vector<IntersectionKernels> &available, std::mt19937 &random) {
+        for (size_t sizeA : SIZES) {
+            for (size_t sizeB : SIZES) {
+                // dense values share many documents, sparse ones few, and values above 2^31
+                // catch a signed comparison
+                for (uint32_t base : {0u, 0x80000000u}) {
+                    uint32_t range = static_cast<uint32_t>(2 * std::max(sizeA, sizeB) + 1) * (1 + random() % 8);
+                    checkAll(available, randomSorted(random, sizeA, base, range), randomSorted(random, sizeB, base, range));
+                }
+            }
+        }
+    }
+
+    // matches in the first and the last slot of either array, at every block offset
+    void testEdges(const std::vector<IntersectionKernels> &available, std::mt19937 &random) {
+        for (size_t size : SIZES) {
+            if (size == 0) {
+                continue;
+            }
+            std::vector<uint32_t> a = randomSorted(random, size, 0, static_cast<uint32_t>(4 * size + 16));
+            if (size > 1) {
+                checkAll(available, a, {a.front(), a.back()});
+            }
+            checkAll(available, a, {a.back()});
+            checkAll(available, a, {a.front()});
+            checkAll(available, a, a);
+
+            // b ends where a starts, and starts where a ends
+            std::vector<uint32_t> before = randomSorted(random, std::min<size_t>(size, a.front()), 0, std::max(a.front(), 1u));
+            before.push_back(a.front());
+            checkAll(available, a, before);
+            std::vector<uint32_t> after = randomSorted(random, size, a.back() + 1, static_cast<uint32_t>(4 * size + 16));
+            after.insert(after.begin(), a.back());
+            checkAll(available, a, after);
+            checkAll(available, a, {});
+        }
+    }
+}
+
+int main() {
+    std::vector<IntersectionKernels> available = availableIntersectionKernels();
+    std::string names;
+    for (const IntersectionKernels &kernels : available) {
+        names += std::string(" ") + kernels.name;
+    }
+    std::cout << "kernels:" << names << std::endl;
+
+    std::mt19937 random(13);
+    testRandomSizes(available, random);
+    testEdges(available, random);
+    return checkFailures();
+}
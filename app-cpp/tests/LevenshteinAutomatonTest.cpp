@@ -0,0 +1,103 @@
+#include "Check.hpp"
+#include "LevenshteinAutomaton.hpp"
+#include "TermDictionary.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    size_t editDistance(const std::string &a, const std::string &b) {
+        std::vector<size_t> row(b.size() + 1);
+        for (size_t j = 0; j <= b.size(); j++) {
+            row[j] = j;
+        }
+        for (size_t i = 1; i <= a.size(); i++) {
+            size_t diagonal = row[0];
+            row[0] = i;
+            for (size_t j = 1; j <= b.size(); j++) {
+                size_t above = row[j];
+                row[j] = std::min({diagonal + (a[i - 1] == b[j - 1] ? 0 : 1), above + 1, row[j - 1] + 1});
+                diagonal = above;
+            }
+        }
+        return row[b.size()];
+    }
+
+    // short strings over a few bytes, so many of them are within the distance of each other
+    std::string randomString(std::mt19937 &random, size_t maxLength) {
+        std::string text;
+        for (size_t length = random() % (maxLength + 1); text.size() < length;) {
+            text.push_back("abcq\xf0"[random() % 5]);
+        }
+        return text;
+    }
+
+    void testMatches(std::mt19937 &random) {
+        for (int i = 0; i < 300; i++) {
+            std::string word = randomString(random, 7);
+            size_t distance = random() % 4;
+            LevenshteinAutomaton automaton(word, distance);
+            for (int j = 0; j < 200; j++) {
+                std::string text = randomString(random, 9);
+                CHECK(automaton.matches(text) == (editDistance(word, text) <= std::min(distance, LevenshteinAutomaton::MAX_DISTANCE)));
+            }
+            CHECK(automaton.matches(word));
+        }
+    }
+
+    // nextMatch gives an accepted string from the one asked for on, the string itself when it is accepted
+    void testNextMatch(std::mt19937 &random) {
+        for (int i = 0; i < 300; i++) {
+            std::string word = randomString(random, 6);
+            LevenshteinAutomaton automaton(word, random() % 3);
+            for (int j = 0; j < 100; j++) {
+                std::string from = randomString(random, 9);
+                std::string target;
+                if (!automaton.nextMatch(from, target)) {
+                    continue;
+                }
+                CHECK(target >= from);
+                CHECK(automaton.matches(target));
+                CHECK(automaton.matches(from) == (target == from));
+            }
+        }
+    }
+
+    // the walk over the dictionary seeks from match to match and must find what testing every term finds
+    void testDictionary(std::mt19937 &random) {
+        std::vector<std::string> terms;
+        for (int i = 0; i < 20000; i++) {
+            terms.push_back(randomString(random, 8));
+        }
+        std::sort(terms.begin(), terms.end());
+        terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+        TermDictionary dictionary;
+        dictionary.assign(terms);
+
+        for (int i = 0; i < 200; i++) {
+            std::string word = randomString(random, 7);
+            size_t distance = random() % 3;
+            LevenshteinAutomaton automaton(word, distance);
+
+            std::vector<std::string> accepted;
+            dictionary.forEachAccepted(automaton, [&accepted](const std::string &term) { accepted.push_back(term); });
+            std::vector<std::string> expected;
+            for (const std::string &term : terms) {
+                if (editDistance(word, term) <= distance) {
+                    expected.push_back(term);
+                }
+            }
+            CHECK(accepted == expected);
+        }
+    }
+}
+
+int main() {
+    std::mt19937 random(9);
+    testMatches(random);
+    testNextMatch(random);
+    testDictionary(random);
+    return checkFailures();
+}
@@ -0,0 +1,104 @@
+#include "Check.hpp"
+#include "TermDictionary.hpp"
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+    // terms over a small alphabet share long prefixes, and a byte above 127 sorts last
+    std::string randomTerm(std::mt19937 &random) {
+        static const std::string ALPHABET = "abcz\xe9";
+        std::string term;
+        for (size_t length = 1 + random() % 8; term.size() < length;) {
+            term.push_back(ALPHABET[random() % ALPHABET.size()]);
+        }
+        return term;
+    }
+
+    // the dictionary holds the expected terms, in order, and every seek lands where lower_bound does
+    void checkTerms(const TermDictionary &dictionary, const std::set<std::string> &expected, std::mt19937 &random) {
+        CHECK(dictionary.size() == expected.size());
+
+        std::vector<std::string> walked;
+        for (TermDictionary::Cursor cursor(dictionary); cursor.valid(); cursor.next()) {
+            walked.push_back(cursor.term());
+        }
+        CHECK(walked == std::vector<std::string>(expected.begin(), expected.end()));
+
+        // one cursor seeks back and forth, near and far
+        TermDictionary::Cursor cursor(dictionary);
+        for (int i = 0; i < 2000; i++) {
+            std::string target = random() % 4 == 0 && !walked.empty() ? walked[random() % walked.size()] : randomTerm(random);
+            cursor.seek(target);
+            auto itr = expected.lower_bound(target);
+            CHECK(cursor.valid() == (itr != expected.end()));
+            if (cursor.valid() && itr != expected.end()) {
+                CHECK(cursor.term() == *itr);
+            }
+        }
+        cursor.seek("\xff");
+        CHECK(!cursor.valid());
+        cursor.seek("");
+        CHECK(cursor.valid() && cursor.term() == *expected.begin());
+
+        for (std::string prefix : {"", "a", "ab", "zz", "\xe9", "abcabcabc"}) {
+            std::vector<std::string> found;
+            dictionary.forEachWithPrefix(prefix, [&found](const std::string &term) { found.push_back(term); });
+            std::vector<std::string> matching;
+            for (const std::string &term : expected) {
+                if (term.starts_with(prefix)) {
+                    matching.push_back(term);
+                }
+            }
+            CHECK(found == matching);
+        }
+    }
+
+    // terms added one by one go through the recent set and are merged into the coded ones
+    void testAdd(std::mt19937 &random) {
+        TermDictionary dictionary;
+        std::set<std::string> expected;
+        for (size_t round = 0; round < 4; round++) {
+            while (expected.size() < (round + 1) * TermDictionary::MIN_MERGE_TERMS * 3 / 2) {
+                std::string term = randomTerm(random);
+                if (expected.insert(term).second) {
+                    dictionary.add(term);
+                }
+            }
+            checkTerms(dictionary, expected, random);
+        }
+    }
+
+    void testAssign(std::mt19937 &random) {
+        std::set<std::string> expected;
+        while (expected.size() < 5000) {
+            expected.insert(randomTerm(random));
+        }
+        std::vector<std::string> terms(expected.rbegin(), expected.rend());
+        TermDictionary dictionary;
+        dictionary.assign(terms);
+        checkTerms(dictionary, expected, random);
+
+        // a few recent terms on top of the coded ones
+        for (int i = 0; i < 50; i++) {
+            std::string term = randomTerm(random) + "y";
+            if (expected.insert(term).second) {
+                dictionary.add(term);
+            }
+        }
+        checkTerms(dictionary, expected, random);
+
+        dictionary.assign({});
+        CHECK(dictionary.size() == 0);
+        CHECK(!TermDictionary::Cursor(dictionary).valid());
+    }
+}
+
+int main() {
+    std::mt19937 random(3);
+    testAdd(random);
+    testAssign(random);
+    return checkFailures();
+}
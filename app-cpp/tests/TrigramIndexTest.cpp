@@ -0,0 +1,105 @@
+#include "Check.hpp"
+#include "TrigramIndex.hpp"
+
+#include <algorithm>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+    // '*' for any characters and '?' for one, over the whole term
+    bool matchesPattern(std::string_view pattern, std::string_view term) {
+        if (pattern.empty()) {
+            return term.empty();
+        }
+        if (pattern[0] == '*') {
+            for (size_t skipped = 0; skipped <= term.size(); skipped++) {
+                if (matchesPattern(pattern.substr(1), term.substr(skipped))) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        return !term.empty() && (pattern[0] == '?' || pattern[0] == term[0]) && matchesPattern(pattern.substr(1), term.substr(1));
+    }
+
+    // every term the matcher accepts is a candidate, and the candidates are increasing term ids
+    template <typename Matcher>
+    void checkCandidates(const TrigramIndex &index, const std::vector<std::string> &terms, const TrigramQuery &query, Matcher &&matches) {
+        if (query.matchesAll()) {
+            return;
+        }
+        std::vector<uint32_t> candidates = index.candidates(query);
+        CHECK(std::is_sorted(candidates.begin(), candidates.end()));
+        CHECK(std::adjacent_find(candidates.begin(), candidates.end()) == candidates.end());
+        for (uint32_t termId = 0; termId < terms.size(); termId++) {
+            if (matches(terms[termId])) {
+                CHECK(std::binary_search(candidates.begin(), candidates.end(), termId));
+            }
+        }
+        for (uint32_t termId : candidates) {
+            CHECK(termId < terms.size() && index.term(termId) == terms[termId]);
+        }
+    }
+
+    std::vector<std::string> randomTerms(std::mt19937 &random) {
+        std::vector<std::string> terms;
+        while (terms.size() < 3000) {
+            std::string term;
+            for (size_t length = 1 + random() % 10; term.size() < length;) {
+                term.push_back("abcdxyz"[random() % 7]);
+            }
+            if (std::find(terms.begin(), terms.end(), term) == terms.end()) {
+                terms.push_back(term);
+            }
+        }
+        return terms;
+    }
+
+    void testPatterns(const TrigramIndex &index, const std::vector<std::string> &terms) {
+        for (std::string pattern : {"*abc*", "ab*", "*cdx", "a?cd*", "*bc*yz*", "*b?d*", "?", "*ab*", "*x*y*", "abcabc"}) {
+            checkCandidates(index, terms, TrigramIndex::fromPattern(pattern),
+                            [&pattern](const std::string &term) { return matchesPattern(pattern, term); });
+        }
+
+        // a substring of three characters or more is required
+        CHECK(!TrigramIndex::fromPattern("*abc*").matchesAll());
+        CHECK(TrigramIndex::fromPattern("*ab*").matchesAll());
+        std::vector<uint32_t> candidates = index.candidates(TrigramIndex::fromPattern("*xyz*"));
+        for (uint32_t termId : candidates) {
+            CHECK(index.term(termId).find("xyz") != std::string::npos);
+        }
+    }
+
+    void testRegexes(const TrigramIndex &index, const std::vector<std::string> &terms) {
+        for (std::string regex : {"abc", "abc.*", ".*bcd.*", "ab(cd|xy)z.*", "(abc|bcd|cdx).*", "[ab]bcd", "a?bcd.*", "(abc)+",
+                                  "x{2}yz.*", ".*(xyz|zyx)", "a(b|c)d+x.*", "[^a]bc.*", "\\w*cdx", "ab|abc|abcd", "(ab)?cdx.*"}) {
+            std::regex compiled(regex, std::regex::ECMAScript);
+            checkCandidates(index, terms, TrigramIndex::fromRegex(regex),
+                            [&compiled](const std::string &term) { return std::regex_match(term, compiled); });
+        }
+
+        // an alternative that needs nothing leaves nothing to require
+        CHECK(TrigramIndex::fromRegex("abc|.*").matchesAll());
+        CHECK(!TrigramIndex::fromRegex("(abc|bcd)x").matchesAll());
+    }
+}
+
+int main() {
+    std::mt19937 random(5);
+    std::vector<std::string> terms = randomTerms(random);
+
+    TrigramIndex added;
+    for (const std::string &term : terms) {
+        added.add(term);
+    }
+    TrigramIndex assigned;
+    assigned.assign(terms);
+
+    for (const TrigramIndex *index : {&added, &assigned}) {
+        testPatterns(*index, terms);
+        testRegexes(*index, terms);
+    }
+    return checkFailures();
+}